@@ -0,0 +1,363 @@
+// external_sort.hpp - sorting more elements than fit in memory
+//
+// This file defines external_sorter<T, Compare>, which sorts a sequence
+// of elements of a trivially copyable type T that may be too large
+// to fit in memory, and the external_sort() convenience functions.
+//
+// Elements are added with push_back().  They are collected in an
+// mf_vector until it reaches the memory budget.  Then that run is
+// sorted (in parallel; see mf_vector::sort()) and written to a temporary
+// file as raw blocks.  When merge() is called, the runs are merged,
+// reading ahead a fixed number of bytes from each, and the merged
+// elements are passed in order to an output function or appended to an
+// mf_vector.  If there are too many runs to merge at once within the
+// budget, groups of them are first merged into longer runs.  If all
+// the elements fit in the budget, no file is used.
+//
+// The memory budget limits the memory used for elements: the run being
+// collected, or the read-ahead buffers of the runs being merged.  It
+// should be at least several times the read-ahead size.
+//
+// Temporary files are created with std::tmpfile(), and they are deleted
+// when the external_sorter is destroyed or merge() has finished with
+// them.  Failures to create, write, or read them throw
+// std::runtime_error.
+//
+// The sort is not stable.  If merge() is called with unique == true,
+// only the first of each group of equivalent elements is output.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_EXTERNAL_SORT
+#define FRYSTL_EXTERNAL_SORT
+
+#include <cstdio>       // FILE, tmpfile, fread, fwrite, fclose, rewind
+#include <cstddef>      // size_t
+#include <cstring>      // memcpy
+#include <vector>
+#include <algorithm>    // min, max, ..._heap
+#include <functional>   // less
+#include <stdexcept>    // runtime_error
+#include <type_traits>  // is_trivially_copyable, aligned_storage
+#include "mf_vector.hpp"
+
+namespace frystl
+{
+    template <class T, class Compare = std::less<T>>
+    class external_sorter
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "external_sorter requires a trivially copyable type");
+    public:
+        using value_type = T;
+        using size_type = size_t;
+
+        // memoryBudget and readAhead are in bytes.  nThreads is passed
+        // to mf_vector::sort() to sort each run.
+        explicit external_sorter(size_type memoryBudget,
+                Compare comp = Compare(),
+                size_type readAhead = 1 << 16,
+                unsigned nThreads = 0)
+            : _comp(comp)
+            , _runCapacity(std::max<size_type>(memoryBudget / sizeof(T), 1))
+            , _readAhead(std::max<size_type>(readAhead / sizeof(T), 1))
+            , _maxFanIn(std::max<size_type>(memoryBudget / std::max<size_type>(readAhead, sizeof(T)), 2))
+            , _nThreads(nThreads)
+            , _size(0)
+        {}
+        external_sorter(const external_sorter&) = delete;
+        external_sorter& operator=(const external_sorter&) = delete;
+        ~external_sorter() noexcept
+        {
+            for (Run& run : _runs)
+                std::fclose(run.file);
+        }
+        // Add an element.  May sort the collected elements and write
+        // them to a temporary file.
+        void push_back(const T& value)
+        {
+            _buffer.push_back(value);
+            ++_size;
+            if (_buffer.size() == _runCapacity)
+                Spill();
+        }
+        // Return the number of elements added since construction or the
+        // last merge().
+        size_type size() const noexcept
+        {
+            return _size;
+        }
+        // Call out(const T&) for each element added, in sorted order,
+        // then forget them all.  If unique is true, only the first of each
+        // group of equivalent elements is passed to out.
+        template <class Output>
+        void merge(Output out, bool unique = false)
+        {
+            if (_runs.empty()) {
+                _buffer.sort(_comp, _nThreads);
+                Emitter<Output> emit(out, _comp, unique);
+                for (const T& value : _buffer)
+                    emit(value);
+            }
+            else {
+                if (!_buffer.empty())
+                    Spill();
+                while (_runs.size() > _maxFanIn) {
+                    // Merge the first _maxFanIn runs into a new run.
+                    Run merged {NewFile(), 0};
+                    try {
+                        Writer writer(merged, _readAhead);
+                        MergeRuns(_runs.begin(), _runs.begin() + _maxFanIn,
+                            Emitter<Writer&>(writer, _comp, false));
+                        writer.Flush();
+                    }
+                    catch (...) {
+                        std::fclose(merged.file);
+                        throw;
+                    }
+                    _runs.erase(_runs.begin(), _runs.begin() + _maxFanIn);
+                    _runs.push_back(merged);
+                }
+                MergeRuns(_runs.begin(), _runs.end(), Emitter<Output>(out, _comp, unique));
+                _runs.clear();
+            }
+            _buffer.clear();
+            _size = 0;
+        }
+        // Append the elements added, in sorted order, to dst.
+        template <unsigned B, size_t N>
+        void merge(mf_vector<T, B, N>& dst, bool unique = false)
+        {
+            merge([&dst](const T& value) { dst.push_back(value); }, unique);
+        }
+    private:
+        using storage_type =
+            std::aligned_storage_t<sizeof(T), alignof(T)>;
+        // A sorted run in a temporary file
+        struct Run {
+            std::FILE* file;
+            size_type size;
+        };
+        // Buffered sequential reader of a run
+        class Reader
+        {
+        public:
+            Reader(const Run& run, size_type bufferSize)
+                : _file(run.file)
+                , _unread(run.size)
+                , _buffer(std::min(bufferSize, run.size))
+                , _pos(0)
+                , _count(0)
+            {
+                std::rewind(_file);
+                Fill();
+            }
+            bool empty() const noexcept
+            {
+                return _pos == _count;
+            }
+            const T& front() const noexcept
+            {
+                return reinterpret_cast<const T*>(_buffer.data())[_pos];
+            }
+            void pop_front()
+            {
+                if (++_pos == _count)
+                    Fill();
+            }
+        private:
+            std::FILE* _file;
+            size_type _unread;
+            std::vector<storage_type> _buffer;
+            size_type _pos;
+            size_type _count;
+
+            void Fill()
+            {
+                _pos = 0;
+                _count = std::min(_buffer.size(), _unread);
+                if (_count && std::fread(_buffer.data(), sizeof(T), _count, _file) != _count)
+                    throw std::runtime_error("external_sorter: temporary file read failed");
+                _unread -= _count;
+            }
+        };
+        // Buffered writer of a run
+        class Writer
+        {
+        public:
+            Writer(Run& run, size_type bufferSize)
+                : _run(run)
+                , _buffer(bufferSize)
+                , _count(0)
+            {}
+            void operator()(const T& value)
+            {
+                Construct(reinterpret_cast<T*>(_buffer.data()) + _count++, value);
+                if (_count == _buffer.size())
+                    Flush();
+            }
+            // Write any buffered elements.
+            void Flush()
+            {
+                Write(_run, reinterpret_cast<const T*>(_buffer.data()), _count);
+                _count = 0;
+            }
+        private:
+            Run& _run;
+            std::vector<storage_type> _buffer;
+            size_type _count;
+        };
+        // Passes elements to out, skipping duplicates if unique is true.
+        template <class Output>
+        class Emitter
+        {
+        public:
+            Emitter(Output out, const Compare& comp, bool unique)
+                : _out(out), _comp(comp), _unique(unique), _haveLast(false), _last()
+            {}
+            void operator()(const T& value)
+            {
+                if (_unique) {
+                    if (_haveLast && !_comp(Last(), value))
+                        return;
+                    std::memcpy(&_last, &value, sizeof(T));
+                    _haveLast = true;
+                }
+                _out(value);
+            }
+        private:
+            Output _out;
+            const Compare& _comp;
+            bool _unique;
+            bool _haveLast;
+            storage_type _last;     // copy of the last value output
+
+            const T& Last() const noexcept
+            {
+                return reinterpret_cast<const T&>(_last);
+            }
+        };
+
+        Compare _comp;
+        const size_type _runCapacity;   // elements per run
+        const size_type _readAhead;     // elements read at a time from a run
+        const size_type _maxFanIn;      // runs merged at once
+        const unsigned _nThreads;
+        size_type _size;
+        mf_vector<T> _buffer;
+        std::vector<Run> _runs;
+
+        static std::FILE* NewFile()
+        {
+            std::FILE* file = std::tmpfile();
+            if (!file)
+                throw std::runtime_error("external_sorter: cannot create temporary file");
+            return file;
+        }
+        static void Write(Run& run, const T* values, size_type n)
+        {
+            if (n && std::fwrite(values, sizeof(T), n, run.file) != n)
+                throw std::runtime_error("external_sorter: temporary file write failed");
+            run.size += n;
+        }
+        // Sort the collected elements and write them to a new run.
+        void Spill()
+        {
+            _buffer.sort(_comp, _nThreads);
+            Run run {NewFile(), 0};
+            try {
+                // Each block of an mf_vector is contiguous.
+                const size_type blockSize = _buffer.block_size();
+                for (size_type i = 0; i < _buffer.size(); i += blockSize)
+                    Write(run, &_buffer[i], std::min(blockSize, _buffer.size() - i));
+                _runs.push_back(run);
+            }
+            catch (...) {
+                std::fclose(run.file);
+                throw;
+            }
+            _buffer.clear();
+        }
+        // Merge the runs [first, last), passing the elements to emit in
+        // order.  The runs' files are closed.
+        template <class RunIter, class Emit>
+        void MergeRuns(RunIter first, RunIter last, Emit emit)
+        {
+            std::vector<Reader> readers;
+            readers.reserve(last - first);
+            for (RunIter run = first; run != last; ++run)
+                readers.emplace_back(*run, _readAhead);
+            // heap's front is the reader holding the least element
+            std::vector<Reader*> heap;
+            for (Reader& reader : readers)
+                if (!reader.empty())
+                    heap.push_back(&reader);
+            auto later = [this](const Reader* a, const Reader* b) {
+                return _comp(b->front(), a->front());
+            };
+            std::make_heap(heap.begin(), heap.end(), later);
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                Reader* reader = heap.back();
+                emit(reader->front());
+                reader->pop_front();
+                if (reader->empty())
+                    heap.pop_back();
+                else
+                    std::push_heap(heap.begin(), heap.end(), later);
+            }
+            for (RunIter run = first; run != last; ++run)
+                std::fclose(run->file);
+        }
+    };
+
+    // Pass the elements [first, last) in sorted order to out(const T&),
+    // using at most about memoryBudget bytes for the elements.
+    template <class InputIt, class Output,
+              class Compare = std::less<typename std::iterator_traits<InputIt>::value_type>,
+              typename = RequireInputIter<InputIt>>
+    void external_sort(InputIt first, InputIt last, Output out, size_t memoryBudget,
+        Compare comp = Compare(), bool unique = false)
+    {
+        using T = typename std::iterator_traits<InputIt>::value_type;
+        external_sorter<T, Compare> sorter(memoryBudget, comp);
+        for (; first != last; ++first)
+            sorter.push_back(*first);
+        sorter.merge(out, unique);
+    }
+    // Sort v, using at most about memoryBudget bytes beyond v itself.
+    // v is emptied from the back as its elements are collected into runs,
+    // so its memory is released as the runs are written.
+    template <class T, unsigned B, size_t N, class Compare = std::less<T>>
+    void external_sort(mf_vector<T, B, N>& v, size_t memoryBudget,
+        Compare comp = Compare(), bool unique = false)
+    {
+        external_sorter<T, Compare> sorter(memoryBudget, comp);
+        while (!v.empty()) {
+            sorter.push_back(v.back());
+            v.pop_back();
+        }
+        sorter.merge(v, unique);
+    }
+}   // namespace frystl
+#endif  // ndef FRYSTL_EXTERNAL_SORT
@@ -0,0 +1,774 @@
+// fixed_deque.hpp - defines a deque-like template class whose capacity
+// is set at run time
+//
+// This file defines fixed_deque<value_type>.  It is like
+// static_deque<value_type, Capacity>, but its capacity is given to its
+// constructor at run time.  The constructor allocates space for that
+// many elements in dynamic memory, once; the space is never
+// reallocated.  The constructors that create elements take the
+// capacity as their first argument.
+//
+// As in a static_deque, the first elements added are placed in the
+// middle of the space, and it can expand in either direction.  If it
+// runs out of space on one end, it slides all of the data to the other
+// end, which invalidates iterators, pointers, and references.  That
+// happens only when one end reaches the edge of the space, as it can
+// when the fixed_deque is used as a queue.
+//
+// It has the same interface as static_deque, including data(), which 
+// returns a pointer to the front element.  Its iterators are pointers.
+//
+// A copy has the same capacity as the original.  A move takes the
+// original's buffer and leaves it empty with capacity 0, and swap()
+// exchanges buffers.  Copy assignment keeps the target's buffer, which
+// must be large enough; move assignment exchanges buffers.
+//
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_FIXED_DEQUE
+#define FRYSTL_FIXED_DEQUE
+#include <iterator>  // std::reverse_iterator, iterator_traits, input_iterator_tag, random_access_iterator_tag
+#include <algorithm> // std::move...(), equal(), lexicographical_compare()
+#include <initializer_list>
+#include <stdexcept> // for std::out_of_range
+#include <cstddef>   // size_t, ptrdiff_t
+#include <type_traits> // aligned_storage
+#include <utility>   // swap
+#include "frystl-defines.hpp"
+#include "frystl-hash.hpp"
+#include "frystl-deque.hpp"
+
+namespace frystl
+{
+    template <typename value_type>
+    class fixed_deque
+    {
+    public:
+        using this_type = fixed_deque<value_type>;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        // Create an empty fixed_deque with room for capacity elements.
+        explicit fixed_deque(size_type capacity = 0)
+            : _capacity(capacity)
+            , _elem(capacity ? new storage_type[capacity] : nullptr)
+            , _front(Centered(1))
+            , _back(_front)
+        {
+        }
+        // fill c'tor with explicit value
+        fixed_deque(size_type capacity, size_type count, const_reference value)
+            : fixed_deque(capacity)
+        {
+            FRYSTL_ASSERT2(count <= capacity,"Overflow in fixed_deque");
+            _front = _back = Centered(count);
+            for (; size() < count; ++_back)
+                Construct(end(), value);
+        }
+        // range c'tor
+        template <class Iter,
+                  typename = RequireInputIter<Iter> > 
+        fixed_deque(size_type capacity, Iter begin, Iter end)
+            : fixed_deque(capacity)
+        {
+            Center(begin,end,
+                typename std::iterator_traits<Iter>::iterator_category());
+            for (Iter k = begin; k != end; ++k) {
+                emplace_back(*k);
+            }
+        }
+        // initializer list constructor
+        fixed_deque(size_type capacity, std::initializer_list<value_type> il)
+            : fixed_deque(capacity, il.begin(), il.end())
+        {
+        }
+        // copy constructor
+        // The copy has the same capacity as donor.
+        fixed_deque(const this_type &donor)
+            : fixed_deque(donor.capacity(), donor.begin(), donor.end())
+        {
+        }
+        // move constructor
+        // Takes donor's buffer, leaving it empty with capacity 0.
+        fixed_deque(this_type &&donor) noexcept
+            : _capacity(donor._capacity)
+            , _elem(donor._elem)
+            , _front(donor._front)
+            , _back(donor._back)
+        {
+            donor._elem = nullptr;
+            donor._capacity = donor._front = donor._back = 0;
+        }
+        ~fixed_deque() noexcept
+        {
+            DestroyAll();
+            delete[] _elem;
+        }
+        void clear() noexcept
+        {
+            DestroyAll();
+            _front = _back = Centered(1);
+        }
+        size_type size() const noexcept
+        {
+            return _back - _front;
+        }
+        bool empty() const noexcept
+        {
+            return _front == _back;
+        }
+        size_type capacity() const noexcept
+        {
+            return _capacity;
+        }
+        template <class... Args>
+        [[maybe_unused]] reference emplace_front(Args&&... args)
+        {
+            FRYSTL_ASSERT2(size() < capacity(),"fixed_deque overflow");
+            if (begin() == FirstSpace()) SlideAllToBack();
+            Construct(begin()-1, std::forward<Args>(args)...);
+            --_front;
+            return *begin();
+        }
+        void push_front(const_reference t)
+        {
+            FRYSTL_ASSERT2(size() < capacity(),"fixed_deque overflow");
+            if (begin() == FirstSpace()) SlideAllToBack();
+            Construct(begin()-1, t);
+            --_front;
+        }
+        void push_front(value_type&& t) noexcept
+        {
+            FRYSTL_ASSERT2(size() < capacity(),"fixed_deque overflow");
+            if (begin() == FirstSpace()) SlideAllToBack();
+            Construct(begin()-1, std::move(t));
+            --_front;
+        }
+        void pop_front() noexcept
+        {
+            FRYSTL_ASSERT2(_front < _back, "pop_front called on empty fixed_deque");
+            ++_front;
+            Destroy(begin()-1);
+        }
+        template <class... Args>
+        [[maybe_unused]] reference emplace_back(Args&&... args)
+        {
+            FRYSTL_ASSERT2(size() < capacity(),"fixed_deque overflow");
+            if (end() == PastLastSpace()) SlideAllToFront();
+            Construct(end(),std::forward<Args>(args)...);
+            ++_back;
+            return *(end()-1);
+        }
+        void push_back(const_reference t) 
+        {
+            FRYSTL_ASSERT2(size() < capacity(),"fixed_deque overflow");
+            if (end() == PastLastSpace()) SlideAllToFront();
+            Construct(end(), t);
+            ++_back;
+        }
+        void push_back(value_type && t) noexcept
+        {
+            FRYSTL_ASSERT2(size() < capacity(),"fixed_deque overflow");
+            if (end() == PastLastSpace()) SlideAllToFront();
+            Construct(end(), std::move(t));
+            ++_back;
+        }
+        void pop_back() noexcept
+        {
+            FRYSTL_ASSERT2(_front < _back,"pop_back() called on empty fixed_deque");
+            --_back;
+            Destroy(end());
+        }
+
+        reference operator[](size_type index) noexcept
+        {
+            FRYSTL_ASSERT2(index < size(),"Index out of range");
+            return *(begin() + index);
+        }
+        const_reference operator[](size_type index) const noexcept
+        {
+            FRYSTL_ASSERT2(index < size(),"Index out of range");
+            return *(begin() + index);
+        }
+
+        pointer data() noexcept 
+        { 
+            return begin(); 
+        }
+
+        const_pointer data() const noexcept
+        { 
+            return begin(); 
+        }
+
+        reference at(size_type index)
+        {
+            Verify(index < size());
+            return *(begin() + index);
+        }
+        const_reference at(size_type index) const
+        {
+            Verify(index < size());
+            return *(begin() + index);
+        }
+        reference front() noexcept
+        {
+            FRYSTL_ASSERT2(_front < _back,"front() called on empty fixed_deque");
+            return *begin();
+        }
+        const_reference front() const noexcept
+        {
+            FRYSTL_ASSERT2(_front < _back,"front() called on empty fixed_deque");
+            return *begin();
+        }
+        reference back() noexcept
+        {
+            FRYSTL_ASSERT2(_front < _back,"back() called on empty fixed_deque");
+            return *(end()-1);
+        }
+        const_reference back() const noexcept
+        {
+            FRYSTL_ASSERT2(_front < _back,"back() called on empty fixed_deque");
+            return *(end()-1);
+        }
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args && ... args)
+        {
+            FRYSTL_ASSERT2(cbegin() <= pos && pos <= cend(),
+                "Invalid position in fixed_deque::emplace()");
+            size_type offset = pos - cbegin();
+            if (pos == begin()) emplace_front(std::forward<Args>(args)...);
+            else if (pos == end()) emplace_back(std::forward<Args>(args)...);
+            else {
+                FillRoom(MakeRoom(pos,1), 1,
+                    [&](pointer p) { Construct(p, std::forward<Args>(args)...); });
+            }
+            return begin()+offset;
+        }
+        //
+        //  Assignment functions
+        void assign(size_type n, const_reference val)
+        {
+            FRYSTL_ASSERT2(n <= capacity(),"Overflow in fixed_deque::assign()");
+            DestroyAll(); 
+            _front = _back = Centered(n);
+            while (size() < n)
+                push_back(val);
+        }
+        void assign(std::initializer_list<value_type> x)
+        {
+            FRYSTL_ASSERT2(x.size() <= capacity(),"Overflow in fixed_deque::assign()");
+            DestroyAll();
+            _front = _back = Centered(x.size());
+            for (auto &a : x)
+                emplace_back(a);
+        }
+        template <class Iter,
+                  typename = RequireInputIter<Iter>>
+        void assign(Iter begin, Iter end)
+        {
+            DestroyAll();
+            Center(begin,end,
+                typename std::iterator_traits<Iter>::iterator_category());
+            for (Iter k = begin; k != end; ++k) {
+                push_back(*k);
+            }
+        }
+        this_type &operator=(const this_type &other) 
+        {
+            if (this != &other)
+                assign(other.begin(), other.end());
+            return *this;
+        }
+        // Move operator=.  Exchanges buffers, then empties other.
+        this_type &operator=(this_type &&other) noexcept
+        {
+            if (this != &other)
+            {
+                swap(other);
+                other.clear();
+            }
+            return *this;
+        }
+        this_type &operator=(std::initializer_list<value_type> il)
+        {
+            assign(il);
+            return *this;
+        }
+        // single element insert()
+        iterator insert(const_iterator position, const value_type &val)
+        {
+            return insert(position, 1, val);
+        }
+        // move insert()
+        iterator insert(const_iterator position, value_type &&val) noexcept
+        {
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "Bad position argument in fixed_deque::insert()");
+            iterator t = MakeRoom(position, 1);
+            FillRoom(t, 1, [&val](pointer p) { Construct(p, std::move(val)); });
+            return t;
+        }
+        // fill insert
+        iterator insert(const_iterator position, size_type n, const_reference val)
+        {
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "Bad position argument in fixed_deque::insert()");
+            value_type copy(val);   // val may be an element
+            iterator t = MakeRoom(position, n);
+            // copy val n times into newly available cells
+            FillRoom(t, n, [&copy](pointer p) { Construct(p, copy); });
+            return t;
+        }
+        // range insert()
+        private:
+            // implementation for iterators with no operator-()
+            template <class InpIter>
+            iterator insert(
+                const_iterator position, 
+                InpIter first, 
+                InpIter last,
+                std::input_iterator_tag)
+            {
+                size_type posIndex = position-begin();
+                size_type oldSize = size();
+                while (first != last) {
+                    emplace_back(*first++);
+                }
+                std::rotate(begin()+posIndex, begin()+oldSize, end());
+                return begin()+posIndex;
+            }
+            // Implementation for iterators having operator-()
+            template <class DAIter>
+            iterator insert(
+                const_iterator position, 
+                DAIter first, 
+                DAIter last,
+                std::random_access_iterator_tag)
+            {
+                size_type n = last-first;
+                iterator t = MakeRoom(position,n);
+                FillRoom(t, n, [&first](pointer p) { Construct(p, *first++); });
+                return t;
+            }
+        public:
+        template <class Iter,typename = RequireInputIter<Iter>>
+        iterator insert(const_iterator position, Iter first, Iter last)
+        {
+            return insert(position,first,last,
+                typename std::iterator_traits<Iter>::iterator_category());
+        }
+        // initializer list insert()
+        iterator insert(const_iterator position, std::initializer_list<value_type> il)
+        {
+            size_type n = il.size();
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "Bad position argument in fixed_deque::insert()");
+            iterator t = MakeRoom(position, n);
+            // copy il into newly available cells
+            auto j = il.begin();
+            FillRoom(t, n, [&j](pointer p) { Construct(p, *j++); });
+            return t;
+        }
+        void resize(size_type n, const value_type &val)
+        {
+            FRYSTL_ASSERT2(n <= capacity(),"n too large in fixed_deque::resize(n,value)");
+            while (n < size())
+                pop_back();
+            while (size() < n)
+                push_back(val);
+        }
+        void resize(size_type n)
+        {
+            FRYSTL_ASSERT2(n <= capacity(),"n too large in fixed_deque::resize(n)");
+            while (n < size())
+                pop_back();
+            FillBack(n - size(), [](pointer p) { Construct(p); });
+        }
+        // Like resize(n), but new elements are default-initialized, so
+        // if value_type is trivial they are left uninitialized.
+        void resize_default_init(size_type n)
+        {
+            FRYSTL_ASSERT2(n <= capacity(),"n too large in fixed_deque::resize_default_init(n)");
+            while (n < size())
+                pop_back();
+            FillBack(n - size(), [](pointer p) { DefaultConstruct(p); });
+        }
+        // Append the elements of rg, which may be any range with begin()
+        // and end(), such as a container.  If its iterators are forward
+        // iterators, capacity is checked and room is made once.
+        template <class Range>
+        void append_range(Range &&rg)
+        {
+            AppendRange(std::begin(rg), std::end(rg), typename std::iterator_traits<
+                decltype(std::begin(rg))>::iterator_category());
+        }
+        // Append n elements, each constructed from the value of f().
+        template <class Generator>
+        void generate_back(size_type n, Generator f)
+        {
+            FillBack(n, [&f](pointer p) { Construct(p, f()); });
+        }
+        void swap(this_type &x) noexcept
+        {
+            std::swap(_capacity, x._capacity);
+            std::swap(_elem, x._elem);
+            std::swap(_front, x._front);
+            std::swap(_back, x._back);
+        }
+        void shrink_to_fit()
+        {}                  // does nothing
+        iterator begin() noexcept
+        {
+            return FirstSpace() + _front;
+        }
+        iterator end() noexcept
+        {
+            return FirstSpace() + _back;
+        }
+        const_iterator begin() const noexcept
+        {
+            return FirstSpace() + _front;
+        }
+        const_iterator end() const noexcept
+        {
+            return FirstSpace() + _back;
+        }
+        const_iterator cbegin() noexcept
+        {
+            return begin();
+        }
+        const_iterator cend() noexcept
+        {
+            return end();
+        }
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            iterator result = const_cast<iterator>(last);
+            if (first != last)
+            {
+                FRYSTL_ASSERT2(first < last,"Bad arguments to fixed_deque::erase()");
+                FRYSTL_ASSERT2(Dereferencable(first),"Bad arguments to fixed_deque::erase()");
+                FRYSTL_ASSERT2(Dereferencable(last-1),"Bad arguments to fixed_deque::erase()");
+                const iterator f = const_cast<iterator>(first);
+                const iterator l = const_cast<iterator>(last);
+                DestroyRange(f, l);
+                if (first-begin() < end()-last) {
+                    // Slide the elements before first
+                    SlideRangeToBack(begin(), f, l);
+                    _front += l - f;
+                    result = l;
+                } else {
+                    // Slide the elements at and after last
+                    SlideRangeToFront(l, end(), f);
+                    _back -= l - f;
+                    result = f;
+                }
+            }
+            return result;
+        }
+        iterator erase(const_iterator position) noexcept
+        {
+            return erase(position, position+1);
+        }
+        // Erase the element at position by moving the last element into
+        // its place.  Unlike erase(), this takes constant time but does
+        // not keep the order of the elements.
+        iterator erase_unordered(const_iterator position) noexcept
+        {
+            FRYSTL_ASSERT2(begin() <= position && position < end(),
+                "fixed_deque::erase_unordered(pos): pos out of range");
+            iterator p = const_cast<iterator>(position);
+            if (p != end() - 1)
+                *p = std::move(back());
+            pop_back();
+            return p;
+        }
+
+    private:
+        using storage_type =
+            std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
+        // _front and _back are the offsets of begin() and end() from
+        // the first cell.
+        size_type _capacity;
+        storage_type *_elem;
+        size_type _front;
+        size_type _back;
+
+        pointer FirstSpace() noexcept
+        {
+            return reinterpret_cast<pointer>(_elem);
+        }
+        const_pointer FirstSpace() const noexcept
+        {
+            return reinterpret_cast<const_pointer>(_elem);
+        }
+        pointer PastLastSpace() noexcept
+        {
+            return reinterpret_cast<pointer>(_elem+capacity());
+        }
+        const_pointer PastLastSpace() const noexcept
+        {
+            return reinterpret_cast<const_pointer>(_elem+capacity());
+        }
+        const_pointer Data() const noexcept
+        {
+            return reinterpret_cast<const_pointer>(_elem);
+        }
+        static void Verify(bool cond)
+        {
+            if (!cond)
+                throw std::out_of_range("fixed_deque range error");
+        }
+        // returns true iff iter can be dereferenced.
+        bool Dereferencable(const const_iterator &iter) const noexcept
+        {
+            return begin() <= iter && iter < end();
+        }
+        // Slide cells at and behind p to the back by n spaces.
+        // Return an iterator pointing to the first cleared cell (p).
+        // Update end().
+        iterator MakeRoomAfter(iterator p, size_type n) noexcept
+        {
+            SlideRangeToBack(p, end(), end()+n);
+            _back += n;
+            return p;
+        }
+        // Slide cells before p to the front by n spaces.
+        // Return an iterator pointing to the first cleared cell (p-n).
+        // Update begin().
+        iterator MakeRoomBefore(iterator p, size_type n) noexcept
+        {
+            SlideRangeToFront(begin(), p, begin()-n);
+            _front -= n;
+            return p-n;
+        }
+        // Slide cells such that there are n empty, unconstructed cells
+        // between constp and constp+n.  The order of all other cells
+        // is preserved.  Update begin() or end() or both. 
+        // Return an iterator pointing to the first cleared space, which
+        // may be different from constp.
+        iterator MakeRoom(const_iterator constp, size_type n) noexcept
+        {
+            FRYSTL_ASSERT2(size()+n <= capacity(), "fixed_deque overflow");
+            iterator p = const_cast<iterator>(constp);
+            if (end()-p < p-begin() && end()+n <= PastLastSpace())
+                return MakeRoomAfter(p, n);
+            else if (FirstSpace() + n <= begin())
+                return MakeRoomBefore(p, n);
+            else {
+                // Neither side has enough extra space
+                p -= begin() - FirstSpace();
+                SlideAllToFront();
+                return MakeRoomAfter(p, n);
+            }
+        }
+        // Construct elements in the n cells at p that MakeRoom() opened
+        // by calling fill(q) for each cell q in order.  If a call throws,
+        // destroy the elements already constructed and close the gap.
+        template <class Fill>
+        void FillRoom(pointer p, size_type n, Fill fill)
+        {
+            pointer q = p;
+            try {
+                for (; q < p + n; ++q)
+                    fill(q);
+            }
+            catch (...) {
+                DestroyRange(p, q);
+                SlideRangeToFront(p + n, end(), p);
+                _back -= n;
+                throw;
+            }
+        }
+        // Make room for n elements after the last, sliding the elements
+        // if needed, and construct them by calling construct(p) for each
+        // new cell p in order.  If a call throws, the elements already 
+        // constructed are kept.
+        template <class Construct1>
+        void FillBack(size_type n, Construct1 construct)
+        {
+            if (n == 0) return;
+            pointer p = MakeRoom(end(), n);
+            pointer last = p + n;       // == end()
+            try {
+                for (; p < last; ++p)
+                    construct(p);
+            }
+            catch (...) {
+                _back = p - FirstSpace();
+                throw;
+            }
+        }
+        template <class FwdIter>
+        void AppendRange(FwdIter first, FwdIter last, std::forward_iterator_tag)
+        {
+            FillBack(std::distance(first, last), [&first](pointer p) { Construct(p, *first++); });
+        }
+        template <class InpIter>
+        void AppendRange(InpIter first, InpIter last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+        // Return the offset of the front end of a range of n cells centered
+        // in the space.
+        size_type Centered(size_type n) const noexcept
+        {
+            return n < _capacity ? (_capacity-n)/2 : 0;
+        }
+        template <class RAIter>
+        void Center(RAIter begin, RAIter end, std::random_access_iterator_tag) noexcept
+        {
+            FRYSTL_ASSERT2(size_type(end-begin) <= capacity(), "Overflow");
+            _front = _back = Centered(end-begin);
+        }
+        template <class InpIter>
+        void Center(InpIter, InpIter, std::input_iterator_tag) noexcept
+        {
+            _front = _back = 0;
+        }
+        void DestroyAll() noexcept
+        {
+            for (reference elem : *this) Destroy(&elem);
+        }
+        void SlideAllToFront() noexcept
+        {
+            auto sz = size();
+            SlideRangeToFront(begin(), end(), FirstSpace());
+            _front = 0;
+            _back = sz;
+        }
+        void SlideAllToBack() noexcept
+        {
+            auto sz = size();
+            SlideRangeToBack(begin(), end(), PastLastSpace());
+            _back = _capacity;
+            _front = _capacity - sz;
+        }
+    };
+    //
+    //*******  Non-member overloads
+    //
+    template <class T>
+    bool operator==(const fixed_deque<T> &lhs, const fixed_deque<T> &rhs) noexcept
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        return EqualElements(lhs.data(), rhs.data(), lhs.size());
+    }
+    template <class T>
+    bool operator!=(const fixed_deque<T> &lhs, const fixed_deque<T> &rhs) noexcept
+    {
+        return !(rhs == lhs);
+    }
+    template <class T>
+    bool operator<(const fixed_deque<T> &lhs, const fixed_deque<T> &rhs) noexcept
+    {
+        return LessElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+    }
+    template <class T>
+    bool operator<=(const fixed_deque<T> &lhs, const fixed_deque<T> &rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+    template <class T>
+    bool operator>(const fixed_deque<T> &lhs, const fixed_deque<T> &rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+    template <class T>
+    bool operator>=(const fixed_deque<T> &lhs, const fixed_deque<T> &rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+#ifdef FRYSTL_HAS_THREE_WAY
+    template <class T>
+    auto operator<=>(const fixed_deque<T> &lhs, const fixed_deque<T> &rhs)
+    {
+        return ThreeWayElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+    }
+#endif
+
+    template <class T>
+    void swap(fixed_deque<T> &a, fixed_deque<T> &b) noexcept
+    {
+        a.swap(b);
+    }
+    // Erase the elements of c for which pred returns true, keeping the
+    // order of the others, in one pass.  Return the number erased.
+    template <class T, class Pred>
+    size_t erase_if(fixed_deque<T> &c, Pred pred)
+    {
+        return EraseIf(c, pred);
+    }
+    // Erase the elements of c at the positions in indices, which must be
+    // sorted in ascending order, keeping the order of the others, in one
+    // pass.  Return the number erased.
+    template <class T, class Indices>
+    size_t erase_indices(fixed_deque<T> &c, const Indices &indices)
+    {
+        using std::begin;
+        using std::end;
+        return EraseIndices(c, begin(indices), end(indices));
+    }
+}       // namespace frystl
+
+namespace std
+{
+    // Hash the elements of a fixed_deque.  See frystl-hash.hpp.
+    template <class T>
+    struct hash<frystl::fixed_deque<T>>
+    {
+        size_t operator()(const frystl::fixed_deque<T> &c) const
+        {
+            return size_t(frystl::HashRange(c.data(), c.size()));
+        }
+    };
+}       // namespace std
+#endif  // ndef FRYSTL_FIXED_DEQUE
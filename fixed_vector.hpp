@@ -0,0 +1,572 @@
+// Template class fixed_vector
+//
+// fixed_vector<T> is like static_vector<T,Capacity>, but its capacity is
+// given to its constructor at run time rather than as a template
+// parameter.  The constructor allocates space for that many elements
+// in dynamic memory, once; the elements are never reallocated, so
+// pointers, references, and iterators to them remain valid through
+// push_back() and emplace_back().  Like a static_vector, a fixed_vector
+// cannot be extended past its capacity.
+//
+// It has nearly all of the API of a std::vector.  Its iterators are
+// pointers and data() can be used as a C array.  The constructors
+// that create elements take the capacity as their first argument.
+// The functions reserve() and shrink_to_fit() do nothing; the function
+// get_allocator() is not implemented.  The functions try_emplace_back(),
+// try_push_back(), unchecked_emplace_back(), and unchecked_push_back()
+// are as in static_vector.
+//
+// A copy has the same capacity as the original.  A move takes the
+// original's buffer and leaves it empty with capacity 0, and swap()
+// exchanges buffers.  Copy assignment keeps the target's buffer, which
+// must be large enough; move assignment exchanges buffers.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_FIXED_VECTOR
+#define FRYSTL_FIXED_VECTOR
+#include <algorithm> // for std::move...(), equal(), lexicographical_compare(), rotate()
+#include <initializer_list>
+#include <iterator>  // std::reverse_iterator, iterator_traits
+#include <stdexcept> // for std::out_of_range
+#include <cstddef>   // size_t, ptrdiff_t
+#include <memory>    // uninitialized_fill_n
+#include <type_traits> // aligned_storage
+#include <utility>   // swap
+#include "frystl-defines.hpp"
+#include "frystl-hash.hpp"
+
+namespace frystl
+{
+    template <class T>
+    class fixed_vector
+    {
+    public:
+        using this_type = fixed_vector<T>;
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        //
+        //******* Public member functions:
+        //
+        // Create an empty fixed_vector with room for capacity elements.
+        explicit fixed_vector(size_type capacity = 0)
+            : _data(Allocate(capacity)), _size(0), _capacity(capacity)
+        {}
+        ~fixed_vector() noexcept
+        {
+            clear();
+            Release();
+        }
+        // copy constructor
+        fixed_vector(const this_type &donor)
+            : fixed_vector(donor.capacity(), donor.begin(), donor.end())
+        {}
+        // move constructor
+        // Takes donor's buffer, leaving it empty with capacity 0.
+        fixed_vector(this_type &&donor) noexcept
+            : _data(donor._data), _size(donor._size), _capacity(donor._capacity)
+        {
+            donor._data = nullptr;
+            donor._size = donor._capacity = 0;
+        }
+        // fill constructors
+        fixed_vector(size_type capacity, size_type n, const_reference value)
+            : fixed_vector(capacity)
+        {
+            FRYSTL_ASSERT2(n <= capacity, "fixed_vector: construction overflow");
+            std::uninitialized_fill_n(_data, n, value);
+            _size = n;
+        }
+        // range constructor
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        fixed_vector(size_type capacity, InputIterator begin, InputIterator end)
+            : fixed_vector(capacity)
+        {
+            for (InputIterator k = begin; k != end; ++k)
+                emplace_back(*k);
+        }
+        // initializer list constructor
+        fixed_vector(size_type capacity, std::initializer_list<value_type> il)
+            : fixed_vector(capacity, il.begin(), il.end())
+        {}
+        //
+        //  Assignment functions
+        void assign(size_type n, const_reference val)
+        {
+            FRYSTL_ASSERT2(n <= _capacity, "fixed_vector: assign() overflow");
+            clear();
+            std::uninitialized_fill_n(_data, n, val);
+            _size = n;
+        }
+        void assign(std::initializer_list<value_type> x)
+        {
+            assign(x.begin(), x.end());
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        void assign(InputIterator begin, InputIterator end)
+        {
+            clear();
+            for (InputIterator k = begin; k != end; ++k)
+                emplace_back(*k);
+        }
+        // Copy operator=.  Keeps this vector's buffer, which must be
+        // large enough.
+        this_type &operator=(const this_type &other)
+        {
+            if (this != &other)
+                assign(other.begin(), other.end());
+            return *this;
+        }
+        // Move operator=.  Exchanges buffers, then empties other.
+        this_type &operator=(this_type &&other) noexcept
+        {
+            if (this != &other) {
+                swap(other);
+                other.clear();
+            }
+            return *this;
+        }
+        this_type &operator=(std::initializer_list<value_type> il)
+        {
+            assign(il);
+            return *this;
+        }
+        //
+        //  Element access functions
+        //
+        pointer data() noexcept { return _data; }
+        const_pointer data() const noexcept { return _data; }
+        reference at(size_type i)
+        {
+            Verify(i < _size);
+            return _data[i];
+        }
+        reference operator[](size_type i) noexcept
+        {
+            FRYSTL_ASSERT2(i < _size,"fixed_vector: index out of range");
+            return _data[i];
+        }
+        const_reference at(size_type i) const
+        {
+            Verify(i < _size);
+            return _data[i];
+        }
+        const_reference operator[](size_type i) const noexcept
+        {
+            FRYSTL_ASSERT2(i < _size,"fixed_vector: index out of range");
+            return _data[i];
+        }
+        reference back() noexcept
+        {
+            FRYSTL_ASSERT2(_size,"back() called on empty fixed_vector");
+            return _data[_size - 1];
+        }
+        const_reference back() const noexcept
+        {
+            FRYSTL_ASSERT2(_size,"back() called on empty fixed_vector");
+            return _data[_size - 1];
+        }
+        reference front() noexcept
+        {
+            FRYSTL_ASSERT2(_size,"front() called on empty fixed_vector");
+            return *_data;
+        }
+        const_reference front() const noexcept
+        {
+            FRYSTL_ASSERT2(_size,"front() called on empty fixed_vector");
+            return *_data;
+        }
+        //
+        //  Iterators
+        //
+        iterator begin() noexcept { return _data; }
+        const_iterator begin() const noexcept { return _data; }
+        const_iterator cbegin() const noexcept { return _data; }
+        iterator end() noexcept { return _data + _size; }
+        const_iterator end() const noexcept { return _data + _size; }
+        const_iterator cend() const noexcept { return _data + _size; }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+        //
+        // Capacity and size
+        //
+        size_type capacity() const noexcept { return _capacity; }
+        size_type max_size() const noexcept { return _capacity; }
+        size_type size() const noexcept { return _size; }
+        bool empty() const noexcept { return _size == 0; }
+        void reserve(size_type n) noexcept {
+            FRYSTL_ASSERT2(n <= capacity(), "fixed_vector::reserve() argument too large");
+        }
+        void shrink_to_fit() noexcept {}
+        //
+        //  Modifiers
+        //
+        void pop_back() noexcept
+        {
+            FRYSTL_ASSERT2(_size, "fixed_vector::pop_back() on empty vector");
+            _size -= 1;
+            Destroy(end());
+        }
+        void push_back(const T &value) { emplace_back(value); }
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+        void clear() noexcept
+        {
+            while (_size)
+                pop_back();
+        }
+        iterator erase(const_iterator position) noexcept
+        {
+            FRYSTL_ASSERT2(begin() <= position && position < end(),
+                "fixed_vector::erase(pos): pos out of range");
+            return erase(position, position + 1);
+        }
+        // Erase the element at position by moving the last element into
+        // its place.  Unlike erase(), this takes constant time but does
+        // not keep the order of the elements.
+        iterator erase_unordered(const_iterator position) noexcept
+        {
+            FRYSTL_ASSERT2(begin() <= position && position < end(),
+                "fixed_vector::erase_unordered(pos): pos out of range");
+            iterator p = const_cast<iterator>(position);
+            if (p != end() - 1)
+                *p = std::move(back());
+            pop_back();
+            return p;
+        }
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            iterator f = const_cast<iterator>(first);
+            iterator l = const_cast<iterator>(last);
+            if (first != last)
+            {
+                FRYSTL_ASSERT2(begin() <= first && last <= end(),
+                    "fixed_vector::erase(first,last): bad range");
+                FRYSTL_ASSERT2(first < last,
+                    "fixed_vector::erase(first,last): last < first");
+                iterator newEnd = std::move(l, end(), f);
+                for (iterator it = newEnd; it < end(); ++it)
+                    Destroy(it);
+                _size = newEnd - begin();
+            }
+            return f;
+        }
+        template <class... Args>
+        iterator emplace(const_iterator position, Args &&...args)
+        {
+            FRYSTL_ASSERT2(_size < _capacity,"fixed_vector::emplace() overflow");
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "fixed_vector::emplace(): bad position");
+            iterator p = const_cast<iterator>(position);
+            if (p == end())
+                return &emplace_back(std::forward<Args>(args)...);
+            value_type value(std::forward<Args>(args)...);
+            MakeRoom(p, 1);
+            *p = std::move(value);
+            ++_size;
+            return p;
+        }
+        template <class... Args>
+        reference emplace_back(Args && ... args)
+        {
+            FRYSTL_ASSERT2(_size < _capacity,"fixed_vector::emplace_back() overflow");
+            Construct(end(), std::forward<Args>(args)...);
+            ++_size;
+            return back();
+        }
+        // If the vector is full, try_emplace_back() and try_push_back()
+        // return nullptr.  Otherwise they append an element and return a
+        // pointer to it.
+        template <class... Args>
+        pointer try_emplace_back(Args && ... args)
+        {
+            if (_size == _capacity)
+                return nullptr;
+            return &emplace_back(std::forward<Args>(args)...);
+        }
+        pointer try_push_back(const T &value) { return try_emplace_back(value); }
+        pointer try_push_back(T &&value) { return try_emplace_back(std::move(value)); }
+        template <class... Args>
+        reference unchecked_emplace_back(Args && ... args)
+        {
+            return emplace_back(std::forward<Args>(args)...);
+        }
+        reference unchecked_push_back(const T &value) { return emplace_back(value); }
+        reference unchecked_push_back(T &&value) { return emplace_back(std::move(value)); }
+        // single element insert()
+        iterator insert(const_iterator position, const value_type &val)
+        {
+            return emplace(position, val);
+        }
+        // move insert()
+        iterator insert(const_iterator position, value_type &&val)
+        {
+            return emplace(position, std::move(val));
+        }
+        // fill insert
+        iterator insert(const_iterator position, size_type n, const value_type &val)
+        {
+            FRYSTL_ASSERT2(_size + n <= _capacity, "fixed_vector::insert: overflow");
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "fixed_vector::insert(): bad position");
+            iterator p = const_cast<iterator>(position);
+            if (n) {
+                value_type copy(val);   // val may be an element
+                MakeRoom(p, n);
+                for (iterator i = p; i < p + n; ++i)
+                    FillCell(i, copy);
+                _size += n;
+            }
+            return p;
+        }
+        // range insert()
+        template <class Iter,
+                  typename = RequireInputIter<Iter>>
+        iterator insert(const_iterator position, Iter first, Iter last)
+        {
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "fixed_vector::insert(): bad position");
+            iterator p = const_cast<iterator>(position);
+            size_type oldSize = _size;
+            for (; first != last; ++first)
+                emplace_back(*first);
+            std::rotate(p, begin() + oldSize, end());
+            return p;
+        }
+        // initializer list insert()
+        iterator insert(const_iterator position, std::initializer_list<value_type> il)
+        {
+            return insert(position, il.begin(), il.end());
+        }
+        void resize(size_type n, const value_type &val)
+        {
+            FRYSTL_ASSERT2(n <= _capacity, "fixed_vector::resize: overflow");
+            while (n < size())
+                pop_back();
+            while (size() < n)
+                push_back(val);
+        }
+        void resize(size_type n)
+        {
+            FRYSTL_ASSERT2(n <= _capacity, "fixed_vector::resize: overflow");
+            while (n < size())
+                pop_back();
+            FillBack(n - size(), [](pointer p) { Construct(p); });
+        }
+        // Like resize(n), but new elements are default-initialized, so
+        // if T is trivial they are left uninitialized.
+        void resize_default_init(size_type n)
+        {
+            FRYSTL_ASSERT2(n <= _capacity, "fixed_vector::resize_default_init: overflow");
+            while (n < size())
+                pop_back();
+            FillBack(n - size(), [](pointer p) { DefaultConstruct(p); });
+        }
+        // Append the elements of rg, which may be any range with begin()
+        // and end(), such as a container.  If its iterators are forward
+        // iterators, capacity is checked once.
+        template <class Range>
+        void append_range(Range &&rg)
+        {
+            AppendRange(std::begin(rg), std::end(rg), typename std::iterator_traits<
+                decltype(std::begin(rg))>::iterator_category());
+        }
+        // Append n elements, each constructed from the value of f().
+        template <class Generator>
+        void generate_back(size_type n, Generator f)
+        {
+            FillBack(n, [&f](pointer p) { Construct(p, f()); });
+        }
+        void swap(this_type &x) noexcept
+        {
+            std::swap(_data, x._data);
+            std::swap(_size, x._size);
+            std::swap(_capacity, x._capacity);
+        }
+        //
+        //******* Private member functions:
+        //
+    private:
+        using storage_type =
+            std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
+        pointer _data;
+        size_type _size;
+        size_type _capacity;
+
+        static pointer Allocate(size_type n)
+        {
+            return n ? reinterpret_cast<pointer>(new storage_type[n]) : nullptr;
+        }
+        void Release() noexcept
+        {
+            delete[] reinterpret_cast<storage_type *>(_data);
+        }
+        static void Verify(bool cond)
+        {
+            if (!cond)
+                throw std::out_of_range("fixed_vector range error");
+        }
+        // Construct n elements after the last by calling construct(p) for
+        // each new cell p in order.  If a call throws, the elements already
+        // constructed are kept.
+        template <class Construct1>
+        void FillBack(size_type n, Construct1 construct)
+        {
+            FRYSTL_ASSERT2(_size + n <= _capacity, "fixed_vector: overflow");
+            pointer p = end();
+            pointer last = p + n;
+            try {
+                for (; p < last; ++p)
+                    construct(p);
+            }
+            catch (...) {
+                _size = p - data();
+                throw;
+            }
+            _size += n;
+        }
+        template <class FwdIter>
+        void AppendRange(FwdIter first, FwdIter last, std::forward_iterator_tag)
+        {
+            FillBack(std::distance(first, last), [&first](pointer p) { Construct(p, *first++); });
+        }
+        template <class InpIter>
+        void AppendRange(InpIter first, InpIter last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+        // Move cells at and to the right of p to the right by n spaces.
+        void MakeRoom(iterator p, size_type n) noexcept
+        {
+            size_type nu = std::min(size_type(end() - p), n);
+            // fill the uninitialized target cells by move construction
+            for (iterator src = end()-nu; src < end(); src++)
+                Construct(src + n , std::move(*src));
+            // shift elements to previously occupied cells by move assignment
+            std::move_backward(p, end() - nu, end());
+        }
+        template <class Arg>
+        void FillCell(iterator pos, const Arg &arg)
+        {
+            if (pos < end())
+                // fill previously occupied cell using assignment
+                (*pos) = value_type(arg);
+            else
+                // fill unoccupied cell in place by constructon
+                Construct(pos, arg);
+        }
+    };
+    //
+    //*******  Non-member overloads
+    //
+    template <class T>
+    bool operator==(const fixed_vector<T> &lhs, const fixed_vector<T> &rhs) noexcept
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        return EqualElements(lhs.data(), rhs.data(), lhs.size());
+    }
+    template <class T>
+    bool operator!=(const fixed_vector<T> &lhs, const fixed_vector<T> &rhs) noexcept
+    {
+        return !(rhs == lhs);
+    }
+    template <class T>
+    bool operator<(const fixed_vector<T> &lhs, const fixed_vector<T> &rhs) noexcept
+    {
+        return LessElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+    }
+    template <class T>
+    bool operator<=(const fixed_vector<T> &lhs, const fixed_vector<T> &rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+    template <class T>
+    bool operator>(const fixed_vector<T> &lhs, const fixed_vector<T> &rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+    template <class T>
+    bool operator>=(const fixed_vector<T> &lhs, const fixed_vector<T> &rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+#ifdef FRYSTL_HAS_THREE_WAY
+    template <class T>
+    auto operator<=>(const fixed_vector<T> &lhs, const fixed_vector<T> &rhs)
+    {
+        return ThreeWayElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+    }
+#endif
+    template <class T>
+    void swap(fixed_vector<T> &a, fixed_vector<T> &b) noexcept
+    {
+        a.swap(b);
+    }
+    // Erase the elements of c for which pred returns true, keeping the
+    // order of the others, in one pass.  Return the number erased.
+    template <class T, class Pred>
+    size_t erase_if(fixed_vector<T> &c, Pred pred)
+    {
+        return EraseIf(c, pred);
+    }
+    // Erase the elements of c at the positions in indices, which must be
+    // sorted in ascending order, keeping the order of the others, in one
+    // pass.  Return the number erased.
+    template <class T, class Indices>
+    size_t erase_indices(fixed_vector<T> &c, const Indices &indices)
+    {
+        using std::begin;
+        using std::end;
+        return EraseIndices(c, begin(indices), end(indices));
+    }
+}       // namespace frystl
+
+namespace std
+{
+    // Hash the elements of a fixed_vector.  See frystl-hash.hpp.
+    template <class T>
+    struct hash<frystl::fixed_vector<T>>
+    {
+        size_t operator()(const frystl::fixed_vector<T> &c) const
+        {
+            return size_t(frystl::HashRange(c.data(), c.size()));
+        }
+    };
+}       // namespace std
+#endif  // ndef FRYSTL_FIXED_VECTOR
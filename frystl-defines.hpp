@@ -8,13 +8,15 @@
 
 #include <cstdio>       // stderr
 #include <csignal>      // raise, SIGABRT
+#include <cstdlib>      // abort
 
 namespace frystl {
-    static void AssertFailed(const char* assertion, const char* file, unsigned line)
+    [[noreturn]] static void AssertFailed(const char* assertion, const char* file, unsigned line)
     {
         fprintf(stderr, "Assertion \"%s\" failed in %s at line %u.\n", 
             assertion, file, line);
         raise(SIGABRT);
+        abort();    // if a handler returns
     }
 }
 
@@ -23,8 +25,34 @@ namespace frystl {
 #define FRYSTL_ASSERT2(assertion,description)  // empty
 #endif      // FRYSTL_DEBUG
 
-#include <type_traits>          // enable_if, is_convertible
+#include <type_traits>          // enable_if, is_convertible, decay
+#include <utility>              // declval, forward
 #include <iterator>             // iterator_traits, input_iterator_tag
+#include <cstdint>              // uint64_t
+#include <memory>               // construct_at, destroy_at
+#include <algorithm>            // remove_if, equal, lexicographical_compare
+#include <cstring>              // memcmp
+#if __cplusplus >= 202002L && __has_include(<compare>)
+#include <compare>              // strong_ordering, weak_ordering
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>             // _BitScanForward64, __popcnt64
+#endif
+
+// FRYSTL_CONSTEXPR20 marks functions that can be evaluated at compile
+// time if the library has constexpr construct_at() and destroy_at()
+// (C++20).  FRYSTL_HAS_CONSTEXPR20 is defined if it does.
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define FRYSTL_HAS_CONSTEXPR20 1
+#define FRYSTL_CONSTEXPR20 constexpr
+#else
+#define FRYSTL_CONSTEXPR20
+#endif
+// FRYSTL_HAS_THREE_WAY is defined if the containers have operator<=>
+// (C++20).
+#if defined(__cpp_lib_three_way_comparison) && defined(__cpp_lib_concepts)
+#define FRYSTL_HAS_THREE_WAY 1
+#endif
 
 namespace frystl {
     
@@ -40,16 +68,251 @@ namespace frystl {
     {
         return (num+denom-1)/denom;
     }
+    // Return the number of trailing zero bits in x, which must not be 0.
+    static unsigned CountTrailingZeros(uint64_t x)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return index;
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+    // Return the number of one bits in x.
+    static unsigned PopCount(uint64_t x)
+    {
+#ifdef _MSC_VER
+        return unsigned(__popcnt64(x));
+#else
+        return __builtin_popcountll(x);
+#endif
+    }
+    // The type of key(x) for an x of type const T&.  radix_sort() 
+    // requires it to be an unsigned integer type.
+    template <class T, class KeyFn>
+    using RadixKey = std::decay_t<decltype(std::declval<KeyFn&>()(std::declval<const T&>()))>;
+    // The smallest unsigned integer type that can hold N.  The fixed-
+    // capacity containers use it to store sizes and offsets.
+    template <size_t N>
+    using SmallestUnsigned = std::conditional_t<(N <= UINT8_MAX), uint8_t,
+        std::conditional_t<(N <= UINT16_MAX), uint16_t, uint32_t>>;
     template <class value_type, class... Args>
-    void Construct(value_type* where, Args&&... args)
+    FRYSTL_CONSTEXPR20 void Construct(value_type* where, Args&&... args)
     {
+#ifdef FRYSTL_HAS_CONSTEXPR20
+        std::construct_at(where, std::forward<Args>(args)...);
+#else
         new ((void*)where) value_type(std::forward<Args>(args)...);
+#endif
+    }
+    // Construct a value_type at where by default-initialization, which
+    // leaves a trivial type uninitialized.
+    template <class value_type>
+    void DefaultConstruct(value_type* where)
+    {
+        new ((void*)where) value_type;
     }
     template <class value_type>
-    void Destroy(value_type * x)
+    FRYSTL_CONSTEXPR20 void Destroy(value_type * x)
     {
         x->~value_type();
     }
+    // Put value in the cell dst of a container whose cells before
+    // oldEnd hold elements and whose cells at and after it do not.
+    template <class Iter, class V>
+    FRYSTL_CONSTEXPR20 void PlaceInCell(Iter dst, Iter oldEnd, V&& value)
+    {
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+        if (!(dst < oldEnd))
+            Construct(&*dst, std::forward<V>(value));
+        else if constexpr (std::is_same<V, value_type>::value)
+            *dst = std::move(value);
+        else
+            *dst = value_type(std::forward<V>(value));
+    }
+    // Helper for the batch inserts.  The cells [first, oldEnd) of a 
+    // container hold its elements, and the n cells after them are free.
+    // Merge n new elements into them, working back from the end so that
+    // each element moves at most once.  takeNew() must return the last
+    // new element not yet merged and forget it.  existingAfter(e, i) 
+    // must return true if e, the existing element at index i, belongs
+    // after that new element.
+    template <class Iter, class TakeNew, class ExistingAfter>
+    FRYSTL_CONSTEXPR20 void MergeBackward(Iter first, Iter oldEnd, size_t n,
+        TakeNew takeNew, ExistingAfter existingAfter)
+    {
+        Iter src = oldEnd;
+        Iter dst = oldEnd + n;
+        size_t srcIndex = oldEnd - first;
+        while (n) {
+            --dst;
+            if (src != first && existingAfter(*std::prev(src), srcIndex - 1)) {
+                --src;
+                --srcIndex;
+                PlaceInCell(dst, oldEnd, std::move(*src));
+            }
+            else {
+                --n;
+                PlaceInCell(dst, oldEnd, takeNew());
+            }
+        }
+    }
+    // is_bitwise_comparable<T>::value is true if two values of type T
+    // are equal exactly when their bytes are equal, so that arrays of
+    // them can be compared with memcmp().  It is true for integers and
+    // pointers.  Specialize it for other such types.
+    template <class T>
+    struct is_bitwise_comparable : std::integral_constant<bool,
+        std::is_integral<T>::value || std::is_pointer<T>::value> {};
+    // is_trivially_relocatable<T>::value is true if moving a T to a new
+    // address and destroying the original is equivalent to copying its
+    // bytes, so that the containers may shift elements with memmove().
+    // It is true for trivially copyable types and std::unique_ptr with
+    // the default deleter.  Specialize it for other such types.  Types
+    // that point into themselves, such as libstdc++'s std::string, are
+    // not.
+    template <class T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+    template <class T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+    // Move the n elements at src to the raw cells at dst, which may
+    // overlap them, by copying their bytes.  Afterward the cells at src
+    // that are not also at dst are raw.  Requires is_trivially_relocatable<T>.
+    template <class T>
+    void RelocateElements(T* dst, T* src, size_t n) noexcept
+    {
+        std::memmove(static_cast<void*>(dst), static_cast<void*>(src), n * sizeof(T));
+    }
+    // Return true during constant evaluation, where memcmp() may not
+    // be called.  Always false before C++20.
+    constexpr bool ConstantEvaluated() noexcept
+    {
+#ifdef FRYSTL_HAS_CONSTEXPR20
+        return std::is_constant_evaluated();
+#else
+        return false;
+#endif
+    }
+    // Return a negative number, zero, or a positive number as the n
+    // elements at a are lexicographically less than, equal to, or
+    // greater than the n elements at b.  Requires
+    // is_bitwise_comparable<T>.
+    template <class T>
+    FRYSTL_CONSTEXPR20 int CompareElements(const T* a, const T* b, size_t n) noexcept
+    {
+        size_t i = 0;
+        if (!ConstantEvaluated()) {
+            // memcmp() orders unsigned bytes as < does.
+            if constexpr (std::is_unsigned<T>::value && sizeof(T) == 1)
+                return n ? std::memcmp(a, b, n) : 0;
+            // Otherwise it can only skip the equal prefix, 64 bytes
+            // at a time.
+            constexpr size_t run = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+            while (i + run <= n && std::memcmp(a + i, b + i, run * sizeof(T)) == 0)
+                i += run;
+        }
+        for (; i < n; ++i)
+            if (!(a[i] == b[i]))
+                return a[i] < b[i] ? -1 : 1;
+        return 0;
+    }
+    // Helpers for the comparison operators of the containers whose
+    // elements are contiguous.  They use memcmp() for elements that
+    // are bitwise comparable.
+    //
+    // Return true if the n elements at a equal the n elements at b.
+    template <class T>
+    FRYSTL_CONSTEXPR20 bool EqualElements(const T* a, const T* b, size_t n)
+    {
+        if constexpr (is_bitwise_comparable<T>::value) {
+            if (!ConstantEvaluated())
+                return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+        }
+        return std::equal(a, a + n, b);
+    }
+    // Return true if the na elements at a are lexicographically less
+    // than the nb elements at b.
+    template <class T>
+    FRYSTL_CONSTEXPR20 bool LessElements(const T* a, size_t na, const T* b, size_t nb)
+    {
+        if constexpr (is_bitwise_comparable<T>::value) {
+            int r = CompareElements(a, b, std::min(na, nb));
+            return r < 0 || (r == 0 && na < nb);
+        }
+        else
+            return std::lexicographical_compare(a, a + na, b, b + nb);
+    }
+#ifdef FRYSTL_HAS_THREE_WAY
+    // The standard's synth-three-way: compare with <=> if T has it,
+    // otherwise with <.
+    struct SynthThreeWay
+    {
+        template <class T>
+        constexpr auto operator()(const T& a, const T& b) const
+        {
+            if constexpr (std::three_way_comparable<T>)
+                return a <=> b;
+            else
+                return a < b ? std::weak_ordering::less
+                    : b < a ? std::weak_ordering::greater
+                    : std::weak_ordering::equivalent;
+        }
+    };
+    // Compare the na elements at a with the nb elements at b
+    // lexicographically.
+    template <class T>
+    constexpr auto ThreeWayElements(const T* a, size_t na, const T* b, size_t nb)
+    {
+        if constexpr (is_bitwise_comparable<T>::value) {
+            int r = CompareElements(a, b, std::min(na, nb));
+            return r != 0 ? r <=> 0 : na <=> nb;
+        }
+        else
+            return std::lexicographical_compare_three_way(a, a + na, b, b + nb,
+                SynthThreeWay());
+    }
+#endif  // def FRYSTL_HAS_THREE_WAY
+    // Helper for the erase_if() overloads.  Erase the elements of c
+    // for which pred returns true, keeping the order of the rest, and
+    // return the number erased.  Each survivor moves at most once.
+    template <class Container, class Pred>
+    FRYSTL_CONSTEXPR20 size_t EraseIf(Container& c, Pred pred)
+    {
+        auto newEnd = std::remove_if(c.begin(), c.end(), pred);
+        size_t n = c.end() - newEnd;
+        c.erase(newEnd, c.end());
+        return n;
+    }
+    // Helper for the erase_indices() overloads.  Erase the elements of c
+    // at the indices [first, last), which must be sorted in ascending
+    // order, keeping the order of the rest, and return the number erased.
+    // Repeated indices are erased once.  Each survivor moves at most once.
+    template <class Container, class IndexIter>
+    FRYSTL_CONSTEXPR20 size_t EraseIndices(Container& c, IndexIter first, IndexIter last)
+    {
+        if (first == last)
+            return 0;
+        const size_t n = c.size();
+        size_t i = *first;
+        FRYSTL_ASSERT2(i < n, "erase_indices(): index out of range");
+        auto dst = c.begin() + i;
+        auto src = dst;
+        for (; i < n; ++i, ++src) {
+            if (first != last && size_t(*first) == i) {
+                do ++first; while (first != last && size_t(*first) == i);
+                FRYSTL_ASSERT2(first == last || (i < size_t(*first) && size_t(*first) < n),
+                    "erase_indices(): indices unsorted or out of range");
+            }
+            else {
+                *dst = std::move(*src);
+                ++dst;
+            }
+        }
+        size_t nErased = c.end() - dst;
+        c.erase(dst, c.end());
+        return nErased;
+    }
 }
 
 #endif  // ndef FRYSTL_DEFINES_H
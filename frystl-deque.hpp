@@ -0,0 +1,79 @@
+// frystl-deque.hpp - element shifting for static_deque and fixed_deque
+//
+// Both deques keep their elements in the cells [begin, end) of a fixed
+// array of cells and leave the other cells raw.  The functions here
+// slide a run of elements into raw cells before or after it and leave
+// the cells it gives up raw.  Trivially relocatable elements are slid
+// with memmove(); others are move-constructed into raw cells,
+// move-assigned over live ones, and destroyed where they are left.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_DEQUE_H
+#define FRYSTL_DEQUE_H
+
+#include <algorithm>    // min, max, move, move_backward
+#include <utility>      // move
+#include "frystl-defines.hpp"
+
+namespace frystl
+{
+    template <class T>
+    void DestroyRange(T *first, T *last) noexcept
+    {
+        for (; first < last; ++first)
+            Destroy(first);
+    }
+    // Slide the elements [first, last) to start at tgt, which is before
+    // first.  The cells before first must be raw.
+    template <class T>
+    void SlideRangeToFront(T *first, T *last, T *tgt) noexcept
+    {
+        if (is_trivially_relocatable<T>::value) {
+            RelocateElements(tgt, first, last - first);
+            return;
+        }
+        T *src = first;
+        while (src != last && tgt < first)
+            Construct(tgt++, std::move(*src++));
+        // Destroy the moved-from elements not overwritten.
+        DestroyRange(std::max(std::move(src, last, tgt), first), last);
+    }
+    // Slide the elements [first, last) to end at tgt, which is after
+    // last.  The cells at and after last must be raw.
+    template <class T>
+    void SlideRangeToBack(T *first, T *last, T *tgt) noexcept
+    {
+        if (is_trivially_relocatable<T>::value) {
+            RelocateElements(tgt - (last - first), first, last - first);
+            return;
+        }
+        T *src = last;
+        while (first < src && last < tgt)
+            Construct(--tgt, std::move(*--src));
+        // Destroy the moved-from elements not overwritten.
+        DestroyRange(first, std::min(std::move_backward(first, src, tgt), last));
+    }
+}   // namespace frystl
+
+#endif  // ndef FRYSTL_DEQUE_H
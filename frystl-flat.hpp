@@ -0,0 +1,304 @@
+// frystl-flat.hpp - layouts and searches for static_flat_set and
+// static_flat_map
+//
+// A flat container keeps its keys in one static_vector, in the order
+// given by its layout.  A layout is a class of static functions that
+// search the keys and step from one to the next in ascending order.
+// Positions in the static_vector are called slots; ranks are positions
+// in ascending order.  For n keys, slot n is the end.
+//
+// sorted_layout keeps the keys in ascending order and finds them by a
+// branchless binary search, which compiles to conditional moves instead
+// of unpredictable branches.  If the keys are 1-, 2- or 4-byte integers
+// ordered by std::less and occupy at most FRYSTL_FLAT_LINEAR_BYTES
+// bytes (default 256), it counts the keys less than the one sought with
+// the SIMD kernels of frystl-simd.hpp instead.
+//
+// eytzinger_layout keeps the keys in the breadth-first order of a
+// complete binary search tree: the children of the key in slot k-1 are
+// in slots 2k-1 and 2k.  The first levels of the tree share cache
+// lines, so searches of larger containers miss the cache less often.
+// Iterating takes a few more steps, and inserting or erasing rebuilds
+// the tree, which takes linear time like the shift in a sorted vector
+// but moves every key twice, in place, and puts an array of Capacity
+// uint32_t on the stack.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_FLAT_H
+#define FRYSTL_FLAT_H
+
+#include <cstdint>      // uint32_t, uint64_t
+#include <functional>   // less
+#include <type_traits>  // is_same
+#include <algorithm>    // move
+#include <utility>      // move
+#include "frystl-defines.hpp"
+#include "frystl-simd.hpp"
+#include "static_vector.hpp"
+
+#ifndef FRYSTL_FLAT_LINEAR_BYTES
+#define FRYSTL_FLAT_LINEAR_BYTES 256
+#endif
+
+namespace frystl
+{
+    // True if a linear SIMD count finds the lower bound of keys of type
+    // K ordered by Compare
+    template <class K, class Compare>
+    constexpr bool FlatSimdSearchable = SimdSearchable<K> &&
+        (std::is_same<Compare, std::less<K>>::value || std::is_same<Compare, std::less<>>::value);
+
+    // Gather the cycle of src through slot i in v and each of vs, and
+    // then mark its slots done.
+    template <class V, class... Vs>
+    void FlatGatherCycle(uint32_t *src, uint32_t i, V &v, Vs &... vs)
+    {
+        typename V::value_type held(std::move(v[i]));
+        uint32_t j = i;
+        for (; src[j] != i; j = src[j])
+            v[j] = std::move(v[src[j]]);
+        v[j] = std::move(held);
+        if constexpr (sizeof...(Vs) == 0) {
+            for (j = i; src[j] != j; ) {
+                uint32_t next = src[j];
+                src[j] = j;
+                j = next;
+            }
+        }
+        else {
+            FlatGatherCycle(src, i, vs...);
+        }
+    }
+    // Set each v[i] to the old v[src[i]] for i in [0, n), where src is
+    // a permutation of [0, n), following its cycles and marking the
+    // slots done by setting src[i] to i.
+    template <class... V>
+    void FlatGather(uint32_t *src, uint32_t n, V &... vs)
+    {
+        for (uint32_t i = 0; i < n; ++i)
+            if (src[i] != i)
+                FlatGatherCycle(src, i, vs...);
+    }
+
+    struct sorted_layout
+    {
+        // Return the slot of the first key k in keys[0..n) for which
+        // pred(k) is false.  pred must be true for a prefix of the keys.
+        template <class K, class Pred>
+        static uint32_t Partition(const K *keys, uint32_t n, Pred pred)
+        {
+            if (n == 0)
+                return 0;
+            const K *base = keys;
+            while (n > 1) {
+                uint32_t half = n / 2;
+                base = pred(base[half]) ? base + half : base;
+                n -= half;
+            }
+            return uint32_t(base - keys) + uint32_t(pred(*base));
+        }
+        template <class K, class Compare>
+        static uint32_t LowerBound(const K *keys, uint32_t n, const K &key, const Compare &comp)
+        {
+            if constexpr (FlatSimdSearchable<K, Compare>) {
+                if (n * sizeof(K) <= FRYSTL_FLAT_LINEAR_BYTES)
+                    return uint32_t(SimdCountLess(keys, n, key));
+            }
+            return Partition(keys, n, [&](const K &k) { return comp(k, key); });
+        }
+        template <class K, class Compare>
+        static uint32_t UpperBound(const K *keys, uint32_t n, const K &key, const Compare &comp)
+        {
+            return Partition(keys, n, [&](const K &k) { return !comp(key, k); });
+        }
+        static uint32_t First(uint32_t) noexcept { return 0; }
+        static uint32_t Next(uint32_t slot, uint32_t) noexcept { return slot + 1; }
+        static uint32_t Prev(uint32_t slot, uint32_t) noexcept { return slot - 1; }
+        static uint32_t SlotOfRank(uint32_t rank, uint32_t) noexcept { return rank; }
+        static uint32_t RankOfSlot(uint32_t slot, uint32_t) noexcept { return slot; }
+        // Put the elements of vs, which are in layout order, in
+        // ascending order, and back.
+        template <class... V>
+        static void ToSorted(V &...) noexcept {}
+        template <class... V>
+        static void FromSorted(V &...) noexcept {}
+    };
+
+    struct eytzinger_layout
+    {
+        // Slot k-1 holds node k of the tree; node 0 is the end.
+        template <class K, class Pred>
+        static uint32_t Partition(const K *keys, uint32_t n, Pred pred)
+        {
+            uint32_t k = 1;
+            while (k <= n)
+                k = 2 * k + uint32_t(pred(keys[k - 1]));
+            // Undo the right turns after the last left turn.
+            k >>= CountTrailingZeros(~uint64_t(k)) + 1;
+            return k ? k - 1 : n;
+        }
+        template <class K, class Compare>
+        static uint32_t LowerBound(const K *keys, uint32_t n, const K &key, const Compare &comp)
+        {
+            return Partition(keys, n, [&](const K &k) { return comp(k, key); });
+        }
+        template <class K, class Compare>
+        static uint32_t UpperBound(const K *keys, uint32_t n, const K &key, const Compare &comp)
+        {
+            return Partition(keys, n, [&](const K &k) { return !comp(key, k); });
+        }
+        static uint32_t First(uint32_t n) noexcept
+        {
+            uint32_t k = 1;
+            while (2 * k <= n)
+                k *= 2;
+            return n ? k - 1 : n;
+        }
+        static uint32_t Next(uint32_t slot, uint32_t n) noexcept
+        {
+            uint32_t k = slot + 1;
+            if (2 * k + 1 <= n) {
+                // the leftmost node of the right subtree
+                k = 2 * k + 1;
+                while (2 * k <= n)
+                    k *= 2;
+            }
+            else {
+                // up past the nodes of which this is in the right subtree
+                while (k & 1)
+                    k >>= 1;
+                k >>= 1;
+            }
+            return k ? k - 1 : n;
+        }
+        static uint32_t Prev(uint32_t slot, uint32_t n) noexcept
+        {
+            uint32_t k = slot + 1;
+            if (slot == n) {
+                k = 1;
+                while (2 * k + 1 <= n)
+                    k = 2 * k + 1;
+            }
+            else if (2 * k <= n) {
+                // the rightmost node of the left subtree
+                k = 2 * k;
+                while (2 * k + 1 <= n)
+                    k = 2 * k + 1;
+            }
+            else {
+                while (!(k & 1))
+                    k >>= 1;
+                k >>= 1;
+            }
+            return k - 1;
+        }
+        static uint32_t SlotOfRank(uint32_t rank, uint32_t n) noexcept
+        {
+            if (rank >= n)
+                return n;
+            uint32_t k = 1;
+            for (;;) {
+                uint32_t left = SubtreeSize(2 * k, n);
+                if (rank == left)
+                    return k - 1;
+                if (rank < left) {
+                    k = 2 * k;
+                }
+                else {
+                    rank -= left + 1;
+                    k = 2 * k + 1;
+                }
+            }
+        }
+        static uint32_t RankOfSlot(uint32_t slot, uint32_t n) noexcept
+        {
+            if (slot == n)
+                return n;
+            uint32_t k = slot + 1;
+            uint32_t rank = SubtreeSize(2 * k, n);
+            // Count each left sibling on the way up, and its parent.
+            for (; k > 1; k >>= 1)
+                if (k & 1)
+                    rank += SubtreeSize(k - 1, n) + 1;
+            return rank;
+        }
+        // Permute the elements of vs, each in layout order, into
+        // ascending order, and back.  Each element moves once, plus once
+        // per cycle of the permutation.
+        template <class... V>
+        static void ToSorted(V &... vs)
+        {
+            uint32_t src[FirstCapacity<V...>];
+            const uint32_t n = SizeOf(vs...);
+            uint32_t rank = 0;
+            for (uint32_t slot = First(n); slot != n; slot = Next(slot, n))
+                src[rank++] = slot;
+            FlatGather(src, n, vs...);
+        }
+        template <class... V>
+        static void FromSorted(V &... vs)
+        {
+            uint32_t src[FirstCapacity<V...>];
+            const uint32_t n = SizeOf(vs...);
+            uint32_t rank = 0;
+            for (uint32_t slot = First(n); slot != n; slot = Next(slot, n))
+                src[slot] = rank++;
+            FlatGather(src, n, vs...);
+        }
+
+    private:
+        template <class V>
+        struct CapacityOf;
+        template <class T, unsigned C>
+        struct CapacityOf<static_vector<T, C>>
+        {
+            static constexpr unsigned value = C;
+        };
+        template <class V, class... Vs>
+        static constexpr unsigned FirstCapacity = CapacityOf<V>::value;
+        template <class V, class... Vs>
+        static uint32_t SizeOf(const V &v, const Vs &...) noexcept
+        {
+            return v.size();
+        }
+        // The number of nodes in the subtree of node k
+        static uint32_t SubtreeSize(uint32_t k, uint32_t n) noexcept
+        {
+            uint32_t size = 0;
+            for (uint64_t lo = k, hi = k; lo <= n; lo = 2 * lo, hi = 2 * hi + 1)
+                size += uint32_t((hi < n ? hi : n) - lo + 1);
+            return size;
+        }
+    };
+
+    // The pointer type of an iterator whose reference type is a proxy
+    template <class Reference>
+    struct ArrowProxy
+    {
+        Reference ref;
+        Reference *operator->() noexcept { return &ref; }
+    };
+}   // namespace frystl
+
+#endif  // ndef FRYSTL_FLAT_H
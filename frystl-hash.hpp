@@ -0,0 +1,119 @@
+// frystl-hash.hpp - hashing helpers for frystl containers
+//
+// HashBytes() is a 64-bit hash of a byte string that reads it 16
+// bytes at a time and mixes with 64x64->128-bit multiplications, in
+// the manner of wyhash.  HashRange() hashes a contiguous array of
+// elements: as raw bytes if equal elements are sure to have equal
+// bytes (std::has_unique_object_representations), otherwise by
+// combining std::hash of each element.  Both take a seed, so that
+// non-contiguous containers can hash their pieces in a chain.
+//
+// The values depend on the byte order of the machine.  They are not
+// meant to be stored or to resist deliberate collisions.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_HASH_H
+#define FRYSTL_HASH_H
+
+#include <cstddef>      // size_t
+#include <cstdint>      // uint64_t
+#include <cstring>      // memcpy
+#include <functional>   // hash
+#include <type_traits>  // has_unique_object_representations
+#ifdef _MSC_VER
+#include <intrin.h>     // _umul128
+#endif
+
+namespace frystl
+{
+    constexpr uint64_t HashK0 = 0xa0761d6478bd642full;
+    constexpr uint64_t HashK1 = 0xe7037ed1a0b428dbull;
+    constexpr uint64_t HashK2 = 0x8ebc6af09c88c6e3ull;
+
+    // Multiply a by b and fold the 128-bit product to 64 bits.
+    inline uint64_t HashMix(uint64_t a, uint64_t b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        return uint64_t(r) ^ uint64_t(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        uint64_t hi;
+        uint64_t lo = _umul128(a, b, &hi);
+        return lo ^ hi;
+#else
+        uint64_t aHi = a >> 32, aLo = uint32_t(a);
+        uint64_t bHi = b >> 32, bLo = uint32_t(b);
+        uint64_t hh = aHi * bHi, hl = aHi * bLo, lh = aLo * bHi, ll = aLo * bLo;
+        uint64_t mid = (ll >> 32) + uint32_t(hl) + uint32_t(lh);
+        uint64_t lo = (mid << 32) | uint32_t(ll);
+        uint64_t hi = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+        return lo ^ hi;
+#endif
+    }
+    // Read n <= 8 bytes at p as the low bytes of a word.
+    inline uint64_t HashLoad(const unsigned char* p, size_t n) noexcept
+    {
+        uint64_t w = 0;
+        if (n)
+            std::memcpy(&w, p, n);
+        return w;
+    }
+    // Return a hash of the n bytes at p.
+    inline uint64_t HashBytes(const void* data, size_t n, uint64_t seed = 0) noexcept
+    {
+        auto p = static_cast<const unsigned char*>(data);
+        uint64_t h = seed ^ HashK0;
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+            h = HashMix(HashLoad(p + i, 8) ^ HashK1, HashLoad(p + i + 8, 8) ^ h);
+        uint64_t a, b;
+        size_t rest = n - i;
+        if (rest > 8) {
+            a = HashLoad(p + i, 8);
+            b = HashLoad(p + i + 8, rest - 8);
+        }
+        else {
+            a = HashLoad(p + i, rest);
+            b = 0;
+        }
+        return HashMix(HashK2 ^ n, HashMix(a ^ HashK1, b ^ h));
+    }
+    // Return a hash of the n elements at p.
+    template <class T>
+    uint64_t HashRange(const T* p, size_t n, uint64_t seed = 0)
+    {
+        if constexpr (std::has_unique_object_representations<T>::value) {
+            return HashBytes(p, n * sizeof(T), seed);
+        }
+        else {
+            std::hash<T> hasher;
+            uint64_t h = seed ^ HashK0;
+            for (size_t i = 0; i < n; ++i)
+                h = HashMix(h ^ HashK1, uint64_t(hasher(p[i])) ^ HashK2);
+            return HashMix(HashK2 ^ n, h ^ HashK1);
+        }
+    }
+}   // namespace frystl
+
+#endif  // ndef FRYSTL_HASH_H
@@ -0,0 +1,435 @@
+// frystl-hashtable.hpp - the hash table under static_unordered_set and
+// static_unordered_map
+//
+// StaticHashTable holds up to Capacity values with no dynamic storage.
+// The values are kept densely, in the order inserted except that
+// erasing a value moves the last one into its place.  An index table
+// of Slots cells, the least power of 2 at least 8/7 of Capacity, maps
+// hashes to them by Robin Hood linear probing: an insertion displaces
+// any value closer to its home slot than the one being placed, so
+// probe sequences stay short, and a search can stop at the first
+// value closer to home than the key would be.  Erasure shifts the
+// following values of the cluster back one slot, so there are no
+// tombstones and the table never needs rebuilding.
+//
+// Each value is stored with its hash and its slot, and a slot is in
+// use only if the value it names names it back.  So stale cells need
+// no clearing: the index table is zeroed once, at construction, and
+// clear() destroys the values and sets the size to zero, taking time
+// proportional to the size, not the capacity.
+//
+// The hash is std::hash or another Hash, mixed by HashMix() of
+// frystl-hash.hpp so that identity hashes of integers spread well.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_HASHTABLE_H
+#define FRYSTL_HASHTABLE_H
+
+#include <cstddef>      // ptrdiff_t
+#include <cstdint>      // uint32_t, uint64_t
+#include <iterator>     // forward_iterator_tag
+#include <type_traits>  // aligned_storage_t, conditional_t, decay_t
+#include <utility>      // pair, move, forward, declval
+#include "frystl-defines.hpp"
+#include "frystl-hash.hpp"
+
+namespace frystl
+{
+    // The number of slots of a table of capacity values: the least power
+    // of 2 at least 8/7 of capacity and greater than it.
+    constexpr uint32_t HashSlots(uint64_t capacity)
+    {
+        uint64_t need = capacity + capacity / 7 + 1;
+        uint64_t slots = 1;
+        while (slots < need)
+            slots *= 2;
+        return uint32_t(slots);
+    }
+
+    // KeyOf::Get(value) returns the key of a value.
+    template <class Value, class KeyOf, unsigned Capacity, class Hash, class KeyEqual>
+    class StaticHashTable
+    {
+        struct Entry;
+        template <bool Const> class Iterator;
+    public:
+        using key_type = std::decay_t<decltype(KeyOf::Get(std::declval<const Value &>()))>;
+        using value_type = Value;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using size_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+        //
+        //******* Public member functions:
+        //
+        StaticHashTable() noexcept
+            : _index {}
+            , _size(0)
+        {}
+        StaticHashTable(const StaticHashTable &other)
+            : _size(0)
+            , _hash(other._hash)
+            , _eq(other._eq)
+        {
+            CopyFrom(other);
+        }
+        StaticHashTable(StaticHashTable &&other) noexcept
+            : _size(0)
+            , _hash(other._hash)
+            , _eq(other._eq)
+        {
+            MoveFrom(other);
+        }
+        StaticHashTable &operator=(const StaticHashTable &other)
+        {
+            if (this != &other) {
+                clear();
+                _hash = other._hash;
+                _eq = other._eq;
+                CopyFrom(other);
+            }
+            return *this;
+        }
+        StaticHashTable &operator=(StaticHashTable &&other) noexcept
+        {
+            if (this != &other) {
+                clear();
+                _hash = other._hash;
+                _eq = other._eq;
+                MoveFrom(other);
+            }
+            return *this;
+        }
+        void swap(StaticHashTable &other) noexcept
+        {
+            StaticHashTable t(std::move(other));
+            other = std::move(*this);
+            *this = std::move(t);
+        }
+        ~StaticHashTable() noexcept
+        {
+            clear();
+        }
+        //
+        //  Iterators, which visit the values in storage order
+        //
+        iterator begin() noexcept { return iterator(E(0)); }
+        const_iterator begin() const noexcept { return const_iterator(E(0)); }
+        iterator end() noexcept { return iterator(E(_size)); }
+        const_iterator end() const noexcept { return const_iterator(E(_size)); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+        //
+        //  Capacity
+        //
+        size_type size() const noexcept { return _size; }
+        bool empty() const noexcept { return _size == 0; }
+        constexpr size_type capacity() const noexcept { return Capacity; }
+        constexpr size_type max_size() const noexcept { return Capacity; }
+        constexpr size_type bucket_count() const noexcept { return Slots; }
+        float load_factor() const noexcept { return float(_size) / Slots; }
+        //
+        //  Modifiers
+        //
+        // Destroy the values.  The index table is left as it is.
+        void clear() noexcept
+        {
+            for (uint32_t i = 0; i < _size; ++i)
+                Destroy(E(i));
+            _size = 0;
+        }
+        // Erase the value at position and move the last value into its
+        // place.  Return position, which then refers to that value, or
+        // is end().  So a loop may erase as it goes:
+        //     for (it = t.begin(); it != t.end(); )
+        //         it = pred(*it) ? t.erase(it) : std::next(it);
+        iterator erase(const_iterator position) noexcept
+        {
+            uint32_t i = uint32_t(position._p - E(0));
+            FRYSTL_ASSERT2(i < _size, "static_unordered: erase() bad position");
+            EraseIndex(i);
+            return iterator(E(i));
+        }
+        size_type erase(const key_type &key) noexcept
+        {
+            uint32_t i = FindIndex(key);
+            if (i == Capacity)
+                return 0;
+            EraseIndex(i);
+            return 1;
+        }
+        //
+        //  Lookup
+        //
+        iterator find(const key_type &key) noexcept
+        {
+            uint32_t i = FindIndex(key);
+            return iterator(E(i == Capacity ? _size : i));
+        }
+        const_iterator find(const key_type &key) const noexcept
+        {
+            uint32_t i = FindIndex(key);
+            return const_iterator(E(i == Capacity ? _size : i));
+        }
+        size_type count(const key_type &key) const noexcept
+        {
+            return FindIndex(key) != Capacity;
+        }
+        bool contains(const key_type &key) const noexcept
+        {
+            return FindIndex(key) != Capacity;
+        }
+        //
+        //  Observers
+        //
+        hasher hash_function() const { return _hash; }
+        key_equal key_eq() const { return _eq; }
+
+    protected:
+        static constexpr uint32_t Slots = HashSlots(Capacity);
+        static constexpr uint32_t Mask = Slots - 1;
+
+        // If no value has key, construct one from args.  Return an
+        // iterator to the value with key, and true if it is new.
+        template <class... Args>
+        std::pair<iterator, bool> EmplaceKey(const key_type &key, Args &&... args)
+        {
+            const uint32_t h = HashOf(key);
+            uint32_t s = h & Mask;
+            uint32_t d = 0;
+            for (;; s = (s + 1) & Mask, ++d) {
+                uint32_t i = Occupant(s);
+                if (i == Capacity || Distance(i, s) < d)
+                    break;
+                if (E(i)->hash == h && _eq(KeyOf::Get(E(i)->value), key))
+                    return {iterator(E(i)), false};
+            }
+            FRYSTL_ASSERT2(_size < Capacity, "static_unordered: overflow");
+            uint32_t n = _size;
+            Construct(E(n), h, std::forward<Args>(args)...);
+            ++_size;
+            Place(n, s, d);
+            return {iterator(E(n)), true};
+        }
+        // True if other holds values equal to these.
+        bool Equal(const StaticHashTable &other) const
+        {
+            if (_size != other._size)
+                return false;
+            for (uint32_t i = 0; i < _size; ++i) {
+                uint32_t j = other.FindIndex(KeyOf::Get(E(i)->value));
+                if (j == Capacity || !(other.E(j)->value == E(i)->value))
+                    return false;
+            }
+            return true;
+        }
+
+    private:
+        using Index = SmallestUnsigned<Capacity>;
+        using SlotIndex = SmallestUnsigned<Slots>;
+        struct Entry
+        {
+            Value value;
+            uint32_t hash;
+            SlotIndex slot;     // Slots until placed
+
+            template <class... Args>
+            explicit Entry(uint32_t h, Args &&... args)
+                : value(std::forward<Args>(args)...)
+                , hash(h)
+                , slot(SlotIndex(Slots))
+            {}
+        };
+        template <bool Const>
+        class Iterator
+        {
+            using EntryType = std::conditional_t<Const, const Entry, Entry>;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Value;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const Value &, Value &>;
+            using pointer = std::conditional_t<Const, const Value *, Value *>;
+
+            Iterator() noexcept : _p(nullptr) {}
+            // Convert an iterator to a const_iterator
+            template <bool C = Const, typename = std::enable_if_t<C>>
+            Iterator(const Iterator<false> &it) noexcept : _p(it._p) {}
+            reference operator*() const noexcept { return _p->value; }
+            pointer operator->() const noexcept { return &_p->value; }
+            Iterator &operator++() noexcept
+            {
+                ++_p;
+                return *this;
+            }
+            Iterator operator++(int) noexcept
+            {
+                Iterator r = *this;
+                ++_p;
+                return r;
+            }
+            friend bool operator==(const Iterator &a, const Iterator &b) noexcept
+            {
+                return a._p == b._p;
+            }
+            friend bool operator!=(const Iterator &a, const Iterator &b) noexcept
+            {
+                return a._p != b._p;
+            }
+        private:
+            friend class StaticHashTable;
+            friend class Iterator<true>;
+            explicit Iterator(EntryType *p) noexcept : _p(p) {}
+            EntryType *_p;
+        };
+
+        std::aligned_storage_t<sizeof(Entry), alignof(Entry)> _entries[Capacity];
+        Index _index[Slots];    // _index[s] is the entry in slot s, if any
+        Index _size;
+        Hash _hash;
+        KeyEqual _eq;
+
+        Entry *E(uint32_t i) noexcept { return reinterpret_cast<Entry *>(_entries) + i; }
+        const Entry *E(uint32_t i) const noexcept
+        {
+            return reinterpret_cast<const Entry *>(_entries) + i;
+        }
+        uint32_t HashOf(const key_type &key) const
+        {
+            return uint32_t(HashMix(uint64_t(_hash(key)) ^ HashK1, HashK2));
+        }
+        // The index of the entry in slot s, or Capacity if s is empty
+        uint32_t Occupant(uint32_t s) const noexcept
+        {
+            uint32_t i = _index[s];
+            return i < _size && E(i)->slot == s ? i : Capacity;
+        }
+        // How far slot s is from the home slot of entry i
+        uint32_t Distance(uint32_t i, uint32_t s) const noexcept
+        {
+            return (s - E(i)->hash) & Mask;
+        }
+        void Put(uint32_t i, uint32_t s) noexcept
+        {
+            _index[s] = Index(i);
+            E(i)->slot = SlotIndex(s);
+        }
+        // The index of the entry with key, or Capacity if there is none
+        uint32_t FindIndex(const key_type &key) const
+        {
+            const uint32_t h = HashOf(key);
+            for (uint32_t s = h & Mask, d = 0;; s = (s + 1) & Mask, ++d) {
+                uint32_t i = Occupant(s);
+                if (i == Capacity || Distance(i, s) < d)
+                    return Capacity;
+                if (E(i)->hash == h && _eq(KeyOf::Get(E(i)->value), key))
+                    return i;
+            }
+        }
+        // Put entry i in slot s, which is d slots from its home slot,
+        // and each entry it displaces in the next slot for which it is
+        // farther from home than the occupant.
+        void Place(uint32_t i, uint32_t s, uint32_t d) noexcept
+        {
+            for (;; s = (s + 1) & Mask, ++d) {
+                uint32_t occupant = Occupant(s);
+                if (occupant == Capacity) {
+                    Put(i, s);
+                    return;
+                }
+                uint32_t od = Distance(occupant, s);
+                if (od < d) {
+                    Put(i, s);
+                    i = occupant;
+                    d = od;
+                }
+            }
+        }
+        void EraseIndex(uint32_t i) noexcept
+        {
+            // Shift the rest of the cluster back a slot, up to an entry
+            // in its home slot.
+            uint32_t s = E(i)->slot;
+            for (;;) {
+                uint32_t next = (s + 1) & Mask;
+                uint32_t j = Occupant(next);
+                if (j == Capacity || Distance(j, next) == 0)
+                    break;
+                Put(j, s);
+                s = next;
+            }
+            E(i)->slot = SlotIndex(Slots);
+            // Move the last entry into i's place.
+            uint32_t last = _size - 1u;
+            if (i != last) {
+                Destroy(E(i));
+                Construct(E(i), std::move(*E(last)));
+                _index[E(i)->slot] = Index(i);
+            }
+            Destroy(E(last));
+            _size = Index(last);
+        }
+        // The entries of other keep their slots, so the whole index table
+        // is copied.
+        void CopyFrom(const StaticHashTable &other)
+        {
+            for (uint32_t i = 0; i < other._size; ++i) {
+                Construct(E(i), *other.E(i));
+                ++_size;
+            }
+            for (uint32_t s = 0; s < Slots; ++s)
+                _index[s] = other._index[s];
+        }
+        void MoveFrom(StaticHashTable &other) noexcept
+        {
+            for (uint32_t i = 0; i < other._size; ++i) {
+                Construct(E(i), std::move(*other.E(i)));
+                ++_size;
+            }
+            for (uint32_t s = 0; s < Slots; ++s)
+                _index[s] = other._index[s];
+            other.clear();
+        }
+    };
+    // Erase the values of the hash container c for which pred is true.
+    // Return the number erased.
+    template <class Container, class Pred>
+    size_t HashEraseIf(Container &c, Pred pred)
+    {
+        size_t n = c.size();
+        for (auto it = c.begin(); it != c.end(); ) {
+            if (pred(*it))
+                it = c.erase(it);
+            else
+                ++it;
+        }
+        return n - c.size();
+    }
+}   // namespace frystl
+
+#endif  // ndef FRYSTL_HASHTABLE_H
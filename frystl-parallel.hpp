@@ -0,0 +1,75 @@
+// frystl-parallel.hpp - helpers for the parallel algorithms in frystl
+//
+// These helpers use plain std::thread objects.  Each call starts its
+// threads, waits for them to finish, and joins them before returning,
+// so no threads outlive the call.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_PARALLEL_H
+#define FRYSTL_PARALLEL_H
+
+#include <thread>       // thread, hardware_concurrency
+#include <vector>
+#include <algorithm>    // min
+#include <cstddef>      // size_t
+
+namespace frystl {
+
+    // Return the number of threads to use when nThreads were requested.
+    // Zero means "as many as the hardware supports".
+    static unsigned ThreadCount(unsigned nThreads)
+    {
+        if (nThreads == 0)
+            nThreads = std::thread::hardware_concurrency();
+        return nThreads ? nThreads : 1;
+    }
+    // Call f(i) for each i in [0,n).  The calls are divided into at most
+    // nThreads contiguous ranges of nearly equal length, and each range is
+    // run on its own thread.  The calling thread runs the first range.
+    // f must not throw.
+    template <class Func>
+    void ParallelFor(size_t n, unsigned nThreads, Func f)
+    {
+        nThreads = unsigned(std::min<size_t>(ThreadCount(nThreads), n));
+        if (nThreads <= 1) {
+            for (size_t i = 0; i < n; ++i)
+                f(i);
+            return;
+        }
+        auto runRange = [&f, n, nThreads](unsigned t) {
+            size_t last = n * (t + 1) / nThreads;
+            for (size_t i = n * t / nThreads; i < last; ++i)
+                f(i);
+        };
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads - 1);
+        for (unsigned t = 1; t < nThreads; ++t)
+            threads.emplace_back(runRange, t);
+        runRange(0);
+        for (auto& thread : threads)
+            thread.join();
+    }
+}
+
+#endif  // ndef FRYSTL_PARALLEL_H
@@ -0,0 +1,408 @@
+// frystl-simd.hpp - SIMD search and reduction kernels for frystl
+//
+// These kernels find, count, count the elements less than a value of,
+// and take the minimum or maximum of contiguous arrays of 1-, 2- and
+// 4-byte integers.  On x86 they use
+// SSE2, or AVX2 if the processor has it (checked once at run time;
+// GCC and Clang only).  Elsewhere, or for arrays shorter than one
+// vector, they fall back to the standard algorithms.  Define
+// FRYSTL_NO_SIMD to always use the standard algorithms.
+//
+// The kernels read only the elements they are given.  When the length
+// is not a multiple of the vector width, the last load overlaps the
+// one before it instead of reading past the end, so no padding is
+// needed after the elements.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_SIMD_H
+#define FRYSTL_SIMD_H
+
+#include <cstddef>      // size_t
+#include <cstdint>      // uint32_t
+#include <algorithm>    // find, count, count_if, min_element, max_element
+#include <type_traits>  // is_integral, is_signed, make_unsigned
+#include "frystl-defines.hpp"
+
+#ifndef FRYSTL_NO_SIMD
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__)
+#define FRYSTL_SIMD_SSE2 1
+#define FRYSTL_SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define FRYSTL_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif  // ndef FRYSTL_NO_SIMD
+
+#ifdef FRYSTL_SIMD_SSE2
+#ifdef _MSC_VER
+#define FRYSTL_SIMD_INLINE __forceinline
+#else
+#define FRYSTL_SIMD_INLINE inline __attribute__((always_inline))
+#endif
+#endif
+#ifdef FRYSTL_SIMD_AVX2
+#define FRYSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace frystl
+{
+    // True if the kernels handle arrays of T
+    template <class T>
+    constexpr bool SimdSearchable = std::is_integral<T>::value &&
+        !std::is_same<T, bool>::value &&
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+
+#ifdef FRYSTL_SIMD_SSE2
+    // Operations on 128-bit vectors of lanes of type U, an unsigned
+    // integer type.  Min() and Max() exist only if HasMinMax<U>, and
+    // compare lanes as signed if SignedMinMax<U>.
+    struct Sse2Ops
+    {
+        using V = __m128i;
+        static constexpr size_t Bytes = 16;
+        template <class U>
+        static constexpr bool HasMinMax = sizeof(U) < 4;
+        template <class U>
+        static constexpr bool SignedMinMax = sizeof(U) == 2;
+
+        static V Load(const void* p) noexcept
+        {
+            return _mm_loadu_si128(static_cast<const V*>(p));
+        }
+        static void Store(void* p, V a) noexcept
+        {
+            _mm_storeu_si128(static_cast<V*>(p), a);
+        }
+        template <class U>
+        static V Splat(U x) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm_set1_epi8(char(x));
+            else if constexpr (sizeof(U) == 2) return _mm_set1_epi16(short(x));
+            else return _mm_set1_epi32(int(x));
+        }
+        template <class U>
+        static V Equal(V a, V b) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm_cmpeq_epi8(a, b);
+            else if constexpr (sizeof(U) == 2) return _mm_cmpeq_epi16(a, b);
+            else return _mm_cmpeq_epi32(a, b);
+        }
+        // One bit per byte, set if the byte's high bit is set
+        static uint32_t Mask(V a) noexcept
+        {
+            return uint32_t(_mm_movemask_epi8(a));
+        }
+        static V Xor(V a, V b) noexcept
+        {
+            return _mm_xor_si128(a, b);
+        }
+        // Lanes set where a > b, comparing as signed
+        template <class U>
+        static V Greater(V a, V b) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm_cmpgt_epi8(a, b);
+            else if constexpr (sizeof(U) == 2) return _mm_cmpgt_epi16(a, b);
+            else return _mm_cmpgt_epi32(a, b);
+        }
+        template <class U>
+        static V Min(V a, V b) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm_min_epu8(a, b);
+            else return _mm_min_epi16(a, b);
+        }
+        template <class U>
+        static V Max(V a, V b) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm_max_epu8(a, b);
+            else return _mm_max_epi16(a, b);
+        }
+    };
+#endif  // def FRYSTL_SIMD_SSE2
+#ifdef FRYSTL_SIMD_AVX2
+    // Operations on 256-bit vectors.  See Sse2Ops.
+    struct Avx2Ops
+    {
+        using V = __m256i;
+        static constexpr size_t Bytes = 32;
+        template <class U>
+        static constexpr bool HasMinMax = true;
+        template <class U>
+        static constexpr bool SignedMinMax = sizeof(U) != 1;
+
+        FRYSTL_TARGET_AVX2 static V Load(const void* p) noexcept
+        {
+            return _mm256_loadu_si256(static_cast<const V*>(p));
+        }
+        FRYSTL_TARGET_AVX2 static void Store(void* p, V a) noexcept
+        {
+            _mm256_storeu_si256(static_cast<V*>(p), a);
+        }
+        template <class U>
+        FRYSTL_TARGET_AVX2 static V Splat(U x) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm256_set1_epi8(char(x));
+            else if constexpr (sizeof(U) == 2) return _mm256_set1_epi16(short(x));
+            else return _mm256_set1_epi32(int(x));
+        }
+        template <class U>
+        FRYSTL_TARGET_AVX2 static V Equal(V a, V b) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm256_cmpeq_epi8(a, b);
+            else if constexpr (sizeof(U) == 2) return _mm256_cmpeq_epi16(a, b);
+            else return _mm256_cmpeq_epi32(a, b);
+        }
+        FRYSTL_TARGET_AVX2 static uint32_t Mask(V a) noexcept
+        {
+            return uint32_t(_mm256_movemask_epi8(a));
+        }
+        FRYSTL_TARGET_AVX2 static V Xor(V a, V b) noexcept
+        {
+            return _mm256_xor_si256(a, b);
+        }
+        template <class U>
+        FRYSTL_TARGET_AVX2 static V Greater(V a, V b) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm256_cmpgt_epi8(a, b);
+            else if constexpr (sizeof(U) == 2) return _mm256_cmpgt_epi16(a, b);
+            else return _mm256_cmpgt_epi32(a, b);
+        }
+        template <class U>
+        FRYSTL_TARGET_AVX2 static V Min(V a, V b) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm256_min_epu8(a, b);
+            else if constexpr (sizeof(U) == 2) return _mm256_min_epi16(a, b);
+            else return _mm256_min_epi32(a, b);
+        }
+        template <class U>
+        FRYSTL_TARGET_AVX2 static V Max(V a, V b) noexcept
+        {
+            if constexpr (sizeof(U) == 1) return _mm256_max_epu8(a, b);
+            else if constexpr (sizeof(U) == 2) return _mm256_max_epi16(a, b);
+            else return _mm256_max_epi32(a, b);
+        }
+    };
+    // Return true if the processor supports AVX2.
+    inline bool HasAvx2() noexcept
+    {
+        static const bool has = __builtin_cpu_supports("avx2");
+        return has;
+    }
+#endif  // def FRYSTL_SIMD_AVX2
+#ifdef FRYSTL_SIMD_SSE2
+#if defined(__GNUC__) && !defined(__clang__)
+    // The kernels are always inlined into callers that enable the
+    // instructions they use, so GCC's warnings about passing AVX vectors
+    // between functions compiled without AVX do not apply.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+    // The kernels.  Each requires n >= Ops::Bytes/sizeof(U).
+    //
+    // Return the index of the first element of p[0..n) equal to value,
+    // or n if there is none.
+    template <class Ops, class U>
+    FRYSTL_SIMD_INLINE size_t FindKernel(const U* p, size_t n, U value) noexcept
+    {
+        constexpr size_t W = Ops::Bytes / sizeof(U);
+        const auto key = Ops::template Splat<U>(value);
+        size_t i = 0;
+        for (; i + W < n; i += W) {
+            uint32_t m = Ops::Mask(Ops::template Equal<U>(Ops::Load(p + i), key));
+            if (m)
+                return i + CountTrailingZeros(m) / sizeof(U);
+        }
+        i = n - W;
+        uint32_t m = Ops::Mask(Ops::template Equal<U>(Ops::Load(p + i), key));
+        return m ? i + CountTrailingZeros(m) / sizeof(U) : n;
+    }
+    // Return the number of elements of p[0..n) equal to value.
+    template <class Ops, class U>
+    FRYSTL_SIMD_INLINE size_t CountKernel(const U* p, size_t n, U value) noexcept
+    {
+        constexpr size_t W = Ops::Bytes / sizeof(U);
+        const auto key = Ops::template Splat<U>(value);
+        size_t bits = 0;      // sizeof(U) per equal element
+        size_t i = 0;
+        for (; i + W < n; i += W)
+            bits += PopCount(Ops::Mask(Ops::template Equal<U>(Ops::Load(p + i), key)));
+        // The last load overlaps lanes already counted; drop them.
+        uint32_t m = Ops::Mask(Ops::template Equal<U>(Ops::Load(p + n - W), key));
+        bits += PopCount(uint64_t(m) >> ((i + W - n) * sizeof(U)));
+        return bits / sizeof(U);
+    }
+    // Return the number of elements of p[0..n), whose elements are of
+    // type T, that are less than value.
+    template <class Ops, class T, class U>
+    FRYSTL_SIMD_INLINE size_t CountLessKernel(const U* p, size_t n, U value) noexcept
+    {
+        constexpr size_t W = Ops::Bytes / sizeof(U);
+        // Greater() compares as signed; flip the sign bits of unsigned T.
+        const U flip = std::is_signed<T>::value ? U(0) : U(U(1) << (8 * sizeof(U) - 1));
+        const auto bias = Ops::template Splat<U>(flip);
+        const auto key = Ops::template Splat<U>(U(value ^ flip));
+        size_t bits = 0;      // sizeof(U) per lesser element
+        size_t i = 0;
+        for (; i + W < n; i += W) {
+            auto x = Ops::Xor(Ops::Load(p + i), bias);
+            bits += PopCount(Ops::Mask(Ops::template Greater<U>(key, x)));
+        }
+        auto x = Ops::Xor(Ops::Load(p + n - W), bias);
+        uint32_t m = Ops::Mask(Ops::template Greater<U>(key, x));
+        bits += PopCount(uint64_t(m) >> ((i + W - n) * sizeof(U)));
+        return bits / sizeof(U);
+    }
+    // Return the least (if Greatest is false) or greatest element of
+    // p[0..n), whose elements are of type T.  Requires
+    // Ops::HasMinMax<U>.
+    template <class Ops, class T, bool Greatest, class U>
+    FRYSTL_SIMD_INLINE T ExtremeKernel(const U* p, size_t n) noexcept
+    {
+        constexpr size_t W = Ops::Bytes / sizeof(U);
+        // Flip the sign bits if the lanes compare with the wrong signedness.
+        const U flip = std::is_signed<T>::value != Ops::template SignedMinMax<U>
+            ? U(U(1) << (8 * sizeof(U) - 1)) : U(0);
+        const auto bias = Ops::template Splat<U>(flip);
+        auto acc = Ops::Xor(Ops::Load(p), bias);
+        for (size_t i = W; i < n; i += W) {
+            auto x = Ops::Xor(Ops::Load(p + std::min(i, n - W)), bias);
+            acc = Greatest ? Ops::template Max<U>(acc, x) : Ops::template Min<U>(acc, x);
+        }
+        U lanes[W];
+        Ops::Store(lanes, acc);
+        T result = T(U(lanes[0] ^ flip));
+        for (size_t j = 1; j < W; ++j) {
+            T x = T(U(lanes[j] ^ flip));
+            if (Greatest ? result < x : x < result)
+                result = x;
+        }
+        return result;
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif  // def FRYSTL_SIMD_SSE2
+#ifdef FRYSTL_SIMD_AVX2
+    template <class U>
+    FRYSTL_TARGET_AVX2 size_t FindAvx2(const U* p, size_t n, U value) noexcept
+    {
+        return FindKernel<Avx2Ops>(p, n, value);
+    }
+    template <class U>
+    FRYSTL_TARGET_AVX2 size_t CountAvx2(const U* p, size_t n, U value) noexcept
+    {
+        return CountKernel<Avx2Ops>(p, n, value);
+    }
+    template <class T, class U>
+    FRYSTL_TARGET_AVX2 size_t CountLessAvx2(const U* p, size_t n, U value) noexcept
+    {
+        return CountLessKernel<Avx2Ops, T>(p, n, value);
+    }
+    template <class T, bool Greatest, class U>
+    FRYSTL_TARGET_AVX2 T ExtremeAvx2(const U* p, size_t n) noexcept
+    {
+        return ExtremeKernel<Avx2Ops, T, Greatest>(p, n);
+    }
+#endif  // def FRYSTL_SIMD_AVX2
+
+    // Return the index of the first element of p[0..n) equal to value,
+    // or n if there is none.
+    template <class T>
+    size_t SimdFind(const T* p, size_t n, T value) noexcept
+    {
+        static_assert(SimdSearchable<T>, "SimdFind() requires a small integer type");
+        using U = std::make_unsigned_t<T>;
+        [[maybe_unused]] const U* q = reinterpret_cast<const U*>(p);
+#ifdef FRYSTL_SIMD_AVX2
+        if (n >= Avx2Ops::Bytes / sizeof(T) && HasAvx2())
+            return FindAvx2(q, n, U(value));
+#endif
+#ifdef FRYSTL_SIMD_SSE2
+        if (n >= Sse2Ops::Bytes / sizeof(T))
+            return FindKernel<Sse2Ops>(q, n, U(value));
+#endif
+        return std::find(p, p + n, value) - p;
+    }
+    // Return the number of elements of p[0..n) equal to value.
+    template <class T>
+    size_t SimdCount(const T* p, size_t n, T value) noexcept
+    {
+        static_assert(SimdSearchable<T>, "SimdCount() requires a small integer type");
+        using U = std::make_unsigned_t<T>;
+        [[maybe_unused]] const U* q = reinterpret_cast<const U*>(p);
+#ifdef FRYSTL_SIMD_AVX2
+        if (n >= Avx2Ops::Bytes / sizeof(T) && HasAvx2())
+            return CountAvx2(q, n, U(value));
+#endif
+#ifdef FRYSTL_SIMD_SSE2
+        if (n >= Sse2Ops::Bytes / sizeof(T))
+            return CountKernel<Sse2Ops>(q, n, U(value));
+#endif
+        return std::count(p, p + n, value);
+    }
+    // Return the number of elements of p[0..n) less than value.  If
+    // p[0..n) is sorted, that is the index of its lower bound.
+    template <class T>
+    size_t SimdCountLess(const T* p, size_t n, T value) noexcept
+    {
+        static_assert(SimdSearchable<T>, "SimdCountLess() requires a small integer type");
+        using U = std::make_unsigned_t<T>;
+        [[maybe_unused]] const U* q = reinterpret_cast<const U*>(p);
+#ifdef FRYSTL_SIMD_AVX2
+        if (n >= Avx2Ops::Bytes / sizeof(T) && HasAvx2())
+            return CountLessAvx2<T>(q, n, U(value));
+#endif
+#ifdef FRYSTL_SIMD_SSE2
+        if (n >= Sse2Ops::Bytes / sizeof(T))
+            return CountLessKernel<Sse2Ops, T>(q, n, U(value));
+#endif
+        return std::count_if(p, p + n, [value](T x) { return x < value; });
+    }
+    // Return the index of the first least (if Greatest is false) or
+    // greatest element of p[0..n), or n if n is 0.
+    template <bool Greatest, class T>
+    size_t SimdExtreme(const T* p, size_t n) noexcept
+    {
+        static_assert(SimdSearchable<T>, "SimdExtreme() requires a small integer type");
+        using U = std::make_unsigned_t<T>;
+        [[maybe_unused]] const U* q = reinterpret_cast<const U*>(p);
+#ifdef FRYSTL_SIMD_AVX2
+        if (n >= Avx2Ops::Bytes / sizeof(T) && HasAvx2())
+            return FindAvx2(q, n, U(ExtremeAvx2<T, Greatest>(q, n)));
+#endif
+#ifdef FRYSTL_SIMD_SSE2
+        if constexpr (Sse2Ops::HasMinMax<U>) {
+            if (n >= Sse2Ops::Bytes / sizeof(T))
+                return FindKernel<Sse2Ops>(q, n,
+                    U(ExtremeKernel<Sse2Ops, T, Greatest>(q, n)));
+        }
+#endif
+        if (Greatest)
+            return std::max_element(p, p + n) - p;
+        else
+            return std::min_element(p, p + n) - p;
+    }
+}   // namespace frystl
+
+#endif  // ndef FRYSTL_SIMD_H
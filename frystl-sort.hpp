@@ -0,0 +1,421 @@
+// frystl-sort.hpp - sorting networks for small_sort()
+//
+// A sorting network sorts a fixed number of elements with a fixed
+// sequence of compare-exchanges, so it has no loop overhead, and when
+// the elements are small trivially copyable values each compare-
+// exchange compiles to a pair of conditional moves instead of an
+// unpredictable branch.  SortNetwork<N>::Sort() sorts N elements with
+// a network of the fewest known compare-exchanges for N, for N from 2
+// to 16: 1, 3, 5, 9, 12, 16, 19, 25, 29, 35, 39, 45, 51, 56 and 60,
+// proved optimal through N = 12.  Each statement group below is a
+// layer of independent compare-exchanges.  The networks were checked
+// with the 0-1 principle.  They are not stable.
+//
+// SmallSort<MaxN>() switches on the runtime count to the network for
+// that count, instantiating only those up to MaxN, and insertion
+// sorts counts past 16.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_SORT_H
+#define FRYSTL_SORT_H
+
+#include <cstdint>      // uint32_t
+#include <type_traits>  // is_trivially_copyable
+#include <utility>      // move, swap
+
+namespace frystl
+{
+    // Put the lesser of a and b by comp in a and the greater in b.
+    template <class T, class Compare>
+    inline void CompareExchange(T &a, T &b, Compare &comp)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value && sizeof(T) <= 2 * sizeof(void *)) {
+            T x = a;
+            T y = b;
+            bool swap = comp(y, x);
+            a = swap ? y : x;
+            b = swap ? x : y;
+        }
+        else if (comp(b, a)) {
+            using std::swap;
+            swap(a, b);
+        }
+    }
+    // Sort a[0..n) by comp, moving each element back past the greater
+    // ones before it.
+    template <class T, class Compare>
+    void InsertionSort(T *a, uint32_t n, Compare &comp)
+    {
+        for (uint32_t i = 1; i < n; ++i) {
+            if (!comp(a[i], a[i - 1]))
+                continue;
+            T x = std::move(a[i]);
+            uint32_t j = i;
+            do {
+                a[j] = std::move(a[j - 1]);
+                --j;
+            } while (j > 0 && comp(x, a[j - 1]));
+            a[j] = std::move(x);
+        }
+    }
+
+    template <unsigned N>
+    struct SortNetwork;
+
+#define FRYSTL_CX(i, j) CompareExchange(a[i], a[j], comp)
+    template <>
+    struct SortNetwork<2>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 1);
+        }
+    };
+    template <>
+    struct SortNetwork<3>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 2);
+            FRYSTL_CX(0, 1);
+            FRYSTL_CX(1, 2);
+        }
+    };
+    template <>
+    struct SortNetwork<4>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 3);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 3);
+            FRYSTL_CX(1, 2);
+        }
+    };
+    template <>
+    struct SortNetwork<5>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 3); FRYSTL_CX(1, 4);
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 3);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 4);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 4);
+            FRYSTL_CX(2, 3);
+        }
+    };
+    template <>
+    struct SortNetwork<6>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 5); FRYSTL_CX(1, 3); FRYSTL_CX(2, 4);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 4);
+            FRYSTL_CX(0, 3); FRYSTL_CX(2, 5);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 3); FRYSTL_CX(4, 5);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 4);
+        }
+    };
+    template <>
+    struct SortNetwork<7>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 6); FRYSTL_CX(2, 3); FRYSTL_CX(4, 5);
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 4); FRYSTL_CX(3, 6);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 5); FRYSTL_CX(3, 4);
+            FRYSTL_CX(1, 2); FRYSTL_CX(4, 6);
+            FRYSTL_CX(2, 3); FRYSTL_CX(4, 5);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 4); FRYSTL_CX(5, 6);
+        }
+    };
+    template <>
+    struct SortNetwork<8>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 3); FRYSTL_CX(4, 6); FRYSTL_CX(5, 7);
+            FRYSTL_CX(0, 4); FRYSTL_CX(1, 5); FRYSTL_CX(2, 6); FRYSTL_CX(3, 7);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 3); FRYSTL_CX(4, 5); FRYSTL_CX(6, 7);
+            FRYSTL_CX(2, 4); FRYSTL_CX(3, 5);
+            FRYSTL_CX(1, 4); FRYSTL_CX(3, 6);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 4); FRYSTL_CX(5, 6);
+        }
+    };
+    template <>
+    struct SortNetwork<9>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 3); FRYSTL_CX(1, 7); FRYSTL_CX(2, 5); FRYSTL_CX(4, 8);
+            FRYSTL_CX(0, 7); FRYSTL_CX(2, 4); FRYSTL_CX(3, 8); FRYSTL_CX(5, 6);
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 3); FRYSTL_CX(4, 5); FRYSTL_CX(7, 8);
+            FRYSTL_CX(1, 4); FRYSTL_CX(3, 6); FRYSTL_CX(5, 7);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 4); FRYSTL_CX(3, 5); FRYSTL_CX(6, 8);
+            FRYSTL_CX(2, 3); FRYSTL_CX(4, 5); FRYSTL_CX(6, 7);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 4); FRYSTL_CX(5, 6);
+        }
+    };
+    template <>
+    struct SortNetwork<10>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 8); FRYSTL_CX(1, 9); FRYSTL_CX(2, 7); FRYSTL_CX(3, 5);
+                FRYSTL_CX(4, 6);
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 4); FRYSTL_CX(5, 8); FRYSTL_CX(7, 9);
+            FRYSTL_CX(0, 3); FRYSTL_CX(2, 4); FRYSTL_CX(5, 7); FRYSTL_CX(6, 9);
+            FRYSTL_CX(0, 1); FRYSTL_CX(3, 6); FRYSTL_CX(8, 9);
+            FRYSTL_CX(1, 5); FRYSTL_CX(2, 3); FRYSTL_CX(4, 8); FRYSTL_CX(6, 7);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 5); FRYSTL_CX(4, 6); FRYSTL_CX(7, 8);
+            FRYSTL_CX(2, 3); FRYSTL_CX(4, 5); FRYSTL_CX(6, 7);
+            FRYSTL_CX(3, 4); FRYSTL_CX(5, 6);
+        }
+    };
+    template <>
+    struct SortNetwork<11>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 9); FRYSTL_CX(1, 6); FRYSTL_CX(2, 4); FRYSTL_CX(3, 7);
+                FRYSTL_CX(5, 8);
+            FRYSTL_CX(0, 1); FRYSTL_CX(3, 5); FRYSTL_CX(4, 10); FRYSTL_CX(6, 9);
+                FRYSTL_CX(7, 8);
+            FRYSTL_CX(1, 3); FRYSTL_CX(2, 5); FRYSTL_CX(4, 7); FRYSTL_CX(8, 10);
+            FRYSTL_CX(0, 4); FRYSTL_CX(1, 2); FRYSTL_CX(3, 7); FRYSTL_CX(5, 9);
+                FRYSTL_CX(6, 8);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 6); FRYSTL_CX(4, 5); FRYSTL_CX(7, 8);
+                FRYSTL_CX(9, 10);
+            FRYSTL_CX(2, 4); FRYSTL_CX(3, 6); FRYSTL_CX(5, 7); FRYSTL_CX(8, 9);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 4); FRYSTL_CX(5, 6); FRYSTL_CX(7, 8);
+            FRYSTL_CX(2, 3); FRYSTL_CX(4, 5); FRYSTL_CX(6, 7);
+        }
+    };
+    template <>
+    struct SortNetwork<12>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 8); FRYSTL_CX(1, 7); FRYSTL_CX(2, 6); FRYSTL_CX(3, 11);
+                FRYSTL_CX(4, 10); FRYSTL_CX(5, 9);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 5); FRYSTL_CX(3, 4); FRYSTL_CX(6, 9);
+                FRYSTL_CX(7, 8); FRYSTL_CX(10, 11);
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 6); FRYSTL_CX(5, 10); FRYSTL_CX(9, 11);
+            FRYSTL_CX(0, 3); FRYSTL_CX(1, 2); FRYSTL_CX(4, 6); FRYSTL_CX(5, 7);
+                FRYSTL_CX(8, 11); FRYSTL_CX(9, 10);
+            FRYSTL_CX(1, 4); FRYSTL_CX(3, 5); FRYSTL_CX(6, 8); FRYSTL_CX(7, 10);
+            FRYSTL_CX(1, 3); FRYSTL_CX(2, 5); FRYSTL_CX(6, 9); FRYSTL_CX(8, 10);
+            FRYSTL_CX(2, 3); FRYSTL_CX(4, 5); FRYSTL_CX(6, 7); FRYSTL_CX(8, 9);
+            FRYSTL_CX(4, 6); FRYSTL_CX(5, 7);
+            FRYSTL_CX(3, 4); FRYSTL_CX(5, 6); FRYSTL_CX(7, 8);
+        }
+    };
+    template <>
+    struct SortNetwork<13>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 12); FRYSTL_CX(1, 10); FRYSTL_CX(2, 9); FRYSTL_CX(3, 7);
+                FRYSTL_CX(5, 11); FRYSTL_CX(6, 8);
+            FRYSTL_CX(1, 6); FRYSTL_CX(2, 3); FRYSTL_CX(4, 11); FRYSTL_CX(7, 9);
+                FRYSTL_CX(8, 10);
+            FRYSTL_CX(0, 4); FRYSTL_CX(1, 2); FRYSTL_CX(3, 6); FRYSTL_CX(7, 8);
+                FRYSTL_CX(9, 10); FRYSTL_CX(11, 12);
+            FRYSTL_CX(4, 6); FRYSTL_CX(5, 9); FRYSTL_CX(8, 11); FRYSTL_CX(10, 12);
+            FRYSTL_CX(0, 5); FRYSTL_CX(3, 8); FRYSTL_CX(4, 7); FRYSTL_CX(6, 11);
+                FRYSTL_CX(9, 10);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 5); FRYSTL_CX(6, 9); FRYSTL_CX(7, 8);
+                FRYSTL_CX(10, 11);
+            FRYSTL_CX(1, 3); FRYSTL_CX(2, 4); FRYSTL_CX(5, 6); FRYSTL_CX(9, 10);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 4); FRYSTL_CX(5, 7); FRYSTL_CX(6, 8);
+            FRYSTL_CX(2, 3); FRYSTL_CX(4, 5); FRYSTL_CX(6, 7); FRYSTL_CX(8, 9);
+            FRYSTL_CX(3, 4); FRYSTL_CX(5, 6);
+        }
+    };
+    template <>
+    struct SortNetwork<14>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 3); FRYSTL_CX(4, 5); FRYSTL_CX(6, 7);
+                FRYSTL_CX(8, 9); FRYSTL_CX(10, 11); FRYSTL_CX(12, 13);
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 3); FRYSTL_CX(4, 8); FRYSTL_CX(5, 9);
+                FRYSTL_CX(10, 12); FRYSTL_CX(11, 13);
+            FRYSTL_CX(0, 4); FRYSTL_CX(1, 2); FRYSTL_CX(3, 7); FRYSTL_CX(5, 8);
+                FRYSTL_CX(6, 10); FRYSTL_CX(9, 13); FRYSTL_CX(11, 12);
+            FRYSTL_CX(0, 6); FRYSTL_CX(1, 5); FRYSTL_CX(3, 9); FRYSTL_CX(4, 10);
+                FRYSTL_CX(7, 13); FRYSTL_CX(8, 12);
+            FRYSTL_CX(2, 10); FRYSTL_CX(3, 11); FRYSTL_CX(4, 6); FRYSTL_CX(7, 9);
+            FRYSTL_CX(1, 3); FRYSTL_CX(2, 8); FRYSTL_CX(5, 11); FRYSTL_CX(6, 7);
+                FRYSTL_CX(10, 12);
+            FRYSTL_CX(1, 4); FRYSTL_CX(2, 6); FRYSTL_CX(3, 5); FRYSTL_CX(7, 11);
+                FRYSTL_CX(8, 10); FRYSTL_CX(9, 12);
+            FRYSTL_CX(2, 4); FRYSTL_CX(3, 6); FRYSTL_CX(5, 8); FRYSTL_CX(7, 10);
+                FRYSTL_CX(9, 11);
+            FRYSTL_CX(3, 4); FRYSTL_CX(5, 6); FRYSTL_CX(7, 8); FRYSTL_CX(9, 10);
+            FRYSTL_CX(6, 7);
+        }
+    };
+    template <>
+    struct SortNetwork<15>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 13); FRYSTL_CX(1, 12); FRYSTL_CX(3, 14); FRYSTL_CX(4, 8);
+                FRYSTL_CX(5, 6); FRYSTL_CX(7, 11); FRYSTL_CX(9, 10);
+            FRYSTL_CX(0, 5); FRYSTL_CX(1, 7); FRYSTL_CX(2, 9); FRYSTL_CX(3, 4);
+                FRYSTL_CX(6, 13); FRYSTL_CX(8, 14); FRYSTL_CX(11, 12);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 3); FRYSTL_CX(4, 5); FRYSTL_CX(6, 8);
+                FRYSTL_CX(7, 9); FRYSTL_CX(10, 11); FRYSTL_CX(12, 13);
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 3); FRYSTL_CX(4, 10); FRYSTL_CX(5, 11);
+                FRYSTL_CX(6, 7); FRYSTL_CX(8, 9); FRYSTL_CX(12, 14);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 12); FRYSTL_CX(4, 6); FRYSTL_CX(5, 7);
+                FRYSTL_CX(8, 10); FRYSTL_CX(9, 11); FRYSTL_CX(13, 14);
+            FRYSTL_CX(1, 4); FRYSTL_CX(2, 6); FRYSTL_CX(5, 8); FRYSTL_CX(7, 10);
+                FRYSTL_CX(9, 13); FRYSTL_CX(11, 14);
+            FRYSTL_CX(2, 4); FRYSTL_CX(3, 6); FRYSTL_CX(9, 12); FRYSTL_CX(11, 13);
+            FRYSTL_CX(3, 5); FRYSTL_CX(6, 8); FRYSTL_CX(7, 9); FRYSTL_CX(10, 12);
+            FRYSTL_CX(3, 4); FRYSTL_CX(5, 6); FRYSTL_CX(7, 8); FRYSTL_CX(9, 10);
+                FRYSTL_CX(11, 12);
+            FRYSTL_CX(6, 7); FRYSTL_CX(8, 9);
+        }
+    };
+    template <>
+    struct SortNetwork<16>
+    {
+        template <class T, class Compare>
+        static void Sort(T *a, Compare &comp)
+        {
+            FRYSTL_CX(0, 13); FRYSTL_CX(1, 12); FRYSTL_CX(2, 15); FRYSTL_CX(3, 14);
+                FRYSTL_CX(4, 8); FRYSTL_CX(5, 6); FRYSTL_CX(7, 11); FRYSTL_CX(9, 10);
+            FRYSTL_CX(0, 5); FRYSTL_CX(1, 7); FRYSTL_CX(2, 9); FRYSTL_CX(3, 4);
+                FRYSTL_CX(6, 13); FRYSTL_CX(8, 14); FRYSTL_CX(10, 15);
+                FRYSTL_CX(11, 12);
+            FRYSTL_CX(0, 1); FRYSTL_CX(2, 3); FRYSTL_CX(4, 5); FRYSTL_CX(6, 8);
+                FRYSTL_CX(7, 9); FRYSTL_CX(10, 11); FRYSTL_CX(12, 13);
+                FRYSTL_CX(14, 15);
+            FRYSTL_CX(0, 2); FRYSTL_CX(1, 3); FRYSTL_CX(4, 10); FRYSTL_CX(5, 11);
+                FRYSTL_CX(6, 7); FRYSTL_CX(8, 9); FRYSTL_CX(12, 14); FRYSTL_CX(13, 15);
+            FRYSTL_CX(1, 2); FRYSTL_CX(3, 12); FRYSTL_CX(4, 6); FRYSTL_CX(5, 7);
+                FRYSTL_CX(8, 10); FRYSTL_CX(9, 11); FRYSTL_CX(13, 14);
+            FRYSTL_CX(1, 4); FRYSTL_CX(2, 6); FRYSTL_CX(5, 8); FRYSTL_CX(7, 10);
+                FRYSTL_CX(9, 13); FRYSTL_CX(11, 14);
+            FRYSTL_CX(2, 4); FRYSTL_CX(3, 6); FRYSTL_CX(9, 12); FRYSTL_CX(11, 13);
+            FRYSTL_CX(3, 5); FRYSTL_CX(6, 8); FRYSTL_CX(7, 9); FRYSTL_CX(10, 12);
+            FRYSTL_CX(3, 4); FRYSTL_CX(5, 6); FRYSTL_CX(7, 8); FRYSTL_CX(9, 10);
+                FRYSTL_CX(11, 12);
+            FRYSTL_CX(6, 7); FRYSTL_CX(8, 9);
+        }
+    };
+#undef FRYSTL_CX
+
+    // Sort a[0..n) by comp, with the network for n if n <= MaxN.
+    template <unsigned MaxN, class T, class Compare>
+    void SmallSort(T *a, uint32_t n, Compare &comp)
+    {
+        switch (n) {
+        case 0:
+        case 1:
+            return;
+        case 2:
+            if constexpr (MaxN >= 2)
+                return SortNetwork<2>::Sort(a, comp);
+            break;
+        case 3:
+            if constexpr (MaxN >= 3)
+                return SortNetwork<3>::Sort(a, comp);
+            break;
+        case 4:
+            if constexpr (MaxN >= 4)
+                return SortNetwork<4>::Sort(a, comp);
+            break;
+        case 5:
+            if constexpr (MaxN >= 5)
+                return SortNetwork<5>::Sort(a, comp);
+            break;
+        case 6:
+            if constexpr (MaxN >= 6)
+                return SortNetwork<6>::Sort(a, comp);
+            break;
+        case 7:
+            if constexpr (MaxN >= 7)
+                return SortNetwork<7>::Sort(a, comp);
+            break;
+        case 8:
+            if constexpr (MaxN >= 8)
+                return SortNetwork<8>::Sort(a, comp);
+            break;
+        case 9:
+            if constexpr (MaxN >= 9)
+                return SortNetwork<9>::Sort(a, comp);
+            break;
+        case 10:
+            if constexpr (MaxN >= 10)
+                return SortNetwork<10>::Sort(a, comp);
+            break;
+        case 11:
+            if constexpr (MaxN >= 11)
+                return SortNetwork<11>::Sort(a, comp);
+            break;
+        case 12:
+            if constexpr (MaxN >= 12)
+                return SortNetwork<12>::Sort(a, comp);
+            break;
+        case 13:
+            if constexpr (MaxN >= 13)
+                return SortNetwork<13>::Sort(a, comp);
+            break;
+        case 14:
+            if constexpr (MaxN >= 14)
+                return SortNetwork<14>::Sort(a, comp);
+            break;
+        case 15:
+            if constexpr (MaxN >= 15)
+                return SortNetwork<15>::Sort(a, comp);
+            break;
+        case 16:
+            if constexpr (MaxN >= 16)
+                return SortNetwork<16>::Sort(a, comp);
+            break;
+        default:
+            break;
+        }
+        InsertionSort(a, n, comp);
+    }
+}   // namespace frystl
+
+#endif  // ndef FRYSTL_SORT_H
@@ -0,0 +1,303 @@
+// Template class hashed_static_vector
+//
+// hashed_static_vector<T,Capacity,Hash> is a static_vector<T,Capacity>
+// that keeps a hash of its contents up to date as it is changed, so
+// that hash() takes constant time.  The hash is the exclusive or of one
+// Zobrist-style key per element, made by mixing Hash()(element) with
+// the element's index.  Adding or removing an element at the back
+// therefore costs one key; inserting or erasing at position p costs one
+// key for each element at or after p, since those elements move.
+//
+// The elements can be read through the const part of the static_vector
+// API, or through vector(), but they can be changed only through the
+// member functions here, which keep the hash current: push_back(),
+// emplace_back(), pop_back(), insert(), emplace(), erase(), replace(),
+// clear(), and assignment.  Iterators are const_iterators.
+//
+// Equal hashed_static_vectors have equal hashes.  The hash is the same
+// however the contents were reached, but it is not the hash that
+// std::hash<static_vector<T,Capacity>> computes.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_HASHED_STATIC_VECTOR
+#define FRYSTL_HASHED_STATIC_VECTOR
+#include <cstdint>      // uint64_t
+#include <functional>   // hash
+#include <initializer_list>
+#include <utility>      // forward, move
+#include "static_vector.hpp"
+#include "frystl-hash.hpp"
+
+namespace frystl
+{
+    template <class T, unsigned Capacity, class Hash = std::hash<T>>
+    class hashed_static_vector
+    {
+    public:
+        using this_type = hashed_static_vector<T, Capacity, Hash>;
+        using vector_type = static_vector<T, Capacity>;
+        using value_type = T;
+        using size_type = typename vector_type::size_type;
+        using difference_type = typename vector_type::difference_type;
+        using reference = typename vector_type::const_reference;
+        using const_reference = typename vector_type::const_reference;
+        using pointer = typename vector_type::const_pointer;
+        using const_pointer = typename vector_type::const_pointer;
+        using iterator = typename vector_type::const_iterator;
+        using const_iterator = typename vector_type::const_iterator;
+        using reverse_iterator = typename vector_type::const_reverse_iterator;
+        using const_reverse_iterator = typename vector_type::const_reverse_iterator;
+        //
+        //******* Public member functions:
+        //
+        hashed_static_vector() noexcept
+            : _hash(0)
+        {}
+        hashed_static_vector(size_type n, const_reference value)
+            : _vec(n, value)
+            , _hash(KeysFrom(0))
+        {}
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        hashed_static_vector(InputIterator begin, InputIterator end)
+            : _vec(begin, end)
+            , _hash(KeysFrom(0))
+        {}
+        hashed_static_vector(std::initializer_list<value_type> il)
+            : _vec(il)
+            , _hash(KeysFrom(0))
+        {}
+        explicit hashed_static_vector(const vector_type &v)
+            : _vec(v)
+            , _hash(KeysFrom(0))
+        {}
+        explicit hashed_static_vector(vector_type &&v)
+            : _vec(std::move(v))
+            , _hash(KeysFrom(0))
+        {}
+        this_type &operator=(const vector_type &v)
+        {
+            _vec = v;
+            _hash = KeysFrom(0);
+            return *this;
+        }
+        this_type &operator=(std::initializer_list<value_type> il)
+        {
+            _vec = il;
+            _hash = KeysFrom(0);
+            return *this;
+        }
+        //
+        //  Hash
+        //
+        uint64_t hash() const noexcept { return _hash; }
+        //
+        //  Element access
+        //
+        const vector_type &vector() const noexcept { return _vec; }
+        const_reference operator[](size_type i) const noexcept { return _vec[i]; }
+        const_reference at(size_type i) const { return _vec.at(i); }
+        const_reference front() const noexcept { return _vec.front(); }
+        const_reference back() const noexcept { return _vec.back(); }
+        const_pointer data() const noexcept { return _vec.data(); }
+        //
+        //  Iterators
+        //
+        const_iterator begin() const noexcept { return _vec.begin(); }
+        const_iterator end() const noexcept { return _vec.end(); }
+        const_iterator cbegin() const noexcept { return _vec.cbegin(); }
+        const_iterator cend() const noexcept { return _vec.cend(); }
+        const_reverse_iterator rbegin() const noexcept { return _vec.rbegin(); }
+        const_reverse_iterator rend() const noexcept { return _vec.rend(); }
+        const_reverse_iterator crbegin() const noexcept { return _vec.crbegin(); }
+        const_reverse_iterator crend() const noexcept { return _vec.crend(); }
+        //
+        //  Capacity
+        //
+        size_type size() const noexcept { return _vec.size(); }
+        bool empty() const noexcept { return _vec.empty(); }
+        constexpr size_type capacity() const noexcept { return Capacity; }
+        constexpr size_type max_size() const noexcept { return Capacity; }
+        //
+        //  Modifiers
+        //
+        template <class... Args>
+        const_reference emplace_back(Args &&... args)
+        {
+            const_reference result = _vec.emplace_back(std::forward<Args>(args)...);
+            _hash ^= Key(size() - 1, result);
+            return result;
+        }
+        void push_back(const value_type &value) { emplace_back(value); }
+        void push_back(value_type &&value) { emplace_back(std::move(value)); }
+        void pop_back() noexcept
+        {
+            _hash ^= Key(size() - 1, back());
+            _vec.pop_back();
+        }
+        void clear() noexcept
+        {
+            _vec.clear();
+            _hash = 0;
+        }
+        // Replace the element at position with value.
+        void replace(const_iterator position, const value_type &value)
+        {
+            size_type i = position - begin();
+            value_type &elem = _vec[i];
+            uint64_t oldKey = Key(i, elem);
+            try {
+                elem = value;
+            }
+            catch (...) {
+                // The assignment may have changed elem.
+                _hash ^= oldKey ^ Key(i, elem);
+                throw;
+            }
+            _hash ^= oldKey ^ Key(i, elem);
+        }
+        template <class... Args>
+        const_iterator emplace(const_iterator position, Args &&... args)
+        {
+            size_type i = position - begin();
+            ChangeFrom(i, [&] { _vec.emplace(position, std::forward<Args>(args)...); });
+            return begin() + i;
+        }
+        const_iterator insert(const_iterator position, const value_type &value)
+        {
+            return emplace(position, value);
+        }
+        const_iterator insert(const_iterator position, value_type &&value)
+        {
+            return emplace(position, std::move(value));
+        }
+        const_iterator insert(const_iterator position, size_type n, const value_type &value)
+        {
+            size_type i = position - begin();
+            ChangeFrom(i, [&] { _vec.insert(position, n, value); });
+            return begin() + i;
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        const_iterator insert(const_iterator position, InputIterator first, InputIterator last)
+        {
+            size_type i = position - begin();
+            ChangeFrom(i, [&] { _vec.insert(position, first, last); });
+            return begin() + i;
+        }
+        const_iterator insert(const_iterator position, std::initializer_list<value_type> il)
+        {
+            return insert(position, il.begin(), il.end());
+        }
+        const_iterator erase(const_iterator position)
+        {
+            return erase(position, position + 1);
+        }
+        const_iterator erase(const_iterator first, const_iterator last)
+        {
+            size_type i = first - begin();
+            ChangeFrom(i, [&] { _vec.erase(first, last); });
+            return begin() + i;
+        }
+        void swap(this_type &other) noexcept
+        {
+            _vec.swap(other._vec);
+            std::swap(_hash, other._hash);
+        }
+
+    private:
+        vector_type _vec;
+        uint64_t _hash;
+
+        // The key of value at index i
+        static uint64_t Key(size_type i, const value_type &value)
+        {
+            return HashMix(uint64_t(Hash()(value)) ^ HashK1, (uint64_t(i) + 1) * HashK2);
+        }
+        // The exclusive or of the keys of the elements at index i and after
+        uint64_t KeysFrom(size_type i) const
+        {
+            uint64_t keys = 0;
+            for (size_type n = size(); i < n; ++i)
+                keys ^= Key(i, _vec[i]);
+            return keys;
+        }
+        // Call change(), which changes only the elements at index i and
+        // after, and update the hash.  If change() throws after changing
+        // some of them, the hash still matches the elements.
+        template <class Change>
+        void ChangeFrom(size_type i, Change change)
+        {
+            uint64_t oldKeys = KeysFrom(i);
+            try {
+                change();
+            }
+            catch (...) {
+                _hash ^= oldKeys ^ KeysFrom(i);
+                throw;
+            }
+            _hash ^= oldKeys ^ KeysFrom(i);
+        }
+    };
+    //
+    //*******  Non-member overloads
+    //
+    template <class T, unsigned C0, unsigned C1, class Hash>
+    bool operator==(const hashed_static_vector<T, C0, Hash> &lhs,
+        const hashed_static_vector<T, C1, Hash> &rhs)
+    {
+        return lhs.hash() == rhs.hash() && lhs.vector() == rhs.vector();
+    }
+    template <class T, unsigned C0, unsigned C1, class Hash>
+    bool operator!=(const hashed_static_vector<T, C0, Hash> &lhs,
+        const hashed_static_vector<T, C1, Hash> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class T, unsigned C0, unsigned C1, class Hash>
+    bool operator<(const hashed_static_vector<T, C0, Hash> &lhs,
+        const hashed_static_vector<T, C1, Hash> &rhs)
+    {
+        return lhs.vector() < rhs.vector();
+    }
+    template <class T, unsigned C, class Hash>
+    void swap(hashed_static_vector<T, C, Hash> &a, hashed_static_vector<T, C, Hash> &b) noexcept
+    {
+        a.swap(b);
+    }
+}       // namespace frystl
+
+namespace std
+{
+    // The running hash of a hashed_static_vector
+    template <class T, unsigned C, class Hash>
+    struct hash<frystl::hashed_static_vector<T, C, Hash>>
+    {
+        size_t operator()(const frystl::hashed_static_vector<T, C, Hash> &v) const noexcept
+        {
+            return size_t(v.hash());
+        }
+    };
+}       // namespace std
+#endif  // ndef FRYSTL_HASHED_STATIC_VECTOR
@@ -0,0 +1,391 @@
+// Template class journaled_sequence
+//
+// journaled_sequence<Sequence,JournalCapacity> is a static_vector or
+// static_deque that can record its changes in a journal and undo them,
+// as a backtracking search undoes its moves.  checkpoint() starts
+// recording, if it has not started, and returns a token; rollback(token)
+// undoes every change made since checkpoint() returned the token.
+// Checkpoints nest: rolling back to one token leaves the earlier tokens
+// valid.  commit() discards the journal and stops recording.
+//
+// The journal holds a small record for each change, and a copy of each
+// element a change overwrote or removed, so rolling back takes time
+// proportional to the changes undone, not to the size of the sequence.
+// Both parts are static_vectors of JournalCapacity entries.  Filling
+// either fails an assertion if FRYSTL_DEBUG is defined and is undefined
+// behavior otherwise, so JournalCapacity must cover the changes made
+// between commits.  Erasing or clearing n elements takes n entries.
+//
+// journaled_static_vector<T,Capacity,JournalCapacity> and
+// journaled_static_deque<T,Capacity,JournalCapacity> name the two
+// sequences.  JournalCapacity defaults to Capacity.
+//
+// As in hashed_static_vector, the elements can be read through the
+// const part of the sequence's API, or through sequence(), but they can
+// be changed only through the member functions here, which record the
+// changes: push_back(), emplace_back(), pop_back(), the same at the
+// front of a deque, replace(), insert(), emplace(), erase(), clear(),
+// and assignment.  Rolling back restores the elements, but a deque may
+// hold them at a different offset in its storage.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_JOURNALED_SEQUENCE
+#define FRYSTL_JOURNALED_SEQUENCE
+#include <cstdint>      // uint8_t, uint32_t
+#include <initializer_list>
+#include <iterator>     // iterator_traits, make_move_iterator
+#include <utility>      // forward, move
+#include "static_vector.hpp"
+#include "static_deque.hpp"
+
+namespace frystl
+{
+    template <class Sequence, unsigned JournalCapacity>
+    class journaled_sequence
+    {
+    public:
+        using this_type = journaled_sequence<Sequence, JournalCapacity>;
+        using sequence_type = Sequence;
+        // static_deque names no value_type
+        using value_type = typename std::iterator_traits<typename Sequence::iterator>::value_type;
+        using size_type = typename Sequence::size_type;
+        using difference_type = typename Sequence::difference_type;
+        using reference = typename Sequence::const_reference;
+        using const_reference = typename Sequence::const_reference;
+        using pointer = typename Sequence::const_pointer;
+        using const_pointer = typename Sequence::const_pointer;
+        using iterator = typename Sequence::const_iterator;
+        using const_iterator = typename Sequence::const_iterator;
+        using reverse_iterator = typename Sequence::const_reverse_iterator;
+        using const_reverse_iterator = typename Sequence::const_reverse_iterator;
+        using checkpoint_type = uint32_t;
+        //
+        //******* Public member functions:
+        //
+        journaled_sequence() noexcept
+            : _journaling(false)
+        {}
+        explicit journaled_sequence(const sequence_type &s)
+            : _seq(s)
+            , _journaling(false)
+        {}
+        explicit journaled_sequence(sequence_type &&s)
+            : _seq(std::move(s))
+            , _journaling(false)
+        {}
+        journaled_sequence(std::initializer_list<value_type> il)
+            : _seq(il)
+            , _journaling(false)
+        {}
+        this_type &operator=(const sequence_type &s)
+        {
+            clear();
+            insert(end(), s.begin(), s.end());
+            return *this;
+        }
+        this_type &operator=(std::initializer_list<value_type> il)
+        {
+            clear();
+            insert(end(), il);
+            return *this;
+        }
+        //
+        //  Journal
+        //
+        // Start recording changes, if not started, and return a token
+        // for the present state.
+        checkpoint_type checkpoint() noexcept
+        {
+            _journaling = true;
+            return _records.size();
+        }
+        // Undo the changes made since checkpoint() returned token.
+        void rollback(checkpoint_type token)
+        {
+            FRYSTL_ASSERT2(token <= _records.size(), "journaled_sequence::rollback(): bad token");
+            while (token < _records.size()) {
+                Undo(_records.back());
+                _records.pop_back();
+            }
+        }
+        // Discard the journal and stop recording.
+        void commit() noexcept
+        {
+            _records.clear();
+            _saved.clear();
+            _journaling = false;
+        }
+        bool journaling() const noexcept { return _journaling; }
+        size_type journal_size() const noexcept { return _records.size(); }
+        //
+        //  Element access
+        //
+        const sequence_type &sequence() const noexcept { return _seq; }
+        const_reference operator[](size_type i) const noexcept { return _seq[i]; }
+        const_reference at(size_type i) const { return _seq.at(i); }
+        const_reference front() const noexcept { return _seq.front(); }
+        const_reference back() const noexcept { return _seq.back(); }
+        const_pointer data() const noexcept { return _seq.data(); }
+        //
+        //  Iterators
+        //
+        const_iterator begin() const noexcept { return _seq.begin(); }
+        const_iterator end() const noexcept { return _seq.end(); }
+        const_iterator cbegin() const noexcept { return _seq.begin(); }
+        const_iterator cend() const noexcept { return _seq.end(); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+        //
+        //  Capacity
+        //
+        size_type size() const noexcept { return _seq.size(); }
+        bool empty() const noexcept { return _seq.empty(); }
+        size_type capacity() const noexcept { return _seq.capacity(); }
+        size_type max_size() const noexcept { return _seq.capacity(); }
+        constexpr size_type journal_capacity() const noexcept { return JournalCapacity; }
+        //
+        //  Modifiers
+        //
+        template <class... Args>
+        const_reference emplace_back(Args &&... args)
+        {
+            _seq.emplace_back(std::forward<Args>(args)...);
+            Record(PushBack);
+            return back();
+        }
+        void push_back(const value_type &value) { emplace_back(value); }
+        void push_back(value_type &&value) { emplace_back(std::move(value)); }
+        void pop_back()
+        {
+            Save(std::move(_seq.back()));
+            _seq.pop_back();
+            Record(PopBack);
+        }
+        // Only a journaled_static_deque has the front operations.
+        template <class... Args>
+        const_reference emplace_front(Args &&... args)
+        {
+            _seq.emplace_front(std::forward<Args>(args)...);
+            Record(PushFront);
+            return front();
+        }
+        void push_front(const value_type &value) { emplace_front(value); }
+        void push_front(value_type &&value) { emplace_front(std::move(value)); }
+        void pop_front()
+        {
+            Save(std::move(_seq.front()));
+            _seq.pop_front();
+            Record(PopFront);
+        }
+        void clear()
+        {
+            if (_journaling)
+                erase(begin(), end());
+            else
+                _seq.clear();
+        }
+        // Replace the element at position with value.
+        void replace(const_iterator position, const value_type &value)
+        {
+            Replace(position, value);
+        }
+        void replace(const_iterator position, value_type &&value)
+        {
+            Replace(position, std::move(value));
+        }
+        template <class... Args>
+        const_iterator emplace(const_iterator position, Args &&... args)
+        {
+            size_type i = position - begin();
+            _seq.emplace(position, std::forward<Args>(args)...);
+            Record(Insert, i, 1);
+            return begin() + i;
+        }
+        const_iterator insert(const_iterator position, const value_type &value)
+        {
+            return emplace(position, value);
+        }
+        const_iterator insert(const_iterator position, value_type &&value)
+        {
+            return emplace(position, std::move(value));
+        }
+        const_iterator insert(const_iterator position, size_type n, const value_type &value)
+        {
+            size_type i = position - begin();
+            _seq.insert(position, n, value);
+            Record(Insert, i, n);
+            return begin() + i;
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        const_iterator insert(const_iterator position, InputIterator first, InputIterator last)
+        {
+            size_type i = position - begin();
+            size_type n = size();
+            _seq.insert(position, first, last);
+            Record(Insert, i, size() - n);
+            return begin() + i;
+        }
+        const_iterator insert(const_iterator position, std::initializer_list<value_type> il)
+        {
+            return insert(position, il.begin(), il.end());
+        }
+        const_iterator erase(const_iterator position)
+        {
+            return erase(position, position + 1);
+        }
+        const_iterator erase(const_iterator first, const_iterator last)
+        {
+            size_type i = first - begin();
+            size_type n = size_type(last - first);
+            if (n == 0)
+                return first;
+            if (_journaling) {
+                for (const_iterator p = first; p != last; ++p)
+                    Save(std::move(_seq[size_type(p - begin())]));
+            }
+            _seq.erase(first, last);
+            Record(Erase, i, n);
+            return begin() + i;
+        }
+        // Swap the elements and the journals.
+        void swap(this_type &other) noexcept
+        {
+            _seq.swap(other._seq);
+            _records.swap(other._records);
+            _saved.swap(other._saved);
+            std::swap(_journaling, other._journaling);
+        }
+
+    private:
+        enum Op : uint8_t { PushBack, PopBack, PushFront, PopFront, Replaced, Insert, Erase };
+        struct Change
+        {
+            Op op;
+            size_type index;
+            size_type count;
+        };
+        sequence_type _seq;
+        static_vector<Change, JournalCapacity> _records;
+        static_vector<value_type, JournalCapacity> _saved;  // overwritten and removed elements
+        bool _journaling;
+
+        void Record(Op op, size_type index = 0, size_type count = 0)
+        {
+            if (_journaling) {
+                FRYSTL_ASSERT2(_records.size() < JournalCapacity,
+                    "journaled_sequence: journal overflow");
+                _records.push_back(Change {op, index, count});
+            }
+        }
+        template <class V>
+        void Save(V &&value)
+        {
+            if (_journaling) {
+                FRYSTL_ASSERT2(_saved.size() < JournalCapacity,
+                    "journaled_sequence: journal overflow");
+                _saved.emplace_back(std::forward<V>(value));
+            }
+        }
+        template <class V>
+        void Replace(const_iterator position, V &&value)
+        {
+            size_type i = position - begin();
+            Save(std::move(_seq[i]));
+            _seq[i] = std::forward<V>(value);
+            Record(Replaced, i);
+        }
+        // Restore the last n saved elements at position i, and forget them.
+        void Restore(size_type i, size_type n)
+        {
+            auto first = _saved.end() - n;
+            _seq.insert(_seq.begin() + i,
+                std::make_move_iterator(first), std::make_move_iterator(_saved.end()));
+            for (; n; --n)
+                _saved.pop_back();
+        }
+        void Undo(const Change &change)
+        {
+            switch (change.op) {
+            case PushBack:
+                _seq.pop_back();
+                break;
+            case PushFront:
+                // Only a deque has pushed at the front, but a vector must
+                // compile this.
+                _seq.erase(_seq.begin());
+                break;
+            case PopBack:
+                _seq.push_back(std::move(_saved.back()));
+                _saved.pop_back();
+                break;
+            case PopFront:
+                _seq.insert(_seq.begin(), std::move(_saved.back()));
+                _saved.pop_back();
+                break;
+            case Replaced:
+                _seq[change.index] = std::move(_saved.back());
+                _saved.pop_back();
+                break;
+            case Insert:
+                _seq.erase(_seq.begin() + change.index,
+                    _seq.begin() + change.index + change.count);
+                break;
+            case Erase:
+                Restore(change.index, change.count);
+                break;
+            }
+        }
+    };
+    template <class T, unsigned Capacity, unsigned JournalCapacity = Capacity>
+    using journaled_static_vector = journaled_sequence<static_vector<T, Capacity>, JournalCapacity>;
+    template <class T, unsigned Capacity, unsigned JournalCapacity = Capacity>
+    using journaled_static_deque = journaled_sequence<static_deque<T, Capacity>, JournalCapacity>;
+    //
+    //*******  Non-member overloads
+    //
+    template <class S, unsigned J0, unsigned J1>
+    bool operator==(const journaled_sequence<S, J0> &lhs, const journaled_sequence<S, J1> &rhs)
+    {
+        return lhs.sequence() == rhs.sequence();
+    }
+    template <class S, unsigned J0, unsigned J1>
+    bool operator!=(const journaled_sequence<S, J0> &lhs, const journaled_sequence<S, J1> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class S, unsigned J0, unsigned J1>
+    bool operator<(const journaled_sequence<S, J0> &lhs, const journaled_sequence<S, J1> &rhs)
+    {
+        return lhs.sequence() < rhs.sequence();
+    }
+    template <class S, unsigned J>
+    void swap(journaled_sequence<S, J> &a, journaled_sequence<S, J> &b) noexcept
+    {
+        a.swap(b);
+    }
+}       // namespace frystl
+#endif  // ndef FRYSTL_JOURNALED_SEQUENCE
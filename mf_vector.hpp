@@ -17,6 +17,13 @@
 //      of blocks to allow space for n elements without further reallocation.
 //      It does not create additional blocks or modify existing blocks.
 //  (3) the function block_size() returns the value of the B parameter.
+//  (4) sort() and stable_sort() member functions and non-member overloads
+//      sort the blocks in parallel and then merge them in parallel.
+//  (5) append_if() and exclusive_scan() member functions and the 
+//      non-member copy_if() and exclusive_scan() work on blocks in
+//      parallel.
+//  (6) radix_sort() member function and non-member overload sort
+//      trivially copyable elements by an unsigned integer key.
 //
 // Performance: Generally similar to std::deque.
 // Adding an element at the end has amortized constant complexity.
@@ -103,9 +110,15 @@ SOFTWARE.
 #include <iterator>  // reverse_iterator
 #include <vector>
 #include <type_traits> // conditional
-#include <algorithm>   // rotate
+#include <algorithm>   // rotate, sort, stable_sort, upper_bound, ..._heap
+#include <functional>  // less, plus
+#include <cstdint>     // uint64_t
+#include <cstring>     // memcpy
+#include <atomic>
 #include <initializer_list>
 #include "frystl-defines.hpp"
+#include "frystl-parallel.hpp"
+#include "frystl-hash.hpp"
 
 namespace frystl
 {
@@ -416,7 +429,7 @@ namespace frystl
         iterator emplace(const_iterator position, Args&&... args)
         {
             iterator pos = MakeRoom(position,1);
-            Construct(pos.operator->(), std::forward<Args>(args)...);
+            FillRoom(pos, 1, [&](pointer q) { Construct(q, std::forward<Args>(args)...); });
             return pos;
         }
         void push_back(const_reference t)
@@ -486,9 +499,19 @@ namespace frystl
             FRYSTL_ASSERT2(!(last < first), "bad args to mf_vector::erase");
             iterator f = MakeIterator(first);
             iterator l = MakeIterator(last);
-            for (iterator it = f; it < l; ++it)
-                Destroy(it._current);
-            std::move(l, end(), f);
+            if (Relocatable) {
+                for (iterator it = f; it < l; ++it)
+                    Destroy(it._current);
+                size_type index = first - cbegin();
+                size_type n = last - first;
+                Relocate(index + n, index, _size - index - n);
+            }
+            else {
+                // move the tail down, then destroy the cells it left
+                iterator e = end();
+                for (iterator it = std::move(l, e, f); it < e; ++it)
+                    Destroy(it._current);
+            }
             _size -= last - first;
 
             Shrink();
@@ -499,6 +522,19 @@ namespace frystl
             // Requires begin() <= position < end()
             return erase(position, position + 1);
         }
+        // Erase the element at position by moving the last element into
+        // its place.  Unlike erase(), this takes constant time but does
+        // not keep the order of the elements.
+        iterator erase_unordered(const_iterator position) noexcept
+        {
+            // Requires begin() <= position < end()
+            size_type index = position - begin();
+            FRYSTL_ASSERT2(index < _size, "mf_vector::erase_unordered(pos): pos out of range");
+            if (index != _size - 1)
+                *MakeIterator(index) = std::move(back());
+            pop_back();
+            return MakeIterator(index);
+        }
         //
         //  Assignment functions
         void assign(size_type n, const_reference val)
@@ -575,10 +611,7 @@ namespace frystl
         {
             iterator p = MakeRoom(position,n);
             // copy val n times into newly available cells
-            for (iterator i = p; i < p + n; ++i)
-            {
-                Construct(i.operator->(), val);
-            }
+            FillRoom(p, n, [&val](pointer q) { Construct(q, val); });
             return p;
         }
         // Range insert()
@@ -608,6 +641,38 @@ namespace frystl
             // Requires begin()<=position && position<=end()
             return insert(position, il.begin(), il.end());
         }
+        // Insert the elements [first, last), which must be sorted by comp,
+        // into this vector, which must also be sorted by comp, keeping it
+        // sorted.  The new elements go after existing elements equivalent
+        // to them.  Grows once, then merges from the back, so each element
+        // moves at most once: O(size()+n) rather than O(size()*n) for n
+        // single insert() calls.
+        template <class BidirIter, class Compare = std::less<value_type>>
+        void insert_sorted_batch(BidirIter first, BidirIter last, Compare comp = Compare())
+        {
+            size_type n = std::distance(first, last);
+            Grow(_size + n);
+            MergeBackward(Begin(), End(), n,
+                [&last]() -> decltype(auto) { return *--last; },
+                [&](const_reference e, size_type) { return comp(*std::prev(last), e); });
+            _size += n;
+        }
+        // Insert values[i] for each i in [0, n), where n = posLast-posFirst,
+        // before the element whose index was positions[i] before the call
+        // (at the end if positions[i] == size()).  The positions must be in
+        // ascending order.  Values with equal positions keep their order.
+        // Grows once, and each element moves at most once.
+        template <class PosIter, class ValIter>
+        void insert_many(PosIter posFirst, PosIter posLast, ValIter values)
+        {
+            size_type n = std::distance(posFirst, posLast);
+            ValIter valLast = std::next(values, n);
+            Grow(_size + n);
+            MergeBackward(Begin(), End(), n,
+                [&]() -> decltype(auto) { --posLast; return *--valLast; },
+                [&](const_reference, size_type i) { return *std::prev(posLast) <= i; });
+            _size += n;
+        }
         void resize(size_type n, const value_type& val)
         {
             while (n < _size)
@@ -698,7 +763,197 @@ namespace frystl
         {
             return _blockSize;
         }
+        // Sort the elements into the order given by comp.  Each storage
+        // block is sorted by itself, and then the sorted blocks are merged
+        // into newly allocated blocks.  Both phases use up to nThreads
+        // threads (0 means one per hardware thread).  Source blocks are
+        // freed as soon as they have been drained, so the sort needs little
+        // more memory than the elements themselves.  With only one thread,
+        // this just calls std::sort() on the iterators.
+        // comp must not throw.  If a new block cannot be allocated during
+        // the merge, std::terminate() is called.  Invalidates all
+        // iterators, pointers, and references.
+        template <class Compare = std::less<T>>
+        void sort(Compare comp = Compare(), unsigned nThreads = 0)
+        {
+            BlockSort<false>(comp, nThreads);
+        }
+        // Like sort(), but preserves the order of equivalent elements.
+        template <class Compare = std::less<T>>
+        void stable_sort(Compare comp = Compare(), unsigned nThreads = 0)
+        {
+            BlockSort<true>(comp, nThreads);
+        }
+        // Append copies of the elements of src for which pred returns true,
+        // keeping their order.  The blocks of src are filtered in parallel
+        // on up to nThreads threads (0 means one per hardware thread),
+        // then this grows once and the survivors are copied into it in 
+        // parallel.  pred is called once per element.  Neither pred nor
+        // T's copy constructor may throw.  src must not be *this.
+        template <unsigned B1, size_t N1, class Predicate>
+        void append_if(const mf_vector<T, B1, N1>& src, Predicate pred, unsigned nThreads = 0)
+        {
+            FRYSTL_ASSERT2(static_cast<const void*>(&src) != this,
+                "mf_vector::append_if(): src is the destination");
+            constexpr size_type wordBits = 64;
+            constexpr size_type nWords = (B1 + wordBits - 1) / wordBits;
+            const size_type nBlocks = src._blocks.size() - 1;
+            // keep[b*nWords + i/64] bit i%64 is set iff pred(element i of block b)
+            std::vector<uint64_t> keep(nBlocks * nWords, 0);
+            std::vector<size_type> offset(nBlocks + 1, 0);
+            ParallelFor(nBlocks, nThreads, [&](size_t b) {
+                const_pointer first = src._blocks[b];
+                const size_type len = src.BlockLength(b);
+                uint64_t* words = &keep[b * nWords];
+                size_type count = 0;
+                for (size_type i = 0; i < len; ++i) {
+                    if (pred(first[i])) {
+                        words[i / wordBits] |= uint64_t(1) << (i % wordBits);
+                        ++count;
+                    }
+                }
+                offset[b + 1] = count;
+            });
+            for (size_type b = 0; b < nBlocks; ++b)
+                offset[b + 1] += offset[b];
+            const size_type oldSize = _size;
+            Grow(oldSize + offset[nBlocks]);
+            ParallelFor(nBlocks, nThreads, [&](size_t b) {
+                const_pointer first = src._blocks[b];
+                const uint64_t* words = &keep[b * nWords];
+                iterator out = MakeIterator(oldSize + offset[b]);
+                for (size_type w = 0; w < nWords; ++w) {
+                    for (uint64_t bits = words[w]; bits; bits &= bits - 1) {
+                        size_type i = w * wordBits + CountTrailingZeros(bits);
+                        Construct((out++).operator->(), first[i]);
+                    }
+                }
+            });
+            _size = oldSize + offset[nBlocks];
+        }
+        // Replace each element by init combined by op with all the elements 
+        // before it, and return init combined with all the elements.
+        // op must be associative; it need not be commutative.  Partial 
+        // results for each block are computed on up to nThreads threads
+        // (0 means one per hardware thread), then combined, then each
+        // block is rescanned in parallel.  Neither op nor T's assignment
+        // operators may throw.
+        template <class BinaryOp = std::plus<T>>
+        T exclusive_scan(T init, BinaryOp op = BinaryOp(), unsigned nThreads = 0)
+        {
+            const size_type nBlocks = _blocks.size() - 1;
+            // Reduce each block but the last.
+            std::vector<T> prefix;
+            prefix.reserve(nBlocks + 1);
+            prefix.push_back(init);
+            for (size_type b = 1; b < nBlocks; ++b)
+                prefix.push_back(_blocks[b - 1][0]);
+            ParallelFor(nBlocks - (nBlocks > 0), nThreads, [&](size_t b) {
+                const_pointer first = _blocks[b];
+                T& sum = prefix[b + 1];
+                for (size_type i = 1; i < _blockSize; ++i)
+                    sum = op(sum, first[i]);
+            });
+            // Scan the block sums.
+            for (size_type b = 1; b < nBlocks; ++b)
+                prefix[b] = op(prefix[b - 1], prefix[b]);
+            // Scan each block, starting from its prefix.
+            prefix.push_back(init);
+            ParallelFor(nBlocks, nThreads, [&](size_t b) {
+                pointer first = _blocks[b];
+                const size_type len = BlockLength(b);
+                T sum = prefix[b];
+                for (size_type i = 0; i < len; ++i) {
+                    T next = op(sum, first[i]);
+                    first[i] = std::move(sum);
+                    sum = std::move(next);
+                }
+                if (b + 1 == nBlocks)
+                    prefix.back() = std::move(sum);
+            });
+            return std::move(prefix.back());
+        }
+        // Sort the elements by key(element), which must return an unsigned
+        // integer, with a stable least-significant-digit radix sort using
+        // 8-bit digits.  Each pass counts the digits and then scatters the
+        // elements into newly allocated blocks, freeing each source block
+        // once it has been scattered.  Both steps divide the blocks among
+        // up to nThreads threads (0 means one per hardware thread).  Passes
+        // on digits shared by all the elements are skipped.  T must be
+        // trivially copyable, and key must not throw.  Invalidates all 
+        // iterators, pointers, and references.
+        template <class KeyFn>
+        void radix_sort(KeyFn key, unsigned nThreads = 0)
+        {
+            using Key = RadixKey<T, KeyFn>;
+            static_assert(std::is_trivially_copyable<T>::value,
+                "mf_vector::radix_sort() requires a trivially copyable type");
+            static_assert(std::is_unsigned<Key>::value,
+                "mf_vector::radix_sort() requires an unsigned integer key");
+            if (_size < 2)
+                return;
+            const size_type nBlocks = _blocks.size() - 1;
+            const unsigned nChunks = unsigned(std::min<size_type>(ThreadCount(nThreads), nBlocks));
+            auto chunkBegin = [nBlocks, nChunks](size_t c) {return nBlocks * c / nChunks;};
+            // counts[c*256+d] is the number of elements in chunk c with 
+            // digit d, then the index of the next cell for them.
+            std::vector<size_type> counts(nChunks * 256);
+            std::vector<pointer> newBlocks(nBlocks, nullptr);
+            for (unsigned shift = 0; shift < 8 * sizeof(Key); shift += 8) {
+                std::fill(counts.begin(), counts.end(), 0);
+                ParallelFor(nChunks, nChunks, [&](size_t c) {
+                    size_type* count = &counts[c * 256];
+                    for (size_type b = chunkBegin(c); b < chunkBegin(c + 1); ++b) {
+                        const_pointer first = _blocks[b];
+                        const size_type len = BlockLength(b);
+                        for (size_type i = 0; i < len; ++i)
+                            ++count[(key(first[i]) >> shift) & 0xff];
+                    }
+                });
+                size_type next = 0;
+                bool skip = false;
+                for (unsigned d = 0; d < 256; ++d) {
+                    const size_type digitBegin = next;
+                    for (unsigned c = 0; c < nChunks; ++c) {
+                        size_type n = counts[c * 256 + d];
+                        counts[c * 256 + d] = next;
+                        next += n;
+                    }
+                    skip = skip || next - digitBegin == _size;
+                }
+                if (skip)
+                    continue;
+                try {
+                    for (pointer& block : newBlocks)
+                        block = NewBlock();
+                }
+                catch (...) {
+                    for (pointer& block : newBlocks) {
+                        DeleteBlock(block);
+                        block = nullptr;
+                    }
+                    throw;
+                }
+                ParallelFor(nChunks, nChunks, [&](size_t c) {
+                    size_type* cell = &counts[c * 256];
+                    for (size_type b = chunkBegin(c); b < chunkBegin(c + 1); ++b) {
+                        const_pointer first = _blocks[b];
+                        const size_type len = BlockLength(b);
+                        for (size_type i = 0; i < len; ++i) {
+                            size_type to = cell[(key(first[i]) >> shift) & 0xff]++;
+                            std::memcpy(static_cast<void*>(newBlocks[to / _blockSize] + to % _blockSize),
+                                first + i, sizeof(T));
+                        }
+                        DeleteBlock(_blocks[b]);
+                    }
+                });
+                std::copy(newBlocks.begin(), newBlocks.end(), _blocks.begin());
+                // _blocks owns them now.
+                std::fill(newBlocks.begin(), newBlocks.end(), nullptr);
+            }
+        }
     private:
+        template <class, unsigned, size_t> friend class mf_vector;
         // The functions below manage storage for the container.  The vector _blocks
         // stores pointers to a sequence of storage blocks, each of size BlockSize,
         // plus one extra pointer at the end.  The extra pointer at the end points to
@@ -710,6 +965,14 @@ namespace frystl
         std::vector<pointer> _blocks;
         size_type _size;
 
+        static pointer NewBlock()
+        {
+            return reinterpret_cast<pointer>(new storage_type[_blockSize]);
+        }
+        static void DeleteBlock(pointer block) noexcept
+        {
+            delete[] reinterpret_cast<storage_type*>(block);
+        }
         // Grow capacity to newSize..
         // May invalidate iterators. Does not update _size.
         void Grow(size_type newSize)
@@ -718,7 +981,7 @@ namespace frystl
                 auto final = _blocks.back();
                 while ((_blocks.size() - 1) * _blockSize < newSize)
                 {
-                    _blocks.back() = reinterpret_cast<pointer>(new storage_type[_blockSize]);
+                    _blocks.back() = NewBlock();
                     _blocks.push_back(final);
                 }
             }
@@ -735,7 +998,7 @@ namespace frystl
             if (_size + _blockSize <= cap) {
                 auto ender = _blocks.back();
                 do {
-                    delete[] reinterpret_cast<storage_type*>(*(_blocks.end() - 2));
+                    DeleteBlock(*(_blocks.end() - 2));
                     _blocks.pop_back();
                     cap -= _blockSize;
                 } while (_size + _blockSize <= cap);
@@ -745,14 +1008,19 @@ namespace frystl
                 "mf_vector: internal error in Shrink()");
         }
         // Make n spaces available starting at pos.  Shift
-        // all elements at and after pos right by n spaces.
-        // Updates _size.
+        // all elements at and after pos right by n spaces,
+        // leaving the n cells at pos raw.  Updates _size.
         iterator MakeRoom(const_iterator pos, size_type n)
         {
             size_type index = pos - cbegin();
             size_type nu = std::min(size()-index, n);
             Grow(_size + n);    // invalidates iterators, does not change _size
             iterator result = MakeIterator(index);
+            if (Relocatable) {
+                Relocate(index, index + n, _size - index);
+                _size += n;
+                return result;
+            }
             // fill the uninitialized target cells by move construction
             iterator from = MakeIterator(_size-nu);
             iterator to = MakeIterator(_size-nu+n);
@@ -760,9 +1028,321 @@ namespace frystl
                 Construct((to++).operator->(), std::move(*(from++)));
             // shift elements to previously occupied cells by move assignment
             std::move_backward(result, MakeIterator(_size-nu), from);
+            // destroy the moved-from elements left in the gap
+            for (size_type i = 0; i < nu; ++i)
+                Destroy(Cell(index + i));
             _size += n;
             return result;
         }
+        // Construct elements in the n cells at pos that MakeRoom(pos, n)
+        // opened by calling fill(q) for each cell q in order.  If a call
+        // throws, destroy the cells already filled and shift the tail
+        // back, restoring the size.
+        template <class Fill>
+        void FillRoom(iterator pos, size_type n, Fill fill)
+        {
+            size_type index = pos - begin();
+            size_type i = index;
+            try {
+                for (; i < index + n; ++i)
+                    fill(Cell(i));
+            }
+            catch (...) {
+                for (size_type j = index; j < i; ++j)
+                    Destroy(Cell(j));
+                size_type oldSize = _size - n;
+                if (Relocatable)
+                    Relocate(index + n, index, oldSize - index);
+                else {
+                    // move the tail back, constructing in the raw gap
+                    for (size_type j = index; j < oldSize; ++j) {
+                        if (j < index + n)
+                            Construct(Cell(j), std::move(*Cell(j + n)));
+                        else
+                            *Cell(j) = std::move(*Cell(j + n));
+                    }
+                    for (size_type j = std::max(oldSize, index + n); j < _size; ++j)
+                        Destroy(Cell(j));
+                }
+                _size = oldSize;
+                Shrink();
+                throw;
+            }
+        }
+        // True if elements are shifted with memmove().
+        static constexpr bool Relocatable = is_trivially_relocatable<T>::value;
+        // Return a pointer to the cell at index, whose block must exist.
+        pointer Cell(size_type index) const noexcept
+        {
+            return _blocks[index / BlockSize] + index % BlockSize;
+        }
+        // Shift the count elements at index from to index to with
+        // memmove(), one run contiguous at both places at a time.  The
+        // runs are taken from the back when shifting right, so that no
+        // element is overwritten before it is moved.  Requires
+        // Relocatable.
+        void Relocate(size_type from, size_type to, size_type count) noexcept
+        {
+            while (count) {
+                size_type run;
+                if (from < to) {
+                    size_type srcEnd = from + count, dstEnd = to + count;
+                    run = std::min({count, (srcEnd - 1) % BlockSize + 1,
+                                    (dstEnd - 1) % BlockSize + 1});
+                    RelocateElements(Cell(dstEnd - run), Cell(srcEnd - run), run);
+                } else {
+                    run = std::min({count, BlockSize - from % BlockSize,
+                                    BlockSize - to % BlockSize});
+                    RelocateElements(Cell(to), Cell(from), run);
+                    from += run;
+                    to += run;
+                }
+                count -= run;
+            }
+        }
+        // Return the number of elements in block i.
+        size_type BlockLength(size_type i) const noexcept
+        {
+            return std::min<size_type>(_blockSize, _size - i * _blockSize);
+        }
+        // Helper for BlockSort().  Merges sorted runs of elements of an 
+        // mf_vector into a new set of blocks, moving each element once.
+        // A source block is freed as soon as all its elements have been
+        // moved.  Distinct threads may call Merge() at the same time if
+        // the runs they merge and the ranges of new cells they fill
+        // share no blocks, except for new blocks allocated by Provide()
+        // beforehand.
+        template <class Compare>
+        class BlockMerger
+        {
+        public:
+            // A cursor over the elements [.., end) of a run.  The elements
+            // [cur, stop) are contiguous in one block; next is the index 
+            // of the element after stop.  rank orders runs for stability.
+            struct Cursor {
+                pointer start;
+                pointer cur;
+                pointer stop;
+                size_type next;
+                size_type end;
+                size_type rank;
+            };
+            BlockMerger(mf_vector& v, Compare comp)
+                : _v(v)
+                , _comp(comp)
+                , _newBlocks(v._blocks.size() - 1, nullptr)
+                , _remaining(v._blocks.size() - 1)
+            {
+                ResetRemaining();
+            }
+            ~BlockMerger() noexcept
+            {
+                for (pointer block : _newBlocks)
+                    DeleteBlock(block);
+            }
+            // Return a cursor over the elements [first, last) of the
+            // run that starts at index rank.
+            Cursor MakeCursor(size_type first, size_type last, size_type rank) const noexcept
+            {
+                Cursor c {nullptr, nullptr, nullptr, first, last, rank};
+                LoadChunk(c);
+                return c;
+            }
+            // Allocate the new block that will hold element i, if needed.
+            void Provide(size_type i)
+            {
+                pointer& block = _newBlocks[i / _blockSize];
+                if (!block)
+                    block = NewBlock();
+            }
+            // Merge the runs into consecutive new cells, starting with
+            // the cell at index out.  Empties runs.
+            void Merge(std::vector<Cursor>& runs, size_type out)
+            {
+                // runs is kept as a heap whose front is the run holding
+                // the least element, the lowest rank breaking ties.
+                auto later = [this](const Cursor& a, const Cursor& b) {
+                    return _comp(*b.cur, *a.cur) || 
+                        (!_comp(*a.cur, *b.cur) && b.rank < a.rank);
+                };
+                std::make_heap(runs.begin(), runs.end(), later);
+                pointer dst = nullptr;
+                pointer dstEnd = nullptr;
+                while (!runs.empty()) {
+                    Cursor& c = runs.front();
+                    if (dst == dstEnd) {
+                        Provide(out);
+                        dst = _newBlocks[out / _blockSize] + out % _blockSize;
+                        dstEnd = _newBlocks[out / _blockSize] + _blockSize;
+                    }
+                    Construct(dst++, std::move(*c.cur));
+                    Destroy(c.cur);
+                    ++out;
+                    if (!Advance(c)) {
+                        c = runs.back();
+                        runs.pop_back();
+                    }
+                    SiftDown(runs, later);
+                }
+            }
+            // Replace the source blocks, which must all have been
+            // emptied, with the new ones.
+            void Install() noexcept
+            {
+                std::copy(_newBlocks.begin(), _newBlocks.end(), _v._blocks.begin());
+                std::fill(_newBlocks.begin(), _newBlocks.end(), nullptr);
+                ResetRemaining();
+            }
+        private:
+            mf_vector& _v;
+            Compare _comp;
+            std::vector<pointer> _newBlocks;
+            std::vector<std::atomic<unsigned>> _remaining; // unmoved elements per block
+
+            // Restore the heap property after the front of runs changes.
+            template <class Later>
+            static void SiftDown(std::vector<Cursor>& runs, Later later) noexcept
+            {
+                const size_type n = runs.size();
+                size_type i = 0;
+                for (size_type child = 1; child < n; child = 2 * i + 1) {
+                    if (child + 1 < n && later(runs[child], runs[child + 1]))
+                        ++child;
+                    if (!later(runs[i], runs[child]))
+                        break;
+                    std::swap(runs[i], runs[child]);
+                    i = child;
+                }
+            }
+            void ResetRemaining() noexcept
+            {
+                for (size_type b = 0; b < _remaining.size(); ++b)
+                    _remaining[b].store(unsigned(_v.BlockLength(b)), std::memory_order_relaxed);
+            }
+            void LoadChunk(Cursor& c) const noexcept
+            {
+                size_type block = c.next / _blockSize;
+                size_type chunkEnd = std::min<size_type>(c.end, (block + 1) * _blockSize);
+                c.start = c.cur = _v._blocks[block] + c.next % _blockSize;
+                c.stop = c.cur + (chunkEnd - c.next);
+                c.next = chunkEnd;
+            }
+            // Step c to its next element.  Return false if there is none.
+            bool Advance(Cursor& c) noexcept
+            {
+                if (++c.cur != c.stop)
+                    return true;
+                size_type block = (c.next - 1) / _blockSize;
+                unsigned moved = unsigned(c.stop - c.start);
+                if (_remaining[block].fetch_sub(moved) == moved)
+                    DeleteBlock(_v._blocks[block]);
+                if (c.next == c.end)
+                    return false;
+                LoadChunk(c);
+                return true;
+            }
+        };
+        static const unsigned _sortFanIn = 16;
+        // Implementation of sort() and stable_sort(): a bottom-up merge
+        // sort that moves the elements to new blocks on each merge pass.
+        //
+        // The first pass sorts each block in place.  Each middle pass 
+        // merges groups of _sortFanIn runs, one group per thread.  The
+        // final pass merges all the remaining runs.  It first splits each
+        // run at splitters chosen by regular sampling, so that every 
+        // element of partition t belongs before every element of
+        // partition t+1, then merges each partition on its own thread.
+        template <bool Stable, class Compare>
+        void BlockSort(Compare comp, unsigned nThreads)
+        {
+            const size_type nBlocks = _blocks.size() - 1;
+            nThreads = unsigned(std::min<size_type>(ThreadCount(nThreads), nBlocks));
+            if (nThreads < 2 && 1 < nBlocks) {
+                // The merge passes cost more than they save with one thread.
+                if (Stable)
+                    std::stable_sort(begin(), end(), comp);
+                else
+                    std::sort(begin(), end(), comp);
+                return;
+            }
+
+            ParallelFor(nBlocks, nThreads, [&](size_t b) {
+                pointer first = _blocks[b];
+                if (Stable)
+                    std::stable_sort(first, first + BlockLength(b), comp);
+                else
+                    std::sort(first, first + BlockLength(b), comp);
+            });
+            if (nBlocks < 2)
+                return;
+
+            using Cursor = typename BlockMerger<Compare>::Cursor;
+            BlockMerger<Compare> merger(*this, comp);
+            size_type runLength = _blockSize;
+            for (;;) {
+                const size_type nRuns = Ceiling(_size, runLength);
+                const size_type groupLength = runLength * _sortFanIn;
+                const size_type nGroups = Ceiling(_size, groupLength);
+                if (nRuns <= _sortFanIn || nGroups < nThreads)
+                    break;
+                ParallelFor(nGroups, nThreads, [&](size_t g) {
+                    const size_type first = g * groupLength;
+                    const size_type last = std::min(_size, first + groupLength);
+                    std::vector<Cursor> runs;
+                    for (size_type r = first; r < last; r += runLength)
+                        runs.push_back(merger.MakeCursor(r, std::min(last, r + runLength), r));
+                    merger.Merge(runs, first);
+                });
+                merger.Install();
+                runLength = groupLength;
+            }
+
+            // Final pass.  bounds[r*(nParts+1)+t] is the index of the first
+            // element of partition t in run r.
+            const unsigned nParts = nThreads;
+            const size_type nRuns = Ceiling(_size, runLength);
+            std::vector<const_pointer> splitters;
+            if (nParts > 1) {
+                const size_type nSamples = std::min<size_type>(_size, 256 * nParts);
+                std::vector<const_pointer> samples;
+                for (size_type s = 0; s < nSamples; ++s)
+                    samples.push_back(&(*this)[_size * s / nSamples]);
+                std::sort(samples.begin(), samples.end(),
+                    [&comp](const_pointer a, const_pointer b) { return comp(*a, *b); });
+                for (unsigned t = 1; t < nParts; ++t)
+                    splitters.push_back(samples[nSamples * t / nParts]);
+            }
+            std::vector<size_type> bounds(nRuns * (nParts + 1));
+            std::vector<size_type> partStart(nParts + 1, 0);
+            for (size_type r = 0; r < nRuns; ++r) {
+                size_type* bnd = &bounds[r * (nParts + 1)];
+                bnd[0] = r * runLength;
+                bnd[nParts] = std::min(_size, bnd[0] + runLength);
+                for (unsigned t = 1; t < nParts; ++t) {
+                    bnd[t] = std::upper_bound(cbegin() + bnd[t - 1], cbegin() + bnd[nParts],
+                        *splitters[t - 1], comp) - cbegin();
+                }
+                for (unsigned t = 1; t <= nParts; ++t)
+                    partStart[t] += bnd[t] - bnd[0];
+            }
+            for (unsigned t = 0; t < nParts; ++t) {
+                if (partStart[t] < partStart[t + 1]) {
+                    // Blocks that may be shared by two partitions
+                    merger.Provide(partStart[t]);
+                    merger.Provide(partStart[t + 1] - 1);
+                }
+            }
+            ParallelFor(nParts, nThreads, [&](size_t t) {
+                std::vector<Cursor> runs;
+                for (size_type r = 0; r < nRuns; ++r) {
+                    const size_type* bnd = &bounds[r * (nParts + 1) + t];
+                    if (bnd[0] < bnd[1])
+                        runs.push_back(merger.MakeCursor(bnd[0], bnd[1], r));
+                }
+                merger.Merge(runs, partStart[t]);
+            });
+            merger.Install();
+        }
         iterator Begin() const noexcept
         {
             // MFV_Iterator(pointer* block, pointer first, pointer last, pointer current)
@@ -796,12 +1376,32 @@ namespace frystl
     //
     //*******  Non-member overloads
     //
+    // Helper for the comparison operators.  Call compare(a, b, n) on
+    // successive runs of n elements that are contiguous in both lhs and
+    // rhs, covering their first n elements, until it returns nonzero.
+    // Return that value, or 0.
+    template <class T, unsigned B1, unsigned B2, size_t N1, size_t N2, class Compare>
+    int CompareRuns(const mf_vector<T, B1, N1>& lhs, const mf_vector<T, B2, N2>& rhs,
+        size_t n, Compare compare)
+    {
+        for (size_t i = 0; i < n; ) {
+            size_t len = std::min({size_t(B1 - i % B1), size_t(B2 - i % B2), n - i});
+            if (int r = compare(&lhs[i], &rhs[i], len))
+                return r;
+            i += len;
+        }
+        return 0;
+    }
     template <class T, unsigned B1, unsigned B2, size_t N1, size_t N2>
     bool operator==(const mf_vector<T, B1, N1>& lhs, const mf_vector<T, B2, N2>& rhs) noexcept
     {
         if (lhs.size() != rhs.size())
             return false;
-        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        if constexpr (is_bitwise_comparable<T>::value)
+            return CompareRuns(lhs, rhs, lhs.size(), 
+                [](const T* a, const T* b, size_t n) { return !EqualElements(a, b, n); }) == 0;
+        else
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
     template <class T, unsigned B1, unsigned B2, size_t N1, size_t N2>
     bool operator!=(const mf_vector<T, B1, N1>& lhs, const mf_vector<T, B2, N2>& rhs) noexcept
@@ -811,7 +1411,12 @@ namespace frystl
     template <class T, unsigned B1, unsigned B2, size_t N1, size_t N2>
     bool operator<(const mf_vector<T, B1, N1>& lhs, const mf_vector<T, B2, N2>& rhs) noexcept
     {
-        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        if constexpr (is_bitwise_comparable<T>::value) {
+            int r = CompareRuns(lhs, rhs, std::min(lhs.size(), rhs.size()), CompareElements<T>);
+            return r < 0 || (r == 0 && lhs.size() < rhs.size());
+        }
+        else
+            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
     template <class T, unsigned B1, unsigned B2, size_t N1, size_t N2>
     bool operator<=(const mf_vector<T, B1, N1>& lhs, const mf_vector<T, B2, N2>& rhs) noexcept
@@ -828,10 +1433,88 @@ namespace frystl
     {
         return !(lhs < rhs);
     }
+#ifdef FRYSTL_HAS_THREE_WAY
+    template <class T, unsigned B1, unsigned B2, size_t N1, size_t N2>
+    auto operator<=>(const mf_vector<T, B1, N1>& lhs, const mf_vector<T, B2, N2>& rhs)
+    {
+        if constexpr (is_bitwise_comparable<T>::value) {
+            int r = CompareRuns(lhs, rhs, std::min(lhs.size(), rhs.size()), CompareElements<T>);
+            return r != 0 ? r <=> 0 : lhs.size() <=> rhs.size();
+        }
+        else
+            return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(),
+                rhs.begin(), rhs.end(), SynthThreeWay());
+    }
+#endif
+    template <class T, unsigned B, size_t N, class Compare = std::less<T>>
+    void sort(mf_vector<T, B, N>& v, Compare comp = Compare(), unsigned nThreads = 0)
+    {
+        v.sort(comp, nThreads);
+    }
+    template <class T, unsigned B, size_t N, class Compare = std::less<T>>
+    void stable_sort(mf_vector<T, B, N>& v, Compare comp = Compare(), unsigned nThreads = 0)
+    {
+        v.stable_sort(comp, nThreads);
+    }
+    template <class T, unsigned B, size_t N, class KeyFn>
+    void radix_sort(mf_vector<T, B, N>& v, KeyFn key, unsigned nThreads = 0)
+    {
+        v.radix_sort(key, nThreads);
+    }
+    // Append to dst the elements of src for which pred returns true.
+    // See mf_vector::append_if().
+    template <class T, unsigned B0, size_t N0, unsigned B1, size_t N1, class Predicate>
+    void copy_if(const mf_vector<T, B0, N0>& src, mf_vector<T, B1, N1>& dst, 
+        Predicate pred, unsigned nThreads = 0)
+    {
+        dst.append_if(src, pred, nThreads);
+    }
+    // In-place exclusive scan.  See mf_vector::exclusive_scan().
+    template <class T, unsigned B, size_t N, class BinaryOp = std::plus<T>>
+    T exclusive_scan(mf_vector<T, B, N>& v, T init, BinaryOp op = BinaryOp(), 
+        unsigned nThreads = 0)
+    {
+        return v.exclusive_scan(std::move(init), op, nThreads);
+    }
     template <class T, unsigned BS, size_t NB0, size_t NB1>
     void swap(mf_vector<T, BS, NB0>& a, mf_vector<T, BS, NB1>& b) noexcept
     {
         a.swap(b);
     }
+    // Erase the elements of c for which pred returns true, keeping the
+    // order of the others, in one pass.  Return the number erased.
+    template <class T, unsigned B, size_t N, class Pred>
+    size_t erase_if(mf_vector<T, B, N>& c, Pred pred)
+    {
+        return EraseIf(c, pred);
+    }
+    // Erase the elements of c at the positions in indices, which must be
+    // sorted in ascending order, keeping the order of the others, in one
+    // pass.  Return the number erased.
+    template <class T, unsigned B, size_t N, class Indices>
+    size_t erase_indices(mf_vector<T, B, N>& c, const Indices& indices)
+    {
+        using std::begin;
+        using std::end;
+        return EraseIndices(c, begin(indices), end(indices));
+    }
 }; // namespace frystl
+
+namespace std
+{
+    // Hash the elements of an mf_vector, block by block.  See 
+    // frystl-hash.hpp.
+    template <class T, unsigned B, size_t N>
+    struct hash<frystl::mf_vector<T, B, N>>
+    {
+        size_t operator()(const frystl::mf_vector<T, B, N>& v) const
+        {
+            uint64_t h = 0;
+            const size_t n = v.size();
+            for (size_t i = 0; i < n; i += B)
+                h = frystl::HashRange(&v[i], std::min<size_t>(B, n - i), h);
+            return size_t(h);
+        }
+    };
+}   // namespace std
 #endif      // ndef FRYSTL_MF_VECTOR
@@ -0,0 +1,523 @@
+// Template class packed_static_vector
+//
+// packed_static_vector<Bits,Capacity> is a static_vector of up to
+// Capacity unsigned values, each Bits wide, packed end to end in an
+// array of 64-bit words.  A value may straddle two words.  The size is
+// kept in the top bits of the last word, so the object is nothing but
+// the words: a packed_static_vector<6,52> of playing cards occupies 40
+// bytes where a static_vector<uint8_t,52> occupies 53.
+//
+// Bits beyond the last element are kept zero, so operator== compares
+// whole words, operator< compares whole words up to the first that
+// differs, and std::hash hashes the words.
+//
+// Like std::vector<bool>, it cannot hand out references or pointers to
+// its elements.  operator[], front(), back(), and iterators of a
+// non-const packed_static_vector return proxy objects that convert to
+// value_type and can be assigned from it; those of a const one return
+// values.  There is no data().  The iterators are random-access in the
+// C++17 sense, but as their references are proxies, algorithms that
+// swap or move elements through them may not work.
+//
+// Storing a value wider than Bits bits fails an assertion if
+// FRYSTL_DEBUG is defined; otherwise the value is truncated.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_PACKED_STATIC_VECTOR
+#define FRYSTL_PACKED_STATIC_VECTOR
+#include <cstdint>   // uint64_t, uint32_t
+#include <cstddef>   // ptrdiff_t
+#include <iterator>  // reverse_iterator, random_access_iterator_tag
+#include <initializer_list>
+#include <stdexcept> // out_of_range
+#include <type_traits> // conditional_t, enable_if_t
+#include "frystl-defines.hpp"
+#include "frystl-hash.hpp"
+
+namespace frystl
+{
+    template <unsigned Bits, unsigned Capacity>
+    class packed_static_vector
+    {
+        static_assert(0 < Bits && Bits <= 32, "packed_static_vector: Bits must be 1 to 32");
+        static_assert(Capacity > 0, "packed_static_vector: Capacity must be positive");
+        template <bool Const> class Iterator;
+    public:
+        using this_type = packed_static_vector<Bits, Capacity>;
+        using value_type = std::conditional_t<(Bits <= 8), uint8_t,
+            std::conditional_t<(Bits <= 16), uint16_t, uint32_t>>;
+        using size_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        class reference;
+        using const_reference = value_type;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        // The largest value an element can hold
+        static constexpr value_type max_value = value_type((uint64_t(1) << Bits) - 1);
+
+        // A proxy for an element
+        class reference
+        {
+        public:
+            operator value_type() const noexcept { return _v->Get(_i); }
+            reference &operator=(value_type x) noexcept
+            {
+                _v->Set(_i, x);
+                return *this;
+            }
+            reference &operator=(const reference &r) noexcept
+            {
+                return *this = value_type(r);
+            }
+            friend void swap(reference a, reference b) noexcept
+            {
+                value_type t = a;
+                a = value_type(b);
+                b = t;
+            }
+        private:
+            friend class packed_static_vector;
+            reference(packed_static_vector *v, size_type i) noexcept
+                : _v(v), _i(i)
+            {}
+            packed_static_vector *_v;
+            size_type _i;
+        };
+        //
+        //******* Public member functions:
+        //
+        packed_static_vector() noexcept
+            : _words {}
+        {}
+        explicit packed_static_vector(size_type n, value_type value = 0) noexcept
+            : packed_static_vector()
+        {
+            resize(n, value);
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        packed_static_vector(InputIterator begin, InputIterator end)
+            : packed_static_vector()
+        {
+            for (; begin != end; ++begin)
+                push_back(*begin);
+        }
+        packed_static_vector(std::initializer_list<value_type> il) noexcept
+            : packed_static_vector(il.begin(), il.end())
+        {}
+        this_type &operator=(std::initializer_list<value_type> il) noexcept
+        {
+            assign(il);
+            return *this;
+        }
+        void assign(size_type n, value_type value) noexcept
+        {
+            clear();
+            resize(n, value);
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        void assign(InputIterator begin, InputIterator end)
+        {
+            clear();
+            for (; begin != end; ++begin)
+                push_back(*begin);
+        }
+        void assign(std::initializer_list<value_type> il) noexcept
+        {
+            assign(il.begin(), il.end());
+        }
+        //
+        //  Element access
+        //
+        reference at(size_type i)
+        {
+            Verify(i < size());
+            return reference(this, i);
+        }
+        value_type at(size_type i) const
+        {
+            Verify(i < size());
+            return Get(i);
+        }
+        reference operator[](size_type i) noexcept
+        {
+            FRYSTL_ASSERT2(i < size(), "packed_static_vector: index out of range");
+            return reference(this, i);
+        }
+        value_type operator[](size_type i) const noexcept
+        {
+            FRYSTL_ASSERT2(i < size(), "packed_static_vector: index out of range");
+            return Get(i);
+        }
+        reference front() noexcept { return (*this)[0]; }
+        value_type front() const noexcept { return (*this)[0]; }
+        reference back() noexcept { return (*this)[size() - 1]; }
+        value_type back() const noexcept { return (*this)[size() - 1]; }
+        //
+        //  Iterators
+        //
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, size()); }
+        const_iterator end() const noexcept { return const_iterator(this, size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+        //
+        //  Capacity
+        //
+        size_type size() const noexcept
+        {
+            return size_type(_words[NWords - 1] >> SizeShift);
+        }
+        bool empty() const noexcept { return size() == 0; }
+        constexpr size_type capacity() const noexcept { return Capacity; }
+        constexpr size_type max_size() const noexcept { return Capacity; }
+        //
+        //  Modifiers
+        //
+        void push_back(value_type value) noexcept
+        {
+            size_type n = size();
+            FRYSTL_ASSERT2(n < Capacity, "packed_static_vector::push_back() overflow");
+            Set(n, value);
+            SetSize(n + 1);
+        }
+        template <class... Args>
+        reference emplace_back(Args &&... args) noexcept
+        {
+            push_back(value_type(std::forward<Args>(args)...));
+            return back();
+        }
+        void pop_back() noexcept
+        {
+            size_type n = size();
+            FRYSTL_ASSERT2(n, "packed_static_vector::pop_back() on empty vector");
+            Set(n - 1, 0);
+            SetSize(n - 1);
+        }
+        void clear() noexcept
+        {
+            for (uint64_t &w : _words)
+                w = 0;
+        }
+        void resize(size_type n, value_type value = 0) noexcept
+        {
+            FRYSTL_ASSERT2(n <= Capacity, "packed_static_vector::resize: overflow");
+            while (n < size())
+                pop_back();
+            while (size() < n)
+                push_back(value);
+        }
+        iterator insert(const_iterator position, value_type value) noexcept
+        {
+            return insert(position, 1, value);
+        }
+        iterator insert(const_iterator position, size_type n, value_type value) noexcept
+        {
+            size_type i = MakeRoom(position, n);
+            for (size_type j = 0; j < n; ++j)
+                Set(i + j, value);
+            return begin() + i;
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        iterator insert(const_iterator position, InputIterator first, InputIterator last)
+        {
+            size_type i = position - cbegin();
+            size_type oldSize = size();
+            for (; first != last; ++first)
+                push_back(*first);
+            Rotate(i, oldSize, size());
+            return begin() + i;
+        }
+        iterator insert(const_iterator position, std::initializer_list<value_type> il) noexcept
+        {
+            return insert(position, il.begin(), il.end());
+        }
+        iterator erase(const_iterator position) noexcept
+        {
+            return erase(position, position + 1);
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            FRYSTL_ASSERT2(cbegin() <= first && first <= last && last <= cend(),
+                "packed_static_vector::erase(first,last): bad range");
+            size_type f = first - cbegin();
+            size_type l = last - cbegin();
+            size_type n = size();
+            for (size_type i = l; i < n; ++i)
+                Set(f + i - l, Get(i));
+            for (size_type i = n - (l - f); i < n; ++i)
+                Set(i, 0);
+            SetSize(n - (l - f));
+            return begin() + f;
+        }
+        void swap(this_type &other) noexcept
+        {
+            for (unsigned i = 0; i < NWords; ++i)
+                std::swap(_words[i], other._words[i]);
+        }
+        //
+        //  Word access
+        //
+        // The words holding the elements, and in the top bits of the
+        // last one, the size.  Element i occupies bits i*Bits through
+        // i*Bits+Bits-1, counting from bit 0 of word 0.
+        static constexpr unsigned word_count() noexcept { return NWords; }
+        const uint64_t *words() const noexcept { return _words; }
+
+    private:
+        template <bool Const>
+        class Iterator
+        {
+            using Container = std::conditional_t<Const, const packed_static_vector,
+                packed_static_vector>;
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = packed_static_vector::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, value_type,
+                packed_static_vector::reference>;
+            using pointer = void;
+
+            Iterator() noexcept : _v(nullptr), _i(0) {}
+            // Convert an iterator to a const_iterator
+            template <bool C = Const, typename = std::enable_if_t<C>>
+            Iterator(const Iterator<false> &it) noexcept : _v(it._v), _i(it._i) {}
+
+            reference operator*() const noexcept { return _v->Ref(_i); }
+            reference operator[](difference_type n) const noexcept { return _v->Ref(_i + n); }
+            Iterator &operator++() noexcept { ++_i; return *this; }
+            Iterator operator++(int) noexcept { Iterator r = *this; ++_i; return r; }
+            Iterator &operator--() noexcept { --_i; return *this; }
+            Iterator operator--(int) noexcept { Iterator r = *this; --_i; return r; }
+            Iterator &operator+=(difference_type n) noexcept { _i += size_type(n); return *this; }
+            Iterator &operator-=(difference_type n) noexcept { _i -= size_type(n); return *this; }
+            Iterator operator+(difference_type n) const noexcept { return Iterator(_v, _i + size_type(n)); }
+            friend Iterator operator+(difference_type n, const Iterator &it) noexcept { return it + n; }
+            Iterator operator-(difference_type n) const noexcept { return Iterator(_v, _i - size_type(n)); }
+            difference_type operator-(const Iterator &it) const noexcept
+            {
+                return difference_type(_i) - difference_type(it._i);
+            }
+            bool operator==(const Iterator &it) const noexcept { return _i == it._i; }
+            bool operator!=(const Iterator &it) const noexcept { return _i != it._i; }
+            bool operator<(const Iterator &it) const noexcept { return _i < it._i; }
+            bool operator<=(const Iterator &it) const noexcept { return _i <= it._i; }
+            bool operator>(const Iterator &it) const noexcept { return _i > it._i; }
+            bool operator>=(const Iterator &it) const noexcept { return _i >= it._i; }
+        private:
+            friend class packed_static_vector;
+            friend class Iterator<true>;
+            Iterator(Container *v, size_type i) noexcept : _v(v), _i(i) {}
+            Container *_v;
+            size_type _i;
+        };
+        // The number of bits needed to hold n
+        static constexpr unsigned BitWidth(uint64_t n) noexcept
+        {
+            unsigned w = 0;
+            for (; n; n >>= 1)
+                ++w;
+            return w;
+        }
+        static constexpr unsigned SizeBits = BitWidth(Capacity);
+        static constexpr unsigned NWords = unsigned((uint64_t(Bits) * Capacity + SizeBits + 63) / 64);
+        static constexpr unsigned SizeShift = 64 - SizeBits;
+        static constexpr uint64_t Mask = (uint64_t(1) << Bits) - 1;
+
+        uint64_t _words[NWords];
+
+        template <unsigned B, unsigned C0, unsigned C1>
+        friend int ComparePacked(const packed_static_vector<B, C0> &,
+            const packed_static_vector<B, C1> &) noexcept;
+
+        static void Verify(bool cond)
+        {
+            if (!cond)
+                throw std::out_of_range("packed_static_vector range error");
+        }
+        value_type Get(size_type i) const noexcept
+        {
+            uint64_t bit = uint64_t(i) * Bits;
+            size_type w = size_type(bit / 64);
+            unsigned off = bit % 64;
+            uint64_t x = _words[w] >> off;
+            if (off + Bits > 64)
+                x |= _words[w + 1] << (64 - off);
+            return value_type(x & Mask);
+        }
+        void Set(size_type i, value_type value) noexcept
+        {
+            FRYSTL_ASSERT2(value <= Mask, "packed_static_vector: value too wide");
+            uint64_t x = value & Mask;
+            uint64_t bit = uint64_t(i) * Bits;
+            size_type w = size_type(bit / 64);
+            unsigned off = bit % 64;
+            _words[w] = (_words[w] & ~(Mask << off)) | (x << off);
+            if (off + Bits > 64) {
+                unsigned low = 64 - off;    // bits of x in word w
+                _words[w + 1] = (_words[w + 1] & ~(Mask >> low)) | (x >> low);
+            }
+        }
+        void SetSize(size_type n) noexcept
+        {
+            uint64_t &last = _words[NWords - 1];
+            last = (last & ~(~uint64_t(0) << SizeShift)) | (uint64_t(n) << SizeShift);
+        }
+        reference Ref(size_type i) noexcept { return reference(this, i); }
+        value_type Ref(size_type i) const noexcept { return Get(i); }
+        // Move the elements at and after position n places toward the
+        // back, and return position's index.
+        size_type MakeRoom(const_iterator position, size_type n) noexcept
+        {
+            size_type i = position - cbegin();
+            size_type oldSize = size();
+            FRYSTL_ASSERT2(i <= oldSize, "packed_static_vector::insert(): bad position");
+            FRYSTL_ASSERT2(n <= Capacity - oldSize, "packed_static_vector::insert(): overflow");
+            SetSize(oldSize + n);
+            for (size_type j = oldSize; j-- > i; )
+                Set(j + n, Get(j));
+            return i;
+        }
+        // Rotate the elements [first, last) so that middle becomes first.
+        void Rotate(size_type first, size_type middle, size_type last) noexcept
+        {
+            auto reverse = [this](size_type f, size_type l) {
+                for (; f + 1 < l; ++f, --l) {
+                    value_type t = Get(f);
+                    Set(f, Get(l - 1));
+                    Set(l - 1, t);
+                }
+            };
+            reverse(first, middle);
+            reverse(middle, last);
+            reverse(first, last);
+        }
+    };
+    //
+    //*******  Non-member overloads
+    //
+    // Return a negative number, zero, or a positive number as lhs is
+    // less than, equal to, or greater than rhs.  Whole words are compared
+    // up to the first that differs.
+    template <unsigned B, unsigned C0, unsigned C1>
+    int ComparePacked(const packed_static_vector<B, C0> &lhs,
+        const packed_static_vector<B, C1> &rhs) noexcept
+    {
+        using Vec = packed_static_vector<B, C0>;
+        const uint32_t nl = lhs.size(), nr = rhs.size();
+        const uint32_t n = nl < nr ? nl : nr;
+        const uint64_t nBits = uint64_t(n) * B;
+        // Only whole words of elements common to both are compared, so
+        // neither size field takes part.
+        for (uint64_t w = 0; w * 64 < nBits; ++w) {
+            uint64_t diff = lhs._words[w] ^ rhs._words[w];
+            if (diff) {
+                uint64_t bit = w * 64 + CountTrailingZeros(diff);
+                if (bit >= nBits)
+                    break;
+                typename Vec::size_type i = typename Vec::size_type(bit / B);
+                return lhs[i] < rhs[i] ? -1 : 1;
+            }
+        }
+        return nl < nr ? -1 : nl > nr ? 1 : 0;
+    }
+    template <unsigned B, unsigned C>
+    bool operator==(const packed_static_vector<B, C> &lhs,
+        const packed_static_vector<B, C> &rhs) noexcept
+    {
+        // The sizes are in the last words.
+        for (unsigned w = 0; w < lhs.word_count(); ++w)
+            if (lhs.words()[w] != rhs.words()[w])
+                return false;
+        return true;
+    }
+    template <unsigned B, unsigned C>
+    bool operator!=(const packed_static_vector<B, C> &lhs,
+        const packed_static_vector<B, C> &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+    template <unsigned B, unsigned C0, unsigned C1>
+    bool operator<(const packed_static_vector<B, C0> &lhs,
+        const packed_static_vector<B, C1> &rhs) noexcept
+    {
+        return ComparePacked(lhs, rhs) < 0;
+    }
+    template <unsigned B, unsigned C0, unsigned C1>
+    bool operator<=(const packed_static_vector<B, C0> &lhs,
+        const packed_static_vector<B, C1> &rhs) noexcept
+    {
+        return ComparePacked(lhs, rhs) <= 0;
+    }
+    template <unsigned B, unsigned C0, unsigned C1>
+    bool operator>(const packed_static_vector<B, C0> &lhs,
+        const packed_static_vector<B, C1> &rhs) noexcept
+    {
+        return ComparePacked(lhs, rhs) > 0;
+    }
+    template <unsigned B, unsigned C0, unsigned C1>
+    bool operator>=(const packed_static_vector<B, C0> &lhs,
+        const packed_static_vector<B, C1> &rhs) noexcept
+    {
+        return ComparePacked(lhs, rhs) >= 0;
+    }
+#ifdef FRYSTL_HAS_THREE_WAY
+    template <unsigned B, unsigned C0, unsigned C1>
+    std::strong_ordering operator<=>(const packed_static_vector<B, C0> &lhs,
+        const packed_static_vector<B, C1> &rhs) noexcept
+    {
+        return ComparePacked(lhs, rhs) <=> 0;
+    }
+#endif
+    template <unsigned B, unsigned C>
+    void swap(packed_static_vector<B, C> &a, packed_static_vector<B, C> &b) noexcept
+    {
+        a.swap(b);
+    }
+}       // namespace frystl
+
+namespace std
+{
+    // Hash the words of a packed_static_vector, including its size.
+    template <unsigned B, unsigned C>
+    struct hash<frystl::packed_static_vector<B, C>>
+    {
+        size_t operator()(const frystl::packed_static_vector<B, C> &v) const noexcept
+        {
+            return size_t(frystl::HashRange(v.words(), v.word_count()));
+        }
+    };
+}       // namespace std
+#endif  // ndef FRYSTL_PACKED_STATIC_VECTOR
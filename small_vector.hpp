@@ -0,0 +1,671 @@
+// Template class small_vector
+//
+// small_vector<T,N> has nearly all of the API of a std::vector.  Up to N
+// elements are stored inline, in an array inside the object, like a
+// static_vector<T,N>.  When an insertion would overflow that array, the
+// elements are moved to a buffer in dynamic memory, which then grows
+// like a std::vector's.  The common small case needs no allocation, and
+// the rare large one is still correct.
+//
+// Once on the heap, a small_vector stays there until shrink_to_fit()
+// finds that its elements fit inline again, or it is moved from.
+//
+// Like a std::vector, a small_vector keeps its elements contiguous, so
+// its iterators are pointers and data() can be used as a C array.  Any
+// operation that moves the elements to a new buffer invalidates all
+// iterators, pointers, and references; otherwise invalidation is as for
+// std::vector.  Moving a small_vector whose elements are on the heap
+// steals the buffer; moving one whose elements are inline moves them
+// one at a time.  Either way, the moved-from small_vector is left empty.
+//
+// The function get_allocator() is not implemented.  The function
+// is_inline() returns true if the elements are stored inline.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_SMALL_VECTOR
+#define FRYSTL_SMALL_VECTOR
+#include <algorithm> // for std::move...(), equal(), lexicographical_compare(), rotate(), max()
+#include <initializer_list>
+#include <iterator>  // std::reverse_iterator, iterator_traits, distance()
+#include <stdexcept> // for std::out_of_range
+#include <cstddef>   // size_t, ptrdiff_t
+#include <limits>    // numeric_limits
+#include <memory>    // uninitialized_fill_n
+#include <type_traits> // aligned_storage
+#include <utility>   // move_if_noexcept
+#include "frystl-defines.hpp"
+#include "frystl-hash.hpp"
+
+namespace frystl
+{
+    template <class T, unsigned N>
+    class small_vector
+    {
+        static_assert(N > 0, "small_vector: N must be positive");
+    public:
+        using this_type = small_vector<T, N>;
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        //
+        //******* Public member functions:
+        //
+        small_vector() noexcept
+            : _data(Inline()), _size(0), _capacity(N)
+        {}
+        ~small_vector() noexcept
+        {
+            clear();
+            Release();
+        }
+        // copy constructors
+        small_vector(const this_type &donor)
+            : small_vector(donor.begin(), donor.end())
+        {}
+        template <unsigned N1>
+        small_vector(const small_vector<T, N1> &donor)
+            : small_vector(donor.begin(), donor.end())
+        {}
+        // move constructors
+        // Takes donor's heap buffer if it has one; otherwise moves its
+        // elements one at a time.  Leaves donor empty.
+        small_vector(this_type &&donor) noexcept
+            : small_vector()
+        {
+            TakeFrom(donor);
+        }
+        template <unsigned N1>
+        small_vector(small_vector<T, N1> &&donor)
+            : small_vector()
+        {
+            TakeFrom(donor);
+        }
+        // fill constructors
+        small_vector(size_type n, const_reference value)
+            : small_vector()
+        {
+            assign(n, value);
+        }
+        explicit small_vector(size_type n)
+            : small_vector()
+        {
+            resize(n);
+        }
+        // range constructor
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        small_vector(InputIterator begin, InputIterator end)
+            : small_vector()
+        {
+            assign(begin, end);
+        }
+        // initializer list constructor
+        small_vector(std::initializer_list<value_type> il)
+            : small_vector(il.begin(), il.end())
+        {}
+        //
+        //  Assignment functions
+        void assign(size_type n, const_reference val)
+        {
+            clear();
+            if (_capacity < n) {
+                value_type copy(val);   // val may be an element
+                Grow(n);
+                std::uninitialized_fill_n(_data, n, copy);
+            }
+            else
+                std::uninitialized_fill_n(_data, n, val);
+            _size = n;
+        }
+        void assign(std::initializer_list<value_type> x)
+        {
+            assign(x.begin(), x.end());
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        void assign(InputIterator begin, InputIterator end)
+        {
+            clear();
+            Append(begin, end,
+                typename std::iterator_traits<InputIterator>::iterator_category());
+        }
+        this_type &operator=(const this_type &other)
+        {
+            if (this != &other)
+                assign(other.begin(), other.end());
+            return *this;
+        }
+        template <unsigned N1>
+        this_type &operator=(const small_vector<T, N1> &other)
+        {
+            assign(other.begin(), other.end());
+            return *this;
+        }
+        // Move operator=.  Except for self-assignments, other
+        // will be left empty.
+        this_type &operator=(this_type &&other) noexcept
+        {
+            if (this != &other) {
+                clear();
+                TakeFrom(other);
+            }
+            return *this;
+        }
+        template <unsigned N1>
+        this_type &operator=(small_vector<T, N1> &&other)
+        {
+            clear();
+            TakeFrom(other);
+            return *this;
+        }
+        this_type &operator=(std::initializer_list<value_type> il)
+        {
+            assign(il);
+            return *this;
+        }
+        //
+        //  Element access functions
+        //
+        pointer data() noexcept { return _data; }
+        const_pointer data() const noexcept { return _data; }
+        reference at(size_type i)
+        {
+            Verify(i < _size);
+            return _data[i];
+        }
+        reference operator[](size_type i) noexcept
+        {
+            FRYSTL_ASSERT2(i < _size,"small_vector: index out of range");
+            return _data[i];
+        }
+        const_reference at(size_type i) const
+        {
+            Verify(i < _size);
+            return _data[i];
+        }
+        const_reference operator[](size_type i) const noexcept
+        {
+            FRYSTL_ASSERT2(i < _size,"small_vector: index out of range");
+            return _data[i];
+        }
+        reference back() noexcept
+        {
+            FRYSTL_ASSERT2(_size,"back() called on empty small_vector");
+            return _data[_size - 1];
+        }
+        const_reference back() const noexcept
+        {
+            FRYSTL_ASSERT2(_size,"back() called on empty small_vector");
+            return _data[_size - 1];
+        }
+        reference front() noexcept
+        {
+            FRYSTL_ASSERT2(_size,"front() called on empty small_vector");
+            return *_data;
+        }
+        const_reference front() const noexcept
+        {
+            FRYSTL_ASSERT2(_size,"front() called on empty small_vector");
+            return *_data;
+        }
+        //
+        //  Iterators
+        //
+        iterator begin() noexcept { return _data; }
+        const_iterator begin() const noexcept { return _data; }
+        const_iterator cbegin() const noexcept { return _data; }
+        iterator end() noexcept { return _data + _size; }
+        const_iterator end() const noexcept { return _data + _size; }
+        const_iterator cend() const noexcept { return _data + _size; }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+        //
+        // Capacity and size
+        //
+        size_type capacity() const noexcept { return _capacity; }
+        size_type max_size() const noexcept
+        {
+            return std::numeric_limits<difference_type>::max() / sizeof(T);
+        }
+        size_type size() const noexcept { return _size; }
+        bool empty() const noexcept { return _size == 0; }
+        // Return true if the elements are stored inline.
+        bool is_inline() const noexcept { return _data == Inline(); }
+        static constexpr size_type inline_capacity() noexcept { return N; }
+        void reserve(size_type n)
+        {
+            if (_capacity < n)
+                Grow(n);
+        }
+        // If the elements are on the heap, move them to a buffer that
+        // holds just them, or inline if they fit.
+        void shrink_to_fit()
+        {
+            if (!is_inline() && _size < _capacity) {
+                if (_size <= N)
+                    MoveTo(Inline(), N);
+                else
+                    MoveToHeap(_size);
+            }
+        }
+        //
+        //  Modifiers
+        //
+        void pop_back() noexcept
+        {
+            FRYSTL_ASSERT2(_size, "small_vector::pop_back() on empty vector");
+            _size -= 1;
+            Destroy(end());
+        }
+        void push_back(const T &value) { emplace_back(value); }
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+        void clear() noexcept
+        {
+            while (_size)
+                pop_back();
+        }
+        iterator erase(const_iterator position) noexcept
+        {
+            FRYSTL_ASSERT2(begin() <= position && position < end(),
+                "small_vector::erase(pos): pos out of range");
+            return erase(position, position + 1);
+        }
+        // Erase the element at position by moving the last element into
+        // its place.  Unlike erase(), this takes constant time but does
+        // not keep the order of the elements.
+        iterator erase_unordered(const_iterator position) noexcept
+        {
+            FRYSTL_ASSERT2(begin() <= position && position < end(),
+                "small_vector::erase_unordered(pos): pos out of range");
+            iterator p = const_cast<iterator>(position);
+            if (p != end() - 1)
+                *p = std::move(back());
+            pop_back();
+            return p;
+        }
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            iterator f = const_cast<iterator>(first);
+            iterator l = const_cast<iterator>(last);
+            if (first != last)
+            {
+                FRYSTL_ASSERT2(begin() <= first && last <= end(),
+                    "small_vector::erase(first,last): bad range");
+                FRYSTL_ASSERT2(first < last,
+                    "small_vector::erase(first,last): last < first");
+                iterator newEnd = std::move(l, end(), f);
+                for (iterator it = newEnd; it < end(); ++it)
+                    Destroy(it);
+                _size = newEnd - begin();
+            }
+            return f;
+        }
+        template <class... Args>
+        iterator emplace(const_iterator position, Args &&...args)
+        {
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "small_vector::emplace(): bad position");
+            size_type index = position - begin();
+            if (index == _size) {
+                emplace_back(std::forward<Args>(args)...);
+            }
+            else {
+                // args may refer to an element, which MakeRoom() would move.
+                value_type value(std::forward<Args>(args)...);
+                iterator p = MakeRoom(index, 1);
+                *p = std::move(value);
+                ++_size;
+            }
+            return begin() + index;
+        }
+        template <class... Args>
+        reference emplace_back(Args && ... args)
+        {
+            if (_size == _capacity)
+                return GrowAndEmplaceBack(std::forward<Args>(args)...);
+            Construct(end(), std::forward<Args>(args)...);
+            ++_size;
+            return back();
+        }
+        // single element insert()
+        iterator insert(const_iterator position, const value_type &val)
+        {
+            return emplace(position, val);
+        }
+        // move insert()
+        iterator insert(const_iterator position, value_type &&val)
+        {
+            return emplace(position, std::move(val));
+        }
+        // fill insert
+        iterator insert(const_iterator position, size_type n, const value_type &val)
+        {
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "small_vector::insert(): bad position");
+            size_type index = position - begin();
+            if (n) {
+                value_type copy(val);   // val may be an element
+                iterator p = MakeRoom(index, n);
+                for (iterator i = p; i < p + n; ++i)
+                    FillCell(i, copy);
+                _size += n;
+            }
+            return begin() + index;
+        }
+        // range insert()
+        template <class Iter,
+                  typename = RequireInputIter<Iter>>
+        iterator insert(const_iterator position, Iter first, Iter last)
+        {
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "small_vector::insert(): bad position");
+            size_type index = position - begin();
+            size_type oldSize = _size;
+            Append(first, last, typename std::iterator_traits<Iter>::iterator_category());
+            std::rotate(begin() + index, begin() + oldSize, end());
+            return begin() + index;
+        }
+        // initializer list insert()
+        iterator insert(const_iterator position, std::initializer_list<value_type> il)
+        {
+            return insert(position, il.begin(), il.end());
+        }
+        void resize(size_type n, const value_type &val)
+        {
+            while (n < size())
+                pop_back();
+            if (size() < n)
+                insert(end(), n - size(), val);
+        }
+        void resize(size_type n)
+        {
+            while (n < size())
+                pop_back();
+            reserve(n);
+            while (size() < n)
+                emplace_back();
+        }
+        void swap(this_type &x) noexcept
+        {
+            std::swap(*this, x);
+        }
+        //
+        //******* Private member functions:
+        //
+    private:
+        using storage_type =
+            std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
+        template <class, unsigned> friend class small_vector;
+        pointer _data;          // Inline() or a heap buffer
+        size_type _size;
+        size_type _capacity;
+        storage_type _elem[N];
+
+        pointer Inline() noexcept { return reinterpret_cast<pointer>(_elem); }
+        const_pointer Inline() const noexcept { return reinterpret_cast<const_pointer>(_elem); }
+        static pointer Allocate(size_type n)
+        {
+            return reinterpret_cast<pointer>(new storage_type[n]);
+        }
+        static void Free(pointer p) noexcept
+        {
+            delete[] reinterpret_cast<storage_type *>(p);
+        }
+        // Free the heap buffer, if any.  The elements must be destroyed.
+        void Release() noexcept
+        {
+            if (!is_inline())
+                Free(_data);
+        }
+        static void Verify(bool cond)
+        {
+            if (!cond)
+                throw std::out_of_range("small_vector range error");
+        }
+        // Return the capacity to grow to when at least n is needed.
+        size_type NewCapacity(size_type n) const noexcept
+        {
+            return std::max(n, 2 * _capacity);
+        }
+        // Move the elements to newData, which has room for newCapacity
+        // elements, and release the old buffer.  The elements are copied
+        // if their move constructor may throw, so if a copy throws, the
+        // copies are destroyed and the vector is unchanged.  The caller
+        // frees newData.
+        void MoveTo(pointer newData, size_type newCapacity)
+        {
+            size_type i = 0;
+            try {
+                for (; i < _size; ++i)
+                    Construct(newData + i, std::move_if_noexcept(_data[i]));
+            }
+            catch (...) {
+                while (i)
+                    Destroy(newData + --i);
+                throw;
+            }
+            for (i = 0; i < _size; ++i)
+                Destroy(_data + i);
+            Release();
+            _data = newData;
+            _capacity = newCapacity;
+        }
+        // Move the elements to a new heap buffer of newCapacity.
+        void MoveToHeap(size_type newCapacity)
+        {
+            pointer newData = Allocate(newCapacity);
+            try {
+                MoveTo(newData, newCapacity);
+            }
+            catch (...) {
+                Free(newData);
+                throw;
+            }
+        }
+        // Make the capacity at least n.  Invalidates all iterators.
+        void Grow(size_type n)
+        {
+            MoveToHeap(NewCapacity(n));
+        }
+        // Called by emplace_back() when full.  The new element is constructed
+        // in the new buffer before the others are moved, as args may refer
+        // to one of them.
+        template <class... Args>
+        reference GrowAndEmplaceBack(Args && ... args)
+        {
+            size_type newCapacity = NewCapacity(_size + 1);
+            pointer newData = Allocate(newCapacity);
+            try {
+                Construct(newData + _size, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                Free(newData);
+                throw;
+            }
+            try {
+                MoveTo(newData, newCapacity);
+            }
+            catch (...) {
+                Destroy(newData + _size);
+                Free(newData);
+                throw;
+            }
+            ++_size;
+            return back();
+        }
+        // Make n empty cells at index, growing if needed, and return
+        // a pointer to the first.  Does not update _size.
+        iterator MakeRoom(size_type index, size_type n)
+        {
+            if (_capacity < _size + n)
+                Grow(_size + n);
+            iterator p = begin() + index;
+            size_type nu = std::min(size_type(end() - p), n);
+            // fill the uninitialized target cells by move construction
+            for (iterator src = end()-nu; src < end(); src++)
+                Construct(src + n , std::move(*src));
+            // shift elements to previously occupied cells by move assignment
+            std::move_backward(p, end() - nu, end());
+            return p;
+        }
+        template <class Arg>
+        void FillCell(iterator pos, const Arg &arg)
+        {
+            if (pos < end())
+                // fill previously occupied cell using assignment
+                (*pos) = value_type(arg);
+            else
+                // fill unoccupied cell in place by constructon
+                Construct(pos, arg);
+        }
+        template <class FwdIter>
+        void Append(FwdIter first, FwdIter last, std::forward_iterator_tag)
+        {
+            size_type n = std::distance(first, last);
+            if (_capacity < _size + n)
+                Grow(_size + n);
+            for (; first != last; ++first)
+                Construct(_data + _size++, *first);
+        }
+        template <class InpIter>
+        void Append(InpIter first, InpIter last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+        // Take donor's elements, leaving it empty.  This must be empty.
+        // If donor's elements are inline, they are moved one at a time,
+        // which may grow this vector first, so this may throw.
+        template <unsigned N1>
+        void TakeFrom(small_vector<T, N1> &donor)
+        {
+            if (!donor.is_inline()) {
+                Release();
+                _data = donor._data;
+                _capacity = donor._capacity;
+                _size = donor._size;
+                donor._data = donor.Inline();
+                donor._capacity = N1;
+                donor._size = 0;
+            }
+            else {
+                if (_capacity < donor._size)
+                    Grow(donor._size);
+                for (; _size < donor._size; ++_size)
+                    Construct(_data + _size, std::move(donor._data[_size]));
+                donor.clear();
+            }
+        }
+    };
+    //
+    //*******  Non-member overloads
+    //
+    template <class T, unsigned N0, unsigned N1>
+    bool operator==(const small_vector<T, N0> &lhs, const small_vector<T, N1> &rhs) noexcept
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        return EqualElements(lhs.data(), rhs.data(), lhs.size());
+    }
+    template <class T, unsigned N0, unsigned N1>
+    bool operator!=(const small_vector<T, N0> &lhs, const small_vector<T, N1> &rhs) noexcept
+    {
+        return !(rhs == lhs);
+    }
+    template <class T, unsigned N0, unsigned N1>
+    bool operator<(const small_vector<T, N0> &lhs, const small_vector<T, N1> &rhs) noexcept
+    {
+        return LessElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+    }
+    template <class T, unsigned N0, unsigned N1>
+    bool operator<=(const small_vector<T, N0> &lhs, const small_vector<T, N1> &rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+    template <class T, unsigned N0, unsigned N1>
+    bool operator>(const small_vector<T, N0> &lhs, const small_vector<T, N1> &rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+    template <class T, unsigned N0, unsigned N1>
+    bool operator>=(const small_vector<T, N0> &lhs, const small_vector<T, N1> &rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+#ifdef FRYSTL_HAS_THREE_WAY
+    template <class T, unsigned N0, unsigned N1>
+    auto operator<=>(const small_vector<T, N0> &lhs, const small_vector<T, N1> &rhs)
+    {
+        return ThreeWayElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+    }
+#endif
+    template <class T, unsigned N>
+    void swap(small_vector<T, N> &a, small_vector<T, N> &b) noexcept
+    {
+        a.swap(b);
+    }
+    // Erase the elements of c for which pred returns true, keeping the
+    // order of the others, in one pass.  Return the number erased.
+    template <class T, unsigned N, class Pred>
+    size_t erase_if(small_vector<T, N> &c, Pred pred)
+    {
+        return EraseIf(c, pred);
+    }
+    // Erase the elements of c at the positions in indices, which must be
+    // sorted in ascending order, keeping the order of the others, in one
+    // pass.  Return the number erased.
+    template <class T, unsigned N, class Indices>
+    size_t erase_indices(small_vector<T, N> &c, const Indices &indices)
+    {
+        using std::begin;
+        using std::end;
+        return EraseIndices(c, begin(indices), end(indices));
+    }
+}       // namespace frystl
+
+namespace std
+{
+    // Hash the elements of a small_vector.  See frystl-hash.hpp.
+    template <class T, unsigned N>
+    struct hash<frystl::small_vector<T, N>>
+    {
+        size_t operator()(const frystl::small_vector<T, N> &c) const
+        {
+            return size_t(frystl::HashRange(c.data(), c.size()));
+        }
+    };
+}       // namespace std
+#endif  // ndef FRYSTL_SMALL_VECTOR
@@ -0,0 +1,205 @@
+// Template class static_append_buffer
+//
+// static_append_buffer<T,Capacity> is a list of up to Capacity elements
+// in inline storage, like a static_vector, to which any number of
+// threads may append at once without locking.  A writer claims an
+// index with an atomic fetch-add, constructs its element there, and
+// marks the slot ready.  The committed count is the length of the
+// prefix of ready slots; the writer that fills the slot at its end
+// advances it, past any later slots already filled.  Readers may use
+// size(), operator[], begin() and end() at any time, while writers
+// append; they see the committed prefix, whose elements are complete.
+//
+// try_push_back() and try_emplace_back() report overflow by returning
+// false or nullptr instead of failing an assertion.  Each failed claim
+// still increments the claim counter, so claimed() may exceed Capacity.
+//
+// Appends are lock-free, but an element becomes visible only when the
+// elements before it are complete, so a writer that stops between
+// claiming and constructing holds up the committed count.  For that
+// reason the constructor an append uses must be noexcept; a throw
+// would leave a claimed slot that is never marked ready, hiding every
+// later element from readers.
+//
+// clear(), the destructor, and moving elements out are not safe while
+// writers are appending.  A static_append_buffer cannot be copied or
+// moved.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_STATIC_APPEND_BUFFER
+#define FRYSTL_STATIC_APPEND_BUFFER
+#include <atomic>
+#include <cstdint>      // uint32_t
+#include <cstddef>      // ptrdiff_t
+#include <iterator>     // reverse_iterator
+#include <stdexcept>    // out_of_range
+#include <type_traits>  // aligned_storage_t, is_nothrow_constructible
+#include <utility>      // forward, move
+#include "frystl-defines.hpp"
+
+namespace frystl
+{
+    template <class T, unsigned Capacity>
+    class static_append_buffer
+    {
+    public:
+        using this_type = static_append_buffer<T, Capacity>;
+        using value_type = T;
+        using size_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        //
+        //******* Public member functions:
+        //
+        static_append_buffer() noexcept
+            : _claimed(0)
+            , _committed(0)
+        {
+            for (auto &ready : _ready)
+                ready.store(false, std::memory_order_relaxed);
+        }
+        static_append_buffer(const this_type &) = delete;
+        this_type &operator=(const this_type &) = delete;
+        ~static_append_buffer() noexcept
+        {
+            clear();
+        }
+        //
+        //  Appending, from any number of threads
+        //
+        // Construct an element from args at the next free index and
+        // return a pointer to it, or return nullptr if the buffer is full.
+        template <class... Args>
+        T *try_emplace_back(Args &&... args) noexcept
+        {
+            static_assert(std::is_nothrow_constructible<T, Args &&...>::value,
+                "static_append_buffer requires a noexcept constructor");
+            size_type i = _claimed.fetch_add(1, std::memory_order_relaxed);
+            if (i >= Capacity)
+                return nullptr;
+            T *p = Data() + i;
+            Construct(p, std::forward<Args>(args)...);
+            Publish(i);
+            return p;
+        }
+        bool try_push_back(const T &value) noexcept { return try_emplace_back(value) != nullptr; }
+        bool try_push_back(T &&value) noexcept { return try_emplace_back(std::move(value)) != nullptr; }
+        //
+        //  Reading the committed elements, from any thread
+        //
+        // The number of committed elements
+        size_type size() const noexcept { return _committed.load(std::memory_order_acquire); }
+        bool empty() const noexcept { return size() == 0; }
+        constexpr size_type capacity() const noexcept { return Capacity; }
+        constexpr size_type max_size() const noexcept { return Capacity; }
+        // The number of claims made, successful or not
+        size_type claimed() const noexcept { return _claimed.load(std::memory_order_relaxed); }
+        // True if a claim has failed since the last clear()
+        bool overflowed() const noexcept { return claimed() > Capacity; }
+        T &operator[](size_type i) noexcept
+        {
+            FRYSTL_ASSERT2(i < size(), "static_append_buffer index out of range");
+            return Data()[i];
+        }
+        const T &operator[](size_type i) const noexcept
+        {
+            FRYSTL_ASSERT2(i < size(), "static_append_buffer index out of range");
+            return Data()[i];
+        }
+        T &at(size_type i)
+        {
+            Verify(i < size());
+            return Data()[i];
+        }
+        const T &at(size_type i) const
+        {
+            Verify(i < size());
+            return Data()[i];
+        }
+        T *data() noexcept { return Data(); }
+        const T *data() const noexcept { return Data(); }
+        // Iterators over the elements committed when end() is called
+        iterator begin() noexcept { return Data(); }
+        const_iterator begin() const noexcept { return Data(); }
+        iterator end() noexcept { return Data() + size(); }
+        const_iterator end() const noexcept { return Data() + size(); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        //
+        //  Not safe while writers are appending
+        //
+        // Destroy the elements and make the buffer empty.
+        void clear() noexcept
+        {
+            size_type n = size();
+            for (size_type i = 0; i < n; ++i) {
+                Destroy(Data() + i);
+                _ready[i].store(false, std::memory_order_relaxed);
+            }
+            _committed.store(0, std::memory_order_relaxed);
+            _claimed.store(0, std::memory_order_release);
+        }
+
+    private:
+        std::aligned_storage_t<sizeof(T), alignof(T)> _elems[Capacity];
+        std::atomic<bool> _ready[Capacity];
+        std::atomic<size_type> _claimed;
+        std::atomic<size_type> _committed;
+
+        T *Data() noexcept { return reinterpret_cast<T *>(_elems); }
+        const T *Data() const noexcept { return reinterpret_cast<const T *>(_elems); }
+        // Mark slot i ready and advance the committed count past the ready
+        // slots at its end.  The store of the flag and the loads that
+        // follow are sequentially consistent, so of two writers filling
+        // adjacent slots, at least one sees the other's flag.  Every
+        // claimed slot below Capacity must be published, or the count
+        // stops there for good.
+        void Publish(size_type i) noexcept
+        {
+            _ready[i].store(true);
+            size_type c = _committed.load();
+            while (c < Capacity && _ready[c].load()) {
+                if (_committed.compare_exchange_weak(c, c + 1))
+                    ++c;
+            }
+        }
+        static void Verify(bool cond)
+        {
+            if (!cond)
+                throw std::out_of_range("static_append_buffer range error");
+        }
+    };
+}       // namespace frystl
+#endif  // ndef FRYSTL_STATIC_APPEND_BUFFER
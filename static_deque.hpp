@@ -29,6 +29,9 @@
 // through all operations except erase() and insert() unless the
 // operation slides data to avoid overflow.
 //
+// The positions of the front and back are stored as offsets in the
+// smallest unsigned type that can hold Capacity.
+//
 /*
 MIT License
 
@@ -60,6 +63,8 @@ SOFTWARE.
 #include <stdexcept> // for std::out_of_range
 #include <cstdint>   // uint32_t etc.
 #include "frystl-defines.hpp"
+#include "frystl-hash.hpp"
+#include "frystl-deque.hpp"
 
 namespace frystl
 {
@@ -81,15 +86,15 @@ namespace frystl
 
         // default c'tor
         static_deque() noexcept
-            : _begin(Centered(1)), _end(_begin)
+            : _front(Centered(1)), _back(_front)
         {
         }
         // fill c'tor with explicit value
         static_deque(size_type count, const_reference value)
-            : _begin(Centered(count)), _end(_begin + count)
+            : _front(Centered(count)), _back(_front + count)
         {
             FRYSTL_ASSERT2(count <= capacity(),"Overflow in static_deque");
-            for (pointer p = _begin; p < _end; ++p)
+            for (pointer p = begin(); p < end(); ++p)
                 new (p) value_type(value);
         }
         // fill c'tor with default value
@@ -110,16 +115,16 @@ namespace frystl
         // copy constructors
 
         static_deque(const this_type &donor)
-            : _begin(Centered(donor.size()))
-            , _end(_begin)
+            : _front(Centered(donor.size()))
+            , _back(_front)
         {
             for (auto &m : donor)
                 emplace_back(m);
         }
         template <unsigned C1>
         static_deque(const static_deque<value_type, C1> &donor)
-            : _begin(Centered(donor.size()))
-            , _end(_begin)
+            : _front(Centered(donor.size()))
+            , _back(_front)
         {
             FRYSTL_ASSERT2(donor.size() <= capacity(), "Too big");
             for (auto &m : donor)
@@ -130,8 +135,8 @@ namespace frystl
         // the existing static_deque.  It leaves the moved-from object
         // empty.
         static_deque(this_type &&donor) noexcept
-            : _begin(Centered(donor.size()))
-            , _end(_begin)
+            : _front(Centered(donor.size()))
+            , _back(_front)
         {
             for (auto &m : donor)
                 emplace_back(std::move(m));
@@ -139,8 +144,8 @@ namespace frystl
         }
         template <unsigned C1>
         static_deque(static_deque<value_type, C1> &&donor) noexcept
-            : _begin(Centered(donor.size()))
-            , _end(_begin)
+            : _front(Centered(donor.size()))
+            , _back(_front)
         {
             FRYSTL_ASSERT2(donor.size() <= capacity(),"Overflow");
             for (auto &m : donor)
@@ -149,8 +154,8 @@ namespace frystl
         }
         // initializer list constructor
         static_deque(std::initializer_list<value_type> il)
-            : _begin(Centered(il.size()))
-            , _end(_begin)
+            : _front(Centered(il.size()))
+            , _back(_front)
         {
             FRYSTL_ASSERT2(il.size() <= capacity(),"Overflow");
             for (auto &value : il)
@@ -163,15 +168,15 @@ namespace frystl
         void clear() noexcept
         {
             DestroyAll();
-            _begin = _end = Centered(1);
+            _front = _back = Centered(1);
         }
         size_type size() const noexcept
         {
-            return _end - _begin;
+            return _back - _front;
         }
         bool empty() const noexcept
         {
-            return _begin == _end;
+            return _front == _back;
         }
         size_type capacity() const noexcept
         {
@@ -181,111 +186,111 @@ namespace frystl
         [[maybe_unused]] reference emplace_front(Args&&... args)
         {
             FRYSTL_ASSERT2(size() < capacity(),"static_deque overflow");
-            if (_begin == FirstSpace()) SlideAllToBack();
-            Construct(_begin-1, std::forward<Args>(args)...);
-            --_begin;
-            return *_begin;
+            if (begin() == FirstSpace()) SlideAllToBack();
+            Construct(begin()-1, std::forward<Args>(args)...);
+            --_front;
+            return *begin();
         }
         void push_front(const_reference t)
         {
             FRYSTL_ASSERT2(size() < capacity(),"static_deque overflow");
-            if (_begin == FirstSpace()) SlideAllToBack();
-            Construct(_begin-1, t);
-            --_begin;
+            if (begin() == FirstSpace()) SlideAllToBack();
+            Construct(begin()-1, t);
+            --_front;
         }
         void push_front(value_type&& t) noexcept
         {
             FRYSTL_ASSERT2(size() < capacity(),"static_deque overflow");
-            if (_begin == FirstSpace()) SlideAllToBack();
-            Construct(_begin-1, std::move(t));
-            --_begin;
+            if (begin() == FirstSpace()) SlideAllToBack();
+            Construct(begin()-1, std::move(t));
+            --_front;
         }
         void pop_front() noexcept
         {
-            FRYSTL_ASSERT2(_begin < _end, "pop_front called on empty static_deque");
-            ++_begin;
-            Destroy(_begin-1);
+            FRYSTL_ASSERT2(_front < _back, "pop_front called on empty static_deque");
+            ++_front;
+            Destroy(begin()-1);
         }
         template <class... Args>
         [[maybe_unused]] reference emplace_back(Args&&... args)
         {
             FRYSTL_ASSERT2(size() < capacity(),"static_deque overflow");
-            if (_end == PastLastSpace()) SlideAllToFront();
-            Construct(_end,std::forward<Args>(args)...);
-            ++_end;
-            return *(_end-1);
+            if (end() == PastLastSpace()) SlideAllToFront();
+            Construct(end(),std::forward<Args>(args)...);
+            ++_back;
+            return *(end()-1);
         }
         void push_back(const_reference t) 
         {
             FRYSTL_ASSERT2(size() < capacity(),"static_deque overflow");
-            if (_end == PastLastSpace()) SlideAllToFront();
-            Construct(_end, t);
-            ++_end;
+            if (end() == PastLastSpace()) SlideAllToFront();
+            Construct(end(), t);
+            ++_back;
         }
         void push_back(value_type && t) noexcept
         {
             FRYSTL_ASSERT2(size() < capacity(),"static_deque overflow");
-            if (_end == PastLastSpace()) SlideAllToFront();
-            Construct(_end, std::move(t));
-            ++_end;
+            if (end() == PastLastSpace()) SlideAllToFront();
+            Construct(end(), std::move(t));
+            ++_back;
         }
         void pop_back() noexcept
         {
-            FRYSTL_ASSERT2(_begin < _end,"pop_back() called on empty static_deque");
-            --_end;
-            Destroy(_end);
+            FRYSTL_ASSERT2(_front < _back,"pop_back() called on empty static_deque");
+            --_back;
+            Destroy(end());
         }
 
         reference operator[](size_type index) noexcept
         {
-            FRYSTL_ASSERT2(_begin + index < _end,"Index out of range");
-            return *(_begin + index);
+            FRYSTL_ASSERT2(index < size(),"Index out of range");
+            return *(begin() + index);
         }
         const_reference operator[](size_type index) const noexcept
         {
-            FRYSTL_ASSERT2(_begin + index < _end,"Index out of range");
-            return *(_begin + index);
+            FRYSTL_ASSERT2(index < size(),"Index out of range");
+            return *(begin() + index);
         }
 
         pointer data() noexcept 
         { 
-            return _begin; 
+            return begin(); 
         }
 
         const_pointer data() const noexcept
         { 
-            return _begin; 
+            return begin(); 
         }
 
         reference at(size_type index)
         {
-            Verify(_begin + index < _end);
-            return *(_begin + index);
+            Verify(index < size());
+            return *(begin() + index);
         }
         const_reference at(size_type index) const
         {
-            Verify(_begin + index < _end);
-            return *(_begin + index);
+            Verify(index < size());
+            return *(begin() + index);
         }
         reference front() noexcept
         {
-            FRYSTL_ASSERT2(_begin < _end,"front() called on empty static_deque");
-            return *_begin;
+            FRYSTL_ASSERT2(_front < _back,"front() called on empty static_deque");
+            return *begin();
         }
         const_reference front() const noexcept
         {
-            FRYSTL_ASSERT2(_begin < _end,"front() called on empty static_deque");
-            return *_begin;
+            FRYSTL_ASSERT2(_front < _back,"front() called on empty static_deque");
+            return *begin();
         }
         reference back() noexcept
         {
-            FRYSTL_ASSERT2(_begin < _end,"back() called on empty static_deque");
-            return *(_end-1);
+            FRYSTL_ASSERT2(_front < _back,"back() called on empty static_deque");
+            return *(end()-1);
         }
         const_reference back() const noexcept
         {
-            FRYSTL_ASSERT2(_begin < _end,"back() called on empty static_deque");
-            return *(_end-1);
+            FRYSTL_ASSERT2(_front < _back,"back() called on empty static_deque");
+            return *(end()-1);
         }
         template <class... Args>
         iterator emplace(const_iterator pos, Args && ... args)
@@ -293,11 +298,11 @@ namespace frystl
             FRYSTL_ASSERT2(cbegin() <= pos && pos <= cend(),
                 "Invalid position in static_deque::emplace()");
             unsigned offset = pos - cbegin();
-            if (pos == _begin) emplace_front(std::forward<Args>(args)...);
-            else if (pos == _end) emplace_back(std::forward<Args>(args)...);
+            if (pos == begin()) emplace_front(std::forward<Args>(args)...);
+            else if (pos == end()) emplace_back(std::forward<Args>(args)...);
             else {
-                iterator p = MakeRoom(pos,1);
-                Construct(p,std::forward<Args>(args)...);
+                FillRoom(MakeRoom(pos,1), 1,
+                    [&](pointer p) { Construct(p, std::forward<Args>(args)...); });
             }
             return begin()+offset;
         }
@@ -307,7 +312,7 @@ namespace frystl
         {
             FRYSTL_ASSERT2(n <= capacity(),"Overflow in static_deque::assign()");
             DestroyAll(); 
-            _begin = _end = Centered(n);
+            _front = _back = Centered(n);
             while (size() < n)
                 push_back(val);
         }
@@ -315,7 +320,7 @@ namespace frystl
         {
             FRYSTL_ASSERT2(x.size() <= capacity(),"Overflow in static_deque::assign()");
             DestroyAll();
-            _begin = _end = Centered(x.size());
+            _front = _back = Centered(x.size());
             for (auto &a : x)
                 emplace_back(a);
         }
@@ -362,13 +367,8 @@ namespace frystl
         {
             FRYSTL_ASSERT2(begin() <= position && position <= end(),
                 "Bad position argument in static_deque::insert()");
-            iterator b = begin();
-            iterator e = end();
             iterator t = MakeRoom(position, 1);
-            if (b <= t && t < e)
-                (*t) = std::move(val);
-            else 
-                Construct(t, std::move(val));
+            FillRoom(t, 1, [&val](pointer p) { Construct(p, std::move(val)); });
             return t;
         }
         // fill insert
@@ -376,14 +376,10 @@ namespace frystl
         {
             FRYSTL_ASSERT2(begin() <= position && position <= end(),
                 "Bad position argument in static_deque::insert()");
-            iterator b = begin();
-            iterator e = end();
+            value_type copy(val);   // val may be an element
             iterator t = MakeRoom(position, n);
             // copy val n times into newly available cells
-            for (iterator i = t; i < t + n; ++i)
-            {
-                FillCell(b, e, i, val);
-            }
+            FillRoom(t, n, [&copy](pointer p) { Construct(p, copy); });
             return t;
         }
         // range insert()
@@ -412,15 +408,10 @@ namespace frystl
                 DAIter last,
                 std::random_access_iterator_tag)
             {
-                iterator b = begin();
-                iterator e = end();
-                int n = last-first;
+                size_type n = last-first;
                 iterator t = MakeRoom(position,n);
-                iterator result = t;
-                while (first != last) {
-                    FillCell(b, e, t++, *first++);
-                }
-                return result;
+                FillRoom(t, n, [&first](pointer p) { Construct(p, *first++); });
+                return t;
             }
         public:
         template <class Iter,typename = RequireInputIter<Iter>>
@@ -435,15 +426,10 @@ namespace frystl
             size_type n = il.size();
             FRYSTL_ASSERT2(begin() <= position && position <= end(),
                 "Bad position argument in static_deque::insert()");
-            iterator b = begin();
-            iterator e = end();
             iterator t = MakeRoom(position, n);
             // copy il into newly available cells
             auto j = il.begin();
-            for (iterator i = t; i < t + n; ++i, ++j)
-            {
-                FillCell(b, e, i, *j);
-            }
+            FillRoom(t, n, [&j](pointer p) { Construct(p, *j++); });
             return t;
         }
         void resize(size_type n, const value_type &val)
@@ -459,8 +445,31 @@ namespace frystl
             FRYSTL_ASSERT2(n <= capacity(),"n too large in static_deque::resize(n)");
             while (n < size())
                 pop_back();
-            while (size() < n)
-                emplace_back();
+            FillBack(n - size(), [](pointer p) { Construct(p); });
+        }
+        // Like resize(n), but new elements are default-initialized, so
+        // if value_type is trivial they are left uninitialized.
+        void resize_default_init(size_type n)
+        {
+            FRYSTL_ASSERT2(n <= capacity(),"n too large in static_deque::resize_default_init(n)");
+            while (n < size())
+                pop_back();
+            FillBack(n - size(), [](pointer p) { DefaultConstruct(p); });
+        }
+        // Append the elements of rg, which may be any range with begin()
+        // and end(), such as a container.  If its iterators are forward
+        // iterators, capacity is checked and room is made once.
+        template <class Range>
+        void append_range(Range &&rg)
+        {
+            AppendRange(std::begin(rg), std::end(rg), typename std::iterator_traits<
+                decltype(std::begin(rg))>::iterator_category());
+        }
+        // Append n elements, each constructed from the value of f().
+        template <class Generator>
+        void generate_back(size_type n, Generator f)
+        {
+            FillBack(n, [&f](pointer p) { Construct(p, f()); });
         }
         void swap(this_type &x) noexcept
         {
@@ -470,43 +479,43 @@ namespace frystl
         {}                  // does nothing
         iterator begin() noexcept
         {
-            return _begin;
+            return FirstSpace() + _front;
         }
-        iterator end()
+        iterator end() noexcept
         {
-            return _end;
+            return FirstSpace() + _back;
         }
         const_iterator begin() const noexcept
         {
-            return _begin;
+            return FirstSpace() + _front;
         }
         const_iterator end() const noexcept
         {
-            return _end;
+            return FirstSpace() + _back;
         }
         const_iterator cbegin() noexcept
         {
-            return _begin;
+            return begin();
         }
         const_iterator cend() noexcept
         {
-            return _end;
+            return end();
         }
         reverse_iterator rbegin() noexcept
         {
-            return reverse_iterator(_end);
+            return reverse_iterator(end());
         }
         reverse_iterator rend() noexcept
         {
-            return reverse_iterator(_begin);
+            return reverse_iterator(begin());
         }
         const_reverse_iterator crbegin() const noexcept
         {
-            return const_reverse_iterator(_end);
+            return const_reverse_iterator(end());
         }
         const_reverse_iterator crend() const noexcept
         {
-            return const_reverse_iterator(_begin);
+            return const_reverse_iterator(begin());
         }
         iterator erase(const_iterator first, const_iterator last) noexcept
         {
@@ -518,18 +527,16 @@ namespace frystl
                 FRYSTL_ASSERT2(Dereferencable(last-1),"Bad arguments to static_deque::erase()");
                 const iterator f = const_cast<iterator>(first);
                 const iterator l = const_cast<iterator>(last);
-                unsigned nToErase = last-first;
-                for (iterator it = f; it < l; ++it)
-                    Destroy(it);
-                if (first-_begin < _end-last) {
-                    // Move the elements before first
-                    std::move_backward(_begin,f,l);
-                    _begin += nToErase;
+                DestroyRange(f, l);
+                if (first-begin() < end()-last) {
+                    // Slide the elements before first
+                    SlideRangeToBack(begin(), f, l);
+                    _front += l - f;
                     result = l;
                 } else {
-                    // Move the elements at and after last
-                    std::move(l, end(), f);
-                    _end -= nToErase;
+                    // Slide the elements at and after last
+                    SlideRangeToFront(l, end(), f);
+                    _back -= l - f;
                     result = f;
                 }
             }
@@ -539,12 +546,28 @@ namespace frystl
         {
             return erase(position, position+1);
         }
+        // Erase the element at position by moving the last element into
+        // its place.  Unlike erase(), this takes constant time but does
+        // not keep the order of the elements.
+        iterator erase_unordered(const_iterator position) noexcept
+        {
+            FRYSTL_ASSERT2(begin() <= position && position < end(),
+                "static_deque::erase_unordered(pos): pos out of range");
+            iterator p = const_cast<iterator>(position);
+            if (p != end() - 1)
+                *p = std::move(back());
+            pop_back();
+            return p;
+        }
 
     private:
         using storage_type =
             std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
-        pointer _begin;
-        pointer _end;
+        // _front and _back are the offsets of begin() and end() from
+        // the first cell.  They are stored as offsets rather than pointers
+        // to keep small deques small.
+        SmallestUnsigned<Capacity> _front;
+        SmallestUnsigned<Capacity> _back;
         storage_type _elem[Capacity];
 
         pointer FirstSpace() noexcept
@@ -579,25 +602,25 @@ namespace frystl
         }
         // Slide cells at and behind p to the back by n spaces.
         // Return an iterator pointing to the first cleared cell (p).
-        // Update _end.
+        // Update end().
         iterator MakeRoomAfter(iterator p, size_type n) noexcept
         {
-            SlideToBack(p,_end+n);
-            _end += n;
+            SlideRangeToBack(p, end(), end()+n);
+            _back += n;
             return p;
         }
         // Slide cells before p to the front by n spaces.
         // Return an iterator pointing to the first cleared cell (p-n).
-        // Update _begin.
+        // Update begin().
         iterator MakeRoomBefore(iterator p, size_type n) noexcept
         {
-            SlideToFront(p, _begin-n);
-            _begin -= n;
+            SlideRangeToFront(begin(), p, begin()-n);
+            _front -= n;
             return p-n;
         }
-        // Slide cells such that there are n empty cells between 
-        // constp and constp+n.  The order of all other cells
-        // is preserved.  Update _begin or _end or both. 
+        // Slide cells such that there are n empty, unconstructed cells
+        // between constp and constp+n.  The order of all other cells
+        // is preserved.  Update begin() or end() or both. 
         // Return an iterator pointing to the first cleared space, which
         // may be different from constp.
         iterator MakeRoom(const_iterator constp, size_type n) noexcept
@@ -606,41 +629,79 @@ namespace frystl
             iterator p = const_cast<iterator>(constp);
             if (end()-p < p-begin() && end()+n <= PastLastSpace())
                 return MakeRoomAfter(p, n);
-            else if (FirstSpace() + n <= _begin)
+            else if (FirstSpace() + n <= begin())
                 return MakeRoomBefore(p, n);
             else {
                 // Neither side has enough extra space
-                p -= _begin - FirstSpace();
+                p -= begin() - FirstSpace();
                 SlideAllToFront();
                 return MakeRoomAfter(p, n);
             }
         }
-        // Return a pointer to the front end of a range of n cells centered
+        // Construct elements in the n cells at p that MakeRoom() opened
+        // by calling fill(q) for each cell q in order.  If a call throws,
+        // destroy the elements already constructed and close the gap.
+        template <class Fill>
+        void FillRoom(pointer p, size_type n, Fill fill)
+        {
+            pointer q = p;
+            try {
+                for (; q < p + n; ++q)
+                    fill(q);
+            }
+            catch (...) {
+                DestroyRange(p, q);
+                SlideRangeToFront(p + n, end(), p);
+                _back -= n;
+                throw;
+            }
+        }
+        // Make room for n elements after the last, sliding the elements
+        // if needed, and construct them by calling construct(p) for each
+        // new cell p in order.  If a call throws, the elements already 
+        // constructed are kept.
+        template <class Construct1>
+        void FillBack(size_type n, Construct1 construct)
+        {
+            if (n == 0) return;
+            pointer p = MakeRoom(end(), n);
+            pointer last = p + n;       // == end()
+            try {
+                for (; p < last; ++p)
+                    construct(p);
+            }
+            catch (...) {
+                _back = p - FirstSpace();
+                throw;
+            }
+        }
+        template <class FwdIter>
+        void AppendRange(FwdIter first, FwdIter last, std::forward_iterator_tag)
+        {
+            FillBack(std::distance(first, last), [&first](pointer p) { Construct(p, *first++); });
+        }
+        template <class InpIter>
+        void AppendRange(InpIter first, InpIter last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+        // Return the offset of the front end of a range of n cells centered
         // in the space.
-        constexpr pointer Centered(unsigned n) noexcept
+        static constexpr SmallestUnsigned<Capacity> Centered(unsigned n) noexcept
         {
-            return FirstSpace()+(Capacity-n)/2;
+            return (Capacity-n)/2;
         }
         template <class RAIter>
         void Center(RAIter begin, RAIter end, std::random_access_iterator_tag) noexcept
         {
             FRYSTL_ASSERT2(end-begin <= capacity(), "Overflow");
-            _begin = _end = Centered(end-begin);
+            _front = _back = Centered(end-begin);
         }
         template <class InpIter>
         void Center(InpIter begin, InpIter end, std::input_iterator_tag) noexcept
         {
-            _begin = _end = FirstSpace();
-        }
-        template <class... Args>
-        void FillCell(const_iterator b, const_iterator e, iterator pos, Args... args)
-        {
-            if (b <= pos && pos < e)
-                // fill previously occupied cell using assignment
-                (*pos)  = value_type(args...);
-            else 
-                // fill unoccupied cell in place by constructon
-                new (pos) value_type(args...);
+            _front = _back = 0;
         }
         void DestroyAll() noexcept
         {
@@ -649,33 +710,16 @@ namespace frystl
         void SlideAllToFront() noexcept
         {
             auto sz = size();
-            SlideToFront(_end, FirstSpace());
-            _begin = FirstSpace();
-            _end = _begin + sz;
-        }
-        void SlideToFront(pointer last, pointer tgt) noexcept
-        {
-            pointer src = _begin;
-            while (src != last && tgt < _begin) {
-                    new(tgt++) value_type(std::move(*src++));                
-            }
-            std::move(src, last, tgt);
+            SlideRangeToFront(begin(), end(), FirstSpace());
+            _front = 0;
+            _back = sz;
         }
         void SlideAllToBack() noexcept
         {
             auto sz = size();
-            SlideToBack(_begin, PastLastSpace());
-            _end = PastLastSpace();
-            _begin = _end-sz;
-        }
-        void SlideToBack(pointer first, pointer end) noexcept
-        {
-            pointer tgt = end;
-            pointer src = _end;
-            while (first < src && _end < tgt) {
-                new(--tgt) value_type(std::move(*--src));
-            }
-            std::move_backward(first, src, tgt);
+            SlideRangeToBack(begin(), end(), PastLastSpace());
+            _back = Capacity;
+            _front = Capacity - sz;
         }
     };
     //
@@ -686,7 +730,7 @@ namespace frystl
     {
         if (lhs.size() != rhs.size())
             return false;
-        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        return EqualElements(lhs.data(), rhs.data(), lhs.size());
     }
     template <class T, unsigned C0, unsigned C1>
     bool operator!=(const static_deque<T, C0> &lhs, const static_deque<T, C1> &rhs) noexcept
@@ -696,7 +740,7 @@ namespace frystl
     template <class T, unsigned C0, unsigned C1>
     bool operator<(const static_deque<T, C0> &lhs, const static_deque<T, C1> &rhs) noexcept
     {
-        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        return LessElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
     }
     template <class T, unsigned C0, unsigned C1>
     bool operator<=(const static_deque<T, C0> &lhs, const static_deque<T, C1> &rhs) noexcept
@@ -713,11 +757,48 @@ namespace frystl
     {
         return !(lhs < rhs);
     }
+#ifdef FRYSTL_HAS_THREE_WAY
+    template <class T, unsigned C0, unsigned C1>
+    auto operator<=>(const static_deque<T, C0> &lhs, const static_deque<T, C1> &rhs)
+    {
+        return ThreeWayElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+    }
+#endif
 
     template <class T, unsigned C>
     void swap(static_deque<T, C> &a, static_deque<T, C> &b) noexcept
     {
         a.swap(b);
     }
+    // Erase the elements of c for which pred returns true, keeping the
+    // order of the others, in one pass.  Return the number erased.
+    template <class T, unsigned C, class Pred>
+    size_t erase_if(static_deque<T, C> &c, Pred pred)
+    {
+        return EraseIf(c, pred);
+    }
+    // Erase the elements of c at the positions in indices, which must be
+    // sorted in ascending order, keeping the order of the others, in one
+    // pass.  Return the number erased.
+    template <class T, unsigned C, class Indices>
+    size_t erase_indices(static_deque<T, C> &c, const Indices &indices)
+    {
+        using std::begin;
+        using std::end;
+        return EraseIndices(c, begin(indices), end(indices));
+    }
 }       // namespace frystl
+
+namespace std
+{
+    // Hash the elements of a static_deque.  See frystl-hash.hpp.
+    template <class T, unsigned C>
+    struct hash<frystl::static_deque<T, C>>
+    {
+        size_t operator()(const frystl::static_deque<T, C> &c) const
+        {
+            return size_t(frystl::HashRange(c.data(), c.size()));
+        }
+    };
+}       // namespace std
 #endif  // ndef FRYSTL_STATIC_DEQUE
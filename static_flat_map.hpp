@@ -0,0 +1,473 @@
+// Template class static_flat_map
+//
+// static_flat_map<Key,T,Capacity,Compare,Layout> is a map of up to
+// Capacity keys, ordered by Compare, to values of type T.  Like
+// C++23's std::flat_map, it keeps the keys and the values in separate
+// arrays, here a static_vector<Key,Capacity> and a static_vector<T,
+// Capacity>, so searches touch only keys.  It uses no dynamic storage.
+// Layout is sorted_layout (the default) or eytzinger_layout; see
+// frystl-flat.hpp.
+//
+// It has most of the API of a std::map.  As in std::flat_map, an
+// iterator's reference is a std::pair<const Key&, T&> proxy rather
+// than a value_type&, and its operator-> returns an object holding
+// that pair.  Iterators are bidirectional.
+//
+// Lookups take logarithmic time; insertions and erasures take linear
+// time, and with eytzinger_layout move every key and value twice.  Any
+// insertion or erasure invalidates all iterators.  keys() and values()
+// return the static_vectors in layout order, which is ascending order
+// of keys for sorted_layout.
+//
+// As with static_vector, inserting into a full map fails an assertion
+// if FRYSTL_DEBUG is defined and is undefined behavior otherwise.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_STATIC_FLAT_MAP
+#define FRYSTL_STATIC_FLAT_MAP
+#include <cstdint>      // uint32_t
+#include <cstddef>      // ptrdiff_t
+#include <algorithm>    // lexicographical_compare, stable_sort, inplace_merge
+#include <functional>   // less
+#include <initializer_list>
+#include <iterator>     // bidirectional_iterator_tag, reverse_iterator
+#include <stdexcept>    // out_of_range
+#include <type_traits>  // conditional_t, enable_if_t
+#include <utility>      // pair, move, forward
+#include "static_vector.hpp"
+#include "frystl-flat.hpp"
+
+namespace frystl
+{
+    template <class Key, class T, unsigned Capacity,
+              class Compare = std::less<Key>, class Layout = sorted_layout>
+    class static_flat_map
+    {
+        template <bool Const> class Iterator;
+    public:
+        using this_type = static_flat_map<Key, T, Capacity, Compare, Layout>;
+        using key_container_type = static_vector<Key, Capacity>;
+        using mapped_container_type = static_vector<T, Capacity>;
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using key_compare = Compare;
+        using size_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key &, T &>;
+        using const_reference = std::pair<const Key &, const T &>;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        //
+        //******* Public member functions:
+        //
+        static_flat_map() noexcept = default;
+        explicit static_flat_map(const Compare &comp) noexcept
+            : _comp(comp)
+        {}
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        static_flat_map(InputIterator first, InputIterator last, const Compare &comp = Compare())
+            : _comp(comp)
+        {
+            insert(first, last);
+        }
+        static_flat_map(std::initializer_list<value_type> il, const Compare &comp = Compare())
+            : static_flat_map(il.begin(), il.end(), comp)
+        {}
+        this_type &operator=(std::initializer_list<value_type> il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        //
+        //  Element access
+        //
+        T &at(const Key &key)
+        {
+            iterator it = find(key);
+            Verify(it != end());
+            return it->second;
+        }
+        const T &at(const Key &key) const
+        {
+            const_iterator it = find(key);
+            Verify(it != end());
+            return it->second;
+        }
+        T &operator[](const Key &key) { return try_emplace(key).first->second; }
+        T &operator[](Key &&key) { return try_emplace(std::move(key)).first->second; }
+        //
+        //  Iterators
+        //
+        iterator begin() noexcept { return Iter(Layout::First(size())); }
+        const_iterator begin() const noexcept { return Iter(Layout::First(size())); }
+        iterator end() noexcept { return Iter(size()); }
+        const_iterator end() const noexcept { return Iter(size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+        //
+        //  Capacity
+        //
+        size_type size() const noexcept { return _keys.size(); }
+        bool empty() const noexcept { return _keys.empty(); }
+        constexpr size_type capacity() const noexcept { return Capacity; }
+        constexpr size_type max_size() const noexcept { return Capacity; }
+        //
+        //  Modifiers
+        //
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return try_emplace(value.first, value.second);
+        }
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return try_emplace(std::move(value.first), std::move(value.second));
+        }
+        // Insert the pairs [first, last) whose keys are not already
+        // present, sorting them all at once.  Of pairs with equivalent
+        // keys, the first is kept.
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        void insert(InputIterator first, InputIterator last)
+        {
+            ToSorted();
+            while (first != last) {
+                // Append as many as fit, then merge them in.
+                size_type n = size();
+                for (; first != last && size() < Capacity; ++first) {
+                    const auto &value = *first;
+                    _keys.push_back(value.first);
+                    _values.push_back(value.second);
+                }
+                MergeTail(n);
+                if (size() == Capacity) {
+                    for (; first != last; ++first)
+                        FRYSTL_ASSERT2(std::binary_search(_keys.begin(), _keys.end(), (*first).first, _comp),
+                            "static_flat_map::insert(): overflow");
+                }
+            }
+            FromSorted();
+        }
+        void insert(std::initializer_list<value_type> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&... args)
+        {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+        // If key is not present, insert it with a value constructed from
+        // args.  Otherwise do nothing.
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const Key &key, Args &&... args)
+        {
+            return TryEmplace(key, std::forward<Args>(args)...);
+        }
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(Key &&key, Args &&... args)
+        {
+            return TryEmplace(std::move(key), std::forward<Args>(args)...);
+        }
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj)
+        {
+            auto result = try_emplace(key, std::forward<M>(obj));
+            if (!result.second)
+                result.first->second = std::forward<M>(obj);
+            return result;
+        }
+        iterator erase(const_iterator position)
+        {
+            FRYSTL_ASSERT2(position != cend(), "static_flat_map::erase(end())");
+            return erase(position, std::next(position));
+        }
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            size_type n = size();
+            size_type r0 = Layout::RankOfSlot(first._slot, n);
+            size_type r1 = Layout::RankOfSlot(last._slot, n);
+            ToSorted();
+            _keys.erase(_keys.begin() + r0, _keys.begin() + r1);
+            _values.erase(_values.begin() + r0, _values.begin() + r1);
+            FromSorted();
+            return Iter(Layout::SlotOfRank(r0, size()));
+        }
+        size_type erase(const Key &key)
+        {
+            const_iterator it = find(key);
+            if (it == cend())
+                return 0;
+            erase(it);
+            return 1;
+        }
+        void clear() noexcept
+        {
+            _keys.clear();
+            _values.clear();
+        }
+        void swap(this_type &other) noexcept
+        {
+            _keys.swap(other._keys);
+            _values.swap(other._values);
+            std::swap(_comp, other._comp);
+        }
+        // Erase the elements e for which pred(e) is true, where e is a
+        // const_reference.  Return the number erased.
+        template <class Pred>
+        friend size_t erase_if(this_type &m, Pred pred)
+        {
+            m.ToSorted();
+            size_type n = m.size();
+            size_type kept = 0;
+            for (size_type i = 0; i < n; ++i) {
+                if (!pred(const_reference(m._keys[i], m._values[i]))) {
+                    if (kept != i) {
+                        m._keys[kept] = std::move(m._keys[i]);
+                        m._values[kept] = std::move(m._values[i]);
+                    }
+                    ++kept;
+                }
+            }
+            m._keys.erase(m._keys.begin() + kept, m._keys.end());
+            m._values.erase(m._values.begin() + kept, m._values.end());
+            m.FromSorted();
+            return n - kept;
+        }
+        //
+        //  Lookup
+        //
+        iterator find(const Key &key) { return Iter(Find(key)); }
+        const_iterator find(const Key &key) const { return Iter(Find(key)); }
+        size_type count(const Key &key) const { return Find(key) != size(); }
+        bool contains(const Key &key) const { return Find(key) != size(); }
+        iterator lower_bound(const Key &key)
+        {
+            return Iter(Layout::LowerBound(_keys.data(), size(), key, _comp));
+        }
+        const_iterator lower_bound(const Key &key) const
+        {
+            return Iter(Layout::LowerBound(_keys.data(), size(), key, _comp));
+        }
+        iterator upper_bound(const Key &key)
+        {
+            return Iter(Layout::UpperBound(_keys.data(), size(), key, _comp));
+        }
+        const_iterator upper_bound(const Key &key) const
+        {
+            return Iter(Layout::UpperBound(_keys.data(), size(), key, _comp));
+        }
+        std::pair<iterator, iterator> equal_range(const Key &key)
+        {
+            iterator first = find(key);
+            return {first == end() ? lower_bound(key) : first,
+                    first == end() ? lower_bound(key) : std::next(first)};
+        }
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            const_iterator first = find(key);
+            return {first == end() ? lower_bound(key) : first,
+                    first == end() ? lower_bound(key) : std::next(first)};
+        }
+        //
+        //  Observers
+        //
+        key_compare key_comp() const { return _comp; }
+        const key_container_type &keys() const noexcept { return _keys; }
+        const mapped_container_type &values() const noexcept { return _values; }
+
+    private:
+        template <bool Const>
+        class Iterator
+        {
+            using Mapped = std::conditional_t<Const, const T, T>;
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::pair<Key, T>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::pair<const Key &, Mapped &>;
+            using pointer = ArrowProxy<reference>;
+
+            Iterator() noexcept : _keys(nullptr), _values(nullptr), _slot(0), _n(0) {}
+            // Convert an iterator to a const_iterator
+            template <bool C = Const, typename = std::enable_if_t<C>>
+            Iterator(const Iterator<false> &it) noexcept
+                : _keys(it._keys), _values(it._values), _slot(it._slot), _n(it._n)
+            {}
+            reference operator*() const noexcept
+            {
+                return reference(_keys[_slot], _values[_slot]);
+            }
+            pointer operator->() const noexcept { return pointer{**this}; }
+            Iterator &operator++() noexcept
+            {
+                _slot = Layout::Next(_slot, _n);
+                return *this;
+            }
+            Iterator operator++(int) noexcept
+            {
+                Iterator r = *this;
+                ++*this;
+                return r;
+            }
+            Iterator &operator--() noexcept
+            {
+                _slot = Layout::Prev(_slot, _n);
+                return *this;
+            }
+            Iterator operator--(int) noexcept
+            {
+                Iterator r = *this;
+                --*this;
+                return r;
+            }
+            friend bool operator==(const Iterator &a, const Iterator &b) noexcept
+            {
+                return a._slot == b._slot;
+            }
+            friend bool operator!=(const Iterator &a, const Iterator &b) noexcept
+            {
+                return a._slot != b._slot;
+            }
+        private:
+            friend class static_flat_map;
+            friend class Iterator<true>;
+            Iterator(const Key *keys, Mapped *values, size_type slot, size_type n) noexcept
+                : _keys(keys), _values(values), _slot(slot), _n(n)
+            {}
+            const Key *_keys;
+            Mapped *_values;
+            size_type _slot;
+            size_type _n;
+        };
+
+        key_container_type _keys;
+        mapped_container_type _values;
+        Compare _comp;
+
+        static void Verify(bool cond)
+        {
+            if (!cond)
+                throw std::out_of_range("static_flat_map key not found");
+        }
+        iterator Iter(size_type slot) noexcept
+        {
+            return iterator(_keys.data(), _values.data(), slot, size());
+        }
+        const_iterator Iter(size_type slot) const noexcept
+        {
+            return const_iterator(_keys.data(), _values.data(), slot, size());
+        }
+        // The slot of key, or size() if it is not present
+        size_type Find(const Key &key) const
+        {
+            size_type slot = Layout::LowerBound(_keys.data(), size(), key, _comp);
+            if (slot != size() && _comp(key, _keys[slot]))
+                slot = size();
+            return slot;
+        }
+        void ToSorted() { Layout::ToSorted(_keys, _values); }
+        void FromSorted() { Layout::FromSorted(_keys, _values); }
+        // Sort the pairs from index n on by key, merge them with the
+        // sorted pairs before n, and drop the duplicates.  The merge
+        // sorts indices, and then each pair moves into place once, plus
+        // once per cycle of the permutation.
+        void MergeTail(size_type n)
+        {
+            uint32_t order[Capacity];
+            const size_type total = size();
+            for (size_type i = 0; i < total; ++i)
+                order[i] = i;
+            auto less = [this](size_type a, size_type b) { return _comp(_keys[a], _keys[b]); };
+            std::stable_sort(order + n, order + total, less);
+            std::inplace_merge(order, order + n, order + total, less);
+            // Move the first of each run of equivalent keys to the front.
+            size_type kept = 0;
+            for (size_type i = 0; i < total; ++i)
+                if (kept == 0 || _comp(_keys[order[kept - 1]], _keys[order[i]]))
+                    std::swap(order[kept++], order[i]);
+            FlatGather(order, total, _keys, _values);
+            _keys.erase(_keys.begin() + kept, _keys.end());
+            _values.erase(_values.begin() + kept, _values.end());
+        }
+        // Insert key and a value constructed from args at index rank of
+        // the sorted arrays.
+        template <class K, class... Args>
+        void InsertAt(size_type rank, K &&key, Args &&... args)
+        {
+            _keys.insert(_keys.begin() + rank, std::forward<K>(key));
+            _values.emplace(_values.begin() + rank, std::forward<Args>(args)...);
+        }
+        template <class K, class... Args>
+        std::pair<iterator, bool> TryEmplace(K &&key, Args &&... args)
+        {
+            size_type slot = Layout::LowerBound(_keys.data(), size(), key, _comp);
+            if (slot != size() && !_comp(key, _keys[slot]))
+                return {Iter(slot), false};
+            size_type rank = Layout::RankOfSlot(slot, size());
+            ToSorted();
+            InsertAt(rank, std::forward<K>(key), std::forward<Args>(args)...);
+            FromSorted();
+            return {Iter(Layout::SlotOfRank(rank, size())), true};
+        }
+    };
+    //
+    //*******  Non-member overloads
+    //
+    template <class K, class T, unsigned C0, unsigned C1, class Comp, class L>
+    bool operator==(const static_flat_map<K, T, C0, Comp, L> &lhs,
+        const static_flat_map<K, T, C1, Comp, L> &rhs)
+    {
+        // Maps of the same size have the same layout.
+        return lhs.keys() == rhs.keys() && lhs.values() == rhs.values();
+    }
+    template <class K, class T, unsigned C0, unsigned C1, class Comp, class L>
+    bool operator!=(const static_flat_map<K, T, C0, Comp, L> &lhs,
+        const static_flat_map<K, T, C1, Comp, L> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class K, class T, unsigned C0, unsigned C1, class Comp, class L>
+    bool operator<(const static_flat_map<K, T, C0, Comp, L> &lhs,
+        const static_flat_map<K, T, C1, Comp, L> &rhs)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    template <class K, class T, unsigned C, class Comp, class L>
+    void swap(static_flat_map<K, T, C, Comp, L> &a, static_flat_map<K, T, C, Comp, L> &b) noexcept
+    {
+        a.swap(b);
+    }
+}       // namespace frystl
+#endif  // ndef FRYSTL_STATIC_FLAT_MAP
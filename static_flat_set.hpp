@@ -0,0 +1,349 @@
+// Template class static_flat_set
+//
+// static_flat_set<Key,Capacity,Compare,Layout> is a set of up to
+// Capacity keys, ordered by Compare, kept in a static_vector<Key,
+// Capacity> and found by binary search, so it uses no dynamic storage.
+// It has most of the API of a std::set.  Layout is sorted_layout (the
+// default) or eytzinger_layout; see frystl-flat.hpp.
+//
+// Lookups take logarithmic time; insertions and erasures take linear
+// time, as the keys after the one inserted or erased move; with
+// eytzinger_layout every key moves, twice.  Building a set from a range
+// sorts once.  Any insertion or erasure invalidates
+// all iterators.  Iterators are bidirectional, and are const.
+//
+// keys() returns the static_vector of keys in layout order, which is
+// ascending order for sorted_layout.
+//
+// As with static_vector, inserting into a full set fails an assertion
+// if FRYSTL_DEBUG is defined and is undefined behavior otherwise.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_STATIC_FLAT_SET
+#define FRYSTL_STATIC_FLAT_SET
+#include <cstdint>      // uint32_t
+#include <cstddef>      // ptrdiff_t
+#include <algorithm>    // stable_sort, inplace_merge, unique, binary_search,
+                        // lexicographical_compare
+#include <functional>   // less
+#include <initializer_list>
+#include <iterator>     // bidirectional_iterator_tag, reverse_iterator
+#include <utility>      // pair, move, forward
+#include "static_vector.hpp"
+#include "frystl-flat.hpp"
+
+namespace frystl
+{
+    template <class Key, unsigned Capacity,
+              class Compare = std::less<Key>, class Layout = sorted_layout>
+    class static_flat_set
+    {
+    public:
+        using this_type = static_flat_set<Key, Capacity, Compare, Layout>;
+        using container_type = static_vector<Key, Capacity>;
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using value_compare = Compare;
+        using size_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = const Key &;
+        using const_reference = const Key &;
+        using pointer = const Key *;
+        using const_pointer = const Key *;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = Key;
+            using difference_type = std::ptrdiff_t;
+            using reference = const Key &;
+            using pointer = const Key *;
+
+            const_iterator() noexcept : _keys(nullptr), _slot(0), _n(0) {}
+            reference operator*() const noexcept { return _keys[_slot]; }
+            pointer operator->() const noexcept { return _keys + _slot; }
+            const_iterator &operator++() noexcept
+            {
+                _slot = Layout::Next(_slot, _n);
+                return *this;
+            }
+            const_iterator operator++(int) noexcept
+            {
+                const_iterator r = *this;
+                ++*this;
+                return r;
+            }
+            const_iterator &operator--() noexcept
+            {
+                _slot = Layout::Prev(_slot, _n);
+                return *this;
+            }
+            const_iterator operator--(int) noexcept
+            {
+                const_iterator r = *this;
+                --*this;
+                return r;
+            }
+            bool operator==(const const_iterator &other) const noexcept
+            {
+                return _slot == other._slot;
+            }
+            bool operator!=(const const_iterator &other) const noexcept
+            {
+                return _slot != other._slot;
+            }
+        private:
+            friend class static_flat_set;
+            const_iterator(const Key *keys, size_type slot, size_type n) noexcept
+                : _keys(keys), _slot(slot), _n(n)
+            {}
+            const Key *_keys;
+            size_type _slot;
+            size_type _n;
+        };
+        using iterator = const_iterator;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        //
+        //******* Public member functions:
+        //
+        static_flat_set() noexcept = default;
+        explicit static_flat_set(const Compare &comp) noexcept
+            : _comp(comp)
+        {}
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        static_flat_set(InputIterator first, InputIterator last, const Compare &comp = Compare())
+            : _comp(comp)
+        {
+            insert(first, last);
+        }
+        static_flat_set(std::initializer_list<Key> il, const Compare &comp = Compare())
+            : static_flat_set(il.begin(), il.end(), comp)
+        {}
+        this_type &operator=(std::initializer_list<Key> il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+        //
+        //  Iterators
+        //
+        const_iterator begin() const noexcept { return Iter(Layout::First(size())); }
+        const_iterator end() const noexcept { return Iter(size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+        //
+        //  Capacity
+        //
+        size_type size() const noexcept { return _keys.size(); }
+        bool empty() const noexcept { return _keys.empty(); }
+        constexpr size_type capacity() const noexcept { return Capacity; }
+        constexpr size_type max_size() const noexcept { return Capacity; }
+        //
+        //  Modifiers
+        //
+        std::pair<iterator, bool> insert(const Key &key)
+        {
+            return Insert(key);
+        }
+        std::pair<iterator, bool> insert(Key &&key)
+        {
+            return Insert(std::move(key));
+        }
+        // The hint is ignored.
+        iterator insert(const_iterator, const Key &key)
+        {
+            return Insert(key).first;
+        }
+        // Insert the keys [first, last) not already present, sorting
+        // them all at once.  Of equivalent keys, the first is kept.
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        void insert(InputIterator first, InputIterator last)
+        {
+            Layout::ToSorted(_keys);
+            while (first != last) {
+                // Append as many as fit, then merge them in.
+                size_type n = size();
+                for (; first != last && size() < Capacity; ++first)
+                    _keys.push_back(*first);
+                MergeTail(n);
+                if (size() == Capacity) {
+                    for (; first != last; ++first)
+                        FRYSTL_ASSERT2(std::binary_search(_keys.begin(), _keys.end(), *first, _comp),
+                            "static_flat_set::insert(): overflow");
+                }
+            }
+            Layout::FromSorted(_keys);
+        }
+        void insert(std::initializer_list<Key> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&... args)
+        {
+            return Insert(Key(std::forward<Args>(args)...));
+        }
+        iterator erase(const_iterator position)
+        {
+            FRYSTL_ASSERT2(position != end(), "static_flat_set::erase(end())");
+            return erase(position, std::next(position));
+        }
+        size_type erase(const Key &key)
+        {
+            const_iterator it = find(key);
+            if (it == end())
+                return 0;
+            erase(it);
+            return 1;
+        }
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            size_type n = size();
+            size_type r0 = Layout::RankOfSlot(first._slot, n);
+            size_type r1 = Layout::RankOfSlot(last._slot, n);
+            Layout::ToSorted(_keys);
+            _keys.erase(_keys.begin() + r0, _keys.begin() + r1);
+            Layout::FromSorted(_keys);
+            return Iter(Layout::SlotOfRank(r0, size()));
+        }
+        void clear() noexcept { _keys.clear(); }
+        void swap(this_type &other) noexcept
+        {
+            _keys.swap(other._keys);
+            std::swap(_comp, other._comp);
+        }
+        // Erase the keys for which pred is true.  Return the number erased.
+        template <class Pred>
+        friend size_t erase_if(this_type &s, Pred pred)
+        {
+            Layout::ToSorted(s._keys);
+            size_t n = EraseIf(s._keys, pred);
+            Layout::FromSorted(s._keys);
+            return n;
+        }
+        //
+        //  Lookup
+        //
+        const_iterator find(const Key &key) const
+        {
+            size_type slot = Layout::LowerBound(_keys.data(), size(), key, _comp);
+            if (slot != size() && _comp(key, _keys[slot]))
+                slot = size();
+            return Iter(slot);
+        }
+        size_type count(const Key &key) const { return find(key) != end(); }
+        bool contains(const Key &key) const { return find(key) != end(); }
+        const_iterator lower_bound(const Key &key) const
+        {
+            return Iter(Layout::LowerBound(_keys.data(), size(), key, _comp));
+        }
+        const_iterator upper_bound(const Key &key) const
+        {
+            return Iter(Layout::UpperBound(_keys.data(), size(), key, _comp));
+        }
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            const_iterator first = lower_bound(key);
+            const_iterator last = first;
+            if (last != end() && !_comp(key, *last))
+                ++last;
+            return {first, last};
+        }
+        //
+        //  Observers
+        //
+        key_compare key_comp() const { return _comp; }
+        value_compare value_comp() const { return _comp; }
+        const container_type &keys() const noexcept { return _keys; }
+
+    private:
+        container_type _keys;
+        Compare _comp;
+
+        // Sort the keys from index n on, merge them with the sorted keys
+        // before n, and drop the duplicates.
+        void MergeTail(size_type n)
+        {
+            auto less = [this](const Key &a, const Key &b) { return _comp(a, b); };
+            std::stable_sort(_keys.begin() + n, _keys.end(), less);
+            std::inplace_merge(_keys.begin(), _keys.begin() + n, _keys.end(), less);
+            auto equiv = [this](const Key &a, const Key &b) { return !_comp(a, b); };
+            _keys.erase(std::unique(_keys.begin(), _keys.end(), equiv), _keys.end());
+        }
+        const_iterator Iter(size_type slot) const noexcept
+        {
+            return const_iterator(_keys.data(), slot, size());
+        }
+        template <class K>
+        std::pair<iterator, bool> Insert(K &&key)
+        {
+            size_type slot = Layout::LowerBound(_keys.data(), size(), key, _comp);
+            if (slot != size() && !_comp(key, _keys[slot]))
+                return {Iter(slot), false};
+            size_type rank = Layout::RankOfSlot(slot, size());
+            Layout::ToSorted(_keys);
+            _keys.insert(_keys.begin() + rank, std::forward<K>(key));
+            Layout::FromSorted(_keys);
+            return {Iter(Layout::SlotOfRank(rank, size())), true};
+        }
+    };
+    //
+    //*******  Non-member overloads
+    //
+    template <class K, unsigned C0, unsigned C1, class Comp, class L>
+    bool operator==(const static_flat_set<K, C0, Comp, L> &lhs,
+        const static_flat_set<K, C1, Comp, L> &rhs)
+    {
+        // Sets of the same size have the same layout.
+        return lhs.keys() == rhs.keys();
+    }
+    template <class K, unsigned C0, unsigned C1, class Comp, class L>
+    bool operator!=(const static_flat_set<K, C0, Comp, L> &lhs,
+        const static_flat_set<K, C1, Comp, L> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class K, unsigned C0, unsigned C1, class Comp, class L>
+    bool operator<(const static_flat_set<K, C0, Comp, L> &lhs,
+        const static_flat_set<K, C1, Comp, L> &rhs)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    template <class K, unsigned C, class Comp, class L>
+    void swap(static_flat_set<K, C, Comp, L> &a, static_flat_set<K, C, Comp, L> &b) noexcept
+    {
+        a.swap(b);
+    }
+}       // namespace frystl
+#endif  // ndef FRYSTL_STATIC_FLAT_SET
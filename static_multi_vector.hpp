@@ -0,0 +1,441 @@
+// Template class static_multi_vector
+//
+// static_multi_vector<T,K,Capacity> holds K sequences of elements of
+// type T, with at most Capacity elements in all, packed one after
+// another in a single array with no dynamic storage.  An array of K
+// end offsets, each the smallest unsigned type that can hold Capacity,
+// marks where each sequence ends.  So the piles of a card game, which
+// are never all long at once, take the space of their total length
+// rather than K times the longest.
+//
+// T must be trivially copyable, and so is the static_multi_vector: it
+// can be copied, hashed and compared as a block of bytes.
+//
+// m[k] returns a sequence_ref, a view of sequence k with much of the
+// API of a static_vector: size(), begin(), end(), operator[], at(),
+// front(), back(), push_back(), emplace_back(), pop_back(), insert(),
+// erase(), resize() and clear().  A view of a const static_multi_vector
+// is a const_sequence_ref, which has only the const members.  The
+// same operations are members of the static_multi_vector, taking the
+// sequence number first.
+//
+// Adding or removing elements in sequence k moves the elements of the
+// sequences after k with memmove(), which for small elements and small
+// capacities costs little; it invalidates iterators into sequence k and
+// those after it.  move_back(from, n, to) moves the last n elements of
+// one sequence onto the back of another, moving only the elements
+// between them.
+//
+// Adding an element to a full static_multi_vector fails an assertion
+// if FRYSTL_DEBUG is defined and is undefined behavior otherwise.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_STATIC_MULTI_VECTOR
+#define FRYSTL_STATIC_MULTI_VECTOR
+#include <cstdint>      // uint32_t
+#include <cstddef>      // ptrdiff_t
+#include <cstring>      // memmove, memcpy
+#include <algorithm>    // rotate, equal, copy
+#include <functional>   // hash
+#include <iterator>     // reverse_iterator, distance
+#include <stdexcept>    // out_of_range
+#include <type_traits>  // aligned_storage_t, is_trivially_copyable
+#include <utility>      // forward
+#include "frystl-defines.hpp"
+#include "frystl-hash.hpp"
+
+namespace frystl
+{
+    template <class T, unsigned K, unsigned Capacity>
+    class static_multi_vector
+    {
+        static_assert(K > 0, "static_multi_vector needs at least one sequence");
+        static_assert(std::is_trivially_copyable<T>::value,
+            "static_multi_vector requires a trivially copyable type");
+    public:
+        using this_type = static_multi_vector<T, K, Capacity>;
+        using value_type = T;
+        using size_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        // A view of one sequence of a const static_multi_vector
+        class const_sequence_ref
+        {
+        public:
+            using value_type = T;
+            using size_type = uint32_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = const T &;
+            using const_reference = const T &;
+            using iterator = const T *;
+            using const_iterator = const T *;
+            using reverse_iterator = std::reverse_iterator<const_iterator>;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+            size_type size() const noexcept { return _owner->size(_k); }
+            bool empty() const noexcept { return size() == 0; }
+            // The most elements the sequence could hold, given the others
+            size_type capacity() const noexcept { return size() + _owner->available(); }
+            unsigned index() const noexcept { return _k; }
+            const_iterator begin() const noexcept { return _owner->Begin(_k); }
+            const_iterator end() const noexcept { return _owner->End(_k); }
+            const_iterator cbegin() const noexcept { return begin(); }
+            const_iterator cend() const noexcept { return end(); }
+            const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+            const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+            const T *data() const noexcept { return begin(); }
+            const T &operator[](size_type i) const noexcept
+            {
+                FRYSTL_ASSERT2(i < size(), "static_multi_vector: index out of range");
+                return begin()[i];
+            }
+            const T &at(size_type i) const
+            {
+                Verify(i < size());
+                return begin()[i];
+            }
+            const T &front() const noexcept
+            {
+                FRYSTL_ASSERT2(size(), "static_multi_vector: front() of empty sequence");
+                return *begin();
+            }
+            const T &back() const noexcept
+            {
+                FRYSTL_ASSERT2(size(), "static_multi_vector: back() of empty sequence");
+                return end()[-1];
+            }
+
+        protected:
+            friend class static_multi_vector;
+            const_sequence_ref(const static_multi_vector *owner, unsigned k) noexcept
+                : _owner(owner), _k(k)
+            {}
+            const static_multi_vector *_owner;
+            unsigned _k;
+        };
+        // A view of one sequence of a static_multi_vector
+        class sequence_ref : public const_sequence_ref
+        {
+            using Base = const_sequence_ref;
+        public:
+            using reference = T &;
+            using iterator = T *;
+            using reverse_iterator = std::reverse_iterator<iterator>;
+
+            iterator begin() const noexcept { return Owner()->Begin(this->_k); }
+            iterator end() const noexcept { return Owner()->End(this->_k); }
+            reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+            reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+            T *data() const noexcept { return begin(); }
+            T &operator[](size_type i) const noexcept
+            {
+                return const_cast<T &>(Base::operator[](i));
+            }
+            T &at(size_type i) const { return const_cast<T &>(Base::at(i)); }
+            T &front() const noexcept { return const_cast<T &>(Base::front()); }
+            T &back() const noexcept { return const_cast<T &>(Base::back()); }
+
+            void push_back(const T &value) const { Owner()->push_back(this->_k, value); }
+            template <class... Args>
+            T &emplace_back(Args &&... args) const
+            {
+                return Owner()->emplace_back(this->_k, std::forward<Args>(args)...);
+            }
+            void pop_back() const noexcept { Owner()->pop_back(this->_k); }
+            iterator insert(const T *position, const T &value) const
+            {
+                return Owner()->insert(this->_k, position, value);
+            }
+            iterator insert(const T *position, size_type n, const T &value) const
+            {
+                return Owner()->insert(this->_k, position, n, value);
+            }
+            template <class InpIter, typename = RequireInputIter<InpIter>>
+            iterator insert(const T *position, InpIter first, InpIter last) const
+            {
+                return Owner()->insert(this->_k, position, first, last);
+            }
+            iterator erase(const T *position) const noexcept
+            {
+                return Owner()->erase(this->_k, position);
+            }
+            iterator erase(const T *first, const T *last) const noexcept
+            {
+                return Owner()->erase(this->_k, first, last);
+            }
+            void resize(size_type n, const T &value = T()) const
+            {
+                Owner()->resize(this->_k, n, value);
+            }
+            void clear() const noexcept { Owner()->clear(this->_k); }
+
+        private:
+            friend class static_multi_vector;
+            sequence_ref(static_multi_vector *owner, unsigned k) noexcept
+                : Base(owner, k)
+            {}
+            static_multi_vector *Owner() const noexcept
+            {
+                return const_cast<static_multi_vector *>(this->_owner);
+            }
+        };
+        //
+        //******* Public member functions:
+        //
+        static_multi_vector() noexcept
+            : _ends {}
+        {}
+        //
+        //  Sequences
+        //
+        static constexpr unsigned sequence_count() noexcept { return K; }
+        sequence_ref operator[](unsigned k) noexcept
+        {
+            FRYSTL_ASSERT2(k < K, "static_multi_vector: sequence out of range");
+            return sequence_ref(this, k);
+        }
+        const_sequence_ref operator[](unsigned k) const noexcept
+        {
+            FRYSTL_ASSERT2(k < K, "static_multi_vector: sequence out of range");
+            return const_sequence_ref(this, k);
+        }
+        sequence_ref at(unsigned k)
+        {
+            Verify(k < K);
+            return sequence_ref(this, k);
+        }
+        const_sequence_ref at(unsigned k) const
+        {
+            Verify(k < K);
+            return const_sequence_ref(this, k);
+        }
+        //
+        //  Capacity
+        //
+        // The number of elements in all sequences
+        size_type size() const noexcept { return _ends[K - 1]; }
+        size_type size(unsigned k) const noexcept { return _ends[k] - First(k); }
+        bool empty() const noexcept { return size() == 0; }
+        constexpr size_type capacity() const noexcept { return Capacity; }
+        constexpr size_type max_size() const noexcept { return Capacity; }
+        size_type available() const noexcept { return Capacity - size(); }
+        //
+        //  The elements of all the sequences, in order
+        //
+        T *data() noexcept { return Data(); }
+        const T *data() const noexcept { return Data(); }
+        //
+        //  Modifiers
+        //
+        void clear() noexcept
+        {
+            for (unsigned j = 0; j < K; ++j)
+                _ends[j] = 0;
+        }
+        void clear(unsigned k) noexcept
+        {
+            Close(k, First(k), size(k));
+        }
+        void push_back(unsigned k, const T &value)
+        {
+            emplace_back(k, value);
+        }
+        template <class... Args>
+        T &emplace_back(unsigned k, Args &&... args)
+        {
+            // Construct first, as args may refer to an element.
+            T value(std::forward<Args>(args)...);
+            T *p = Open(k, _ends[k], 1);
+            *p = value;
+            return *p;
+        }
+        void pop_back(unsigned k) noexcept
+        {
+            FRYSTL_ASSERT2(size(k), "static_multi_vector::pop_back(): empty sequence");
+            Close(k, _ends[k] - 1u, 1);
+        }
+        iterator insert(unsigned k, const T *position, const T &value)
+        {
+            return insert(k, position, 1, value);
+        }
+        iterator insert(unsigned k, const T *position, size_type n, const T &value)
+        {
+            T v = value;
+            T *p = Open(k, Offset(k, position), n);
+            std::fill(p, p + n, v);
+            return p;
+        }
+        template <class InpIter, typename = RequireInputIter<InpIter>>
+        iterator insert(unsigned k, const T *position, InpIter first, InpIter last)
+        {
+            size_type i = Offset(k, position);
+            // Copy the input first, in one pass, as it may be in this
+            // container.
+            std::aligned_storage_t<sizeof(T), alignof(T)> buf[Capacity ? Capacity : 1];
+            T *tmp = reinterpret_cast<T *>(buf);
+            size_type n = 0;
+            for (; first != last; ++first) {
+                FRYSTL_ASSERT2(n < available(), "static_multi_vector::insert(): overflow");
+                Construct(tmp + n++, *first);
+            }
+            T *p = Open(k, i, n);
+            std::memcpy(static_cast<void *>(p), tmp, n * sizeof(T));
+            return p;
+        }
+        iterator erase(unsigned k, const T *position) noexcept
+        {
+            return erase(k, position, position + 1);
+        }
+        iterator erase(unsigned k, const T *first, const T *last) noexcept
+        {
+            size_type i = Offset(k, first);
+            FRYSTL_ASSERT2(first <= last && last <= End(k),
+                "static_multi_vector::erase(): bad range");
+            Close(k, i, size_type(last - first));
+            return Data() + i;
+        }
+        void resize(unsigned k, size_type n, const T &value = T())
+        {
+            size_type s = size(k);
+            if (n < s)
+                Close(k, First(k) + n, s - n);
+            else if (s < n)
+                insert(k, End(k), n - s, value);
+        }
+        // Move the last n elements of sequence from onto the back of
+        // sequence to, keeping their order.
+        void move_back(unsigned from, size_type n, unsigned to) noexcept
+        {
+            FRYSTL_ASSERT2(from < K && to < K, "static_multi_vector: sequence out of range");
+            FRYSTL_ASSERT2(n <= size(from), "static_multi_vector::move_back(): too many");
+            if (from < to) {
+                // The elements between move down.
+                std::rotate(End(from) - n, End(from), End(to));
+                for (unsigned j = from; j < to; ++j)
+                    _ends[j] = Index(_ends[j] - n);
+            }
+            else if (to < from) {
+                // The elements between move up.
+                std::rotate(End(to), End(from) - n, End(from));
+                for (unsigned j = to; j < from; ++j)
+                    _ends[j] = Index(_ends[j] + n);
+            }
+        }
+        void swap(this_type &other) noexcept
+        {
+            std::swap(*this, other);
+        }
+        //
+        //  Comparison
+        //
+        // Two are equal if their sequences are equal.
+        friend bool operator==(const this_type &lhs, const this_type &rhs) noexcept
+        {
+            return std::equal(lhs._ends, lhs._ends + K, rhs._ends) &&
+                std::equal(lhs.Data(), lhs.Data() + lhs.size(), rhs.Data());
+        }
+        friend bool operator!=(const this_type &lhs, const this_type &rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        uint64_t hash() const noexcept
+        {
+            return HashRange(Data(), size(), HashRange(_ends, K));
+        }
+
+    private:
+        using Index = SmallestUnsigned<Capacity>;
+        std::aligned_storage_t<sizeof(T), alignof(T)> _elems[Capacity ? Capacity : 1];
+        Index _ends[K];     // _ends[k] is the offset of the end of sequence k
+
+        T *Data() noexcept { return reinterpret_cast<T *>(_elems); }
+        const T *Data() const noexcept { return reinterpret_cast<const T *>(_elems); }
+        // The offset of the first element of sequence k
+        size_type First(unsigned k) const noexcept { return k ? _ends[k - 1] : 0; }
+        T *Begin(unsigned k) noexcept { return Data() + First(k); }
+        const T *Begin(unsigned k) const noexcept { return Data() + First(k); }
+        T *End(unsigned k) noexcept { return Data() + _ends[k]; }
+        const T *End(unsigned k) const noexcept { return Data() + _ends[k]; }
+        // The offset of position, which must be in or at the end of sequence k
+        size_type Offset(unsigned k, const T *position) const noexcept
+        {
+            FRYSTL_ASSERT2(k < K, "static_multi_vector: sequence out of range");
+            FRYSTL_ASSERT2(Begin(k) <= position && position <= End(k),
+                "static_multi_vector: position not in sequence");
+            return size_type(position - Data());
+        }
+        // Make a gap of n elements at offset i, which is in sequence k,
+        // and return a pointer to it.
+        T *Open(unsigned k, size_type i, size_type n) noexcept
+        {
+            FRYSTL_ASSERT2(n <= available(), "static_multi_vector: overflow");
+            T *p = Data() + i;
+            std::memmove(static_cast<void *>(p + n), p, (size() - i) * sizeof(T));
+            // The ends from sequence k on move.  Looping over all K of
+            // them keeps every index visibly in bounds.
+            for (unsigned j = 0; j < K; ++j)
+                _ends[j] = Index(_ends[j] + (j < k ? 0 : n));
+            return p;
+        }
+        // Remove the n elements at offset i, which are in sequence k.
+        void Close(unsigned k, size_type i, size_type n) noexcept
+        {
+            T *p = Data() + i;
+            std::memmove(static_cast<void *>(p), p + n, (size() - i - n) * sizeof(T));
+            for (unsigned j = 0; j < K; ++j)
+                _ends[j] = Index(_ends[j] - (j < k ? 0 : n));
+        }
+        static void Verify(bool cond)
+        {
+            if (!cond)
+                throw std::out_of_range("static_multi_vector range error");
+        }
+    };
+    template <class T, unsigned K, unsigned C>
+    void swap(static_multi_vector<T, K, C> &a, static_multi_vector<T, K, C> &b) noexcept
+    {
+        a.swap(b);
+    }
+}       // namespace frystl
+
+namespace std
+{
+    template <class T, unsigned K, unsigned C>
+    struct hash<frystl::static_multi_vector<T, K, C>>
+    {
+        size_t operator()(const frystl::static_multi_vector<T, K, C> &m) const noexcept
+        {
+            return size_t(m.hash());
+        }
+    };
+}       // namespace std
+#endif  // ndef FRYSTL_STATIC_MULTI_VECTOR
@@ -0,0 +1,550 @@
+// Template class static_string
+//
+// static_string<N> is a string of up to N chars that uses no dynamic
+// storage.  It is a static_vector<char,N+1> that always ends with a
+// NUL, so c_str() and data() can be passed to C functions, and it
+// converts to std::string_view.  Most of its API is std::string's:
+// append(), operator+=, insert(), erase(), compare(), find(), rfind(),
+// substr(), starts_with(), ends_with(), and the comparison operators,
+// which also take string_views and C strings.  Positions and counts
+// are size_types, and member functions taking a position throw
+// std::out_of_range if it is past the end, as std::string's do.
+//
+// As with static_vector, exceeding the capacity fails an assertion if
+// FRYSTL_DEBUG is defined and is undefined behavior otherwise.  The
+// exception is append_number(), which formats a number with
+// std::to_chars and leaves the string unchanged if it does not fit.
+// to_static_string() formats a number into a new static_string.
+//
+// std::hash<static_string<N>> hashes the chars as std::hash does the
+// static_vector<char> that holds them.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_STATIC_STRING
+#define FRYSTL_STATIC_STRING
+#include <cstdint>      // uint32_t
+#include <cstring>      // memcpy, memmove
+#include <charconv>     // to_chars
+#include <iosfwd>       // basic_ostream
+#include <initializer_list>
+#include <stdexcept>    // out_of_range
+#include <string_view>
+#include <type_traits>  // is_integral, is_same, enable_if_t
+#include "static_vector.hpp"
+#include "frystl-hash.hpp"
+
+namespace frystl
+{
+    template <unsigned N>
+    class static_string
+    {
+    public:
+        using this_type = static_string<N>;
+        using vector_type = static_vector<char, N + 1>;
+        using traits_type = std::char_traits<char>;
+        using value_type = char;
+        using size_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = char &;
+        using const_reference = const char &;
+        using pointer = char *;
+        using const_pointer = const char *;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        static constexpr size_type npos = size_type(-1);
+        //
+        //******* Public member functions:
+        //
+        static_string() noexcept
+        {
+            _chars.push_back('\0');
+        }
+        static_string(const char *s) noexcept
+            : static_string(std::string_view(s))
+        {}
+        static_string(const char *s, size_type n) noexcept
+            : static_string(std::string_view(s, n))
+        {}
+        explicit static_string(std::string_view sv) noexcept
+            : static_string()
+        {
+            append(sv);
+        }
+        template <unsigned M>
+        static_string(const static_string<M> &other) noexcept
+            : static_string(std::string_view(other))
+        {}
+        static_string(size_type n, char c) noexcept
+            : static_string()
+        {
+            append(n, c);
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        static_string(InputIterator first, InputIterator last)
+            : static_string()
+        {
+            append(first, last);
+        }
+        static_string(std::initializer_list<char> il) noexcept
+            : static_string(il.begin(), il.end())
+        {}
+        this_type &operator=(const char *s) noexcept { return assign(s); }
+        this_type &operator=(std::string_view sv) noexcept { return assign(sv); }
+        this_type &operator=(char c) noexcept { return assign(1, c); }
+        this_type &operator=(std::initializer_list<char> il) noexcept
+        {
+            return assign(il.begin(), il.end());
+        }
+        this_type &assign(std::string_view sv) noexcept
+        {
+            clear();
+            return append(sv);
+        }
+        this_type &assign(size_type n, char c) noexcept
+        {
+            clear();
+            return append(n, c);
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        this_type &assign(InputIterator first, InputIterator last)
+        {
+            clear();
+            return append(first, last);
+        }
+        //
+        //  Element access
+        //
+        reference at(size_type i)
+        {
+            Verify(i < size());
+            return data()[i];
+        }
+        const_reference at(size_type i) const
+        {
+            Verify(i < size());
+            return data()[i];
+        }
+        // As with std::string, s[s.size()] is the terminating NUL, which
+        // must not be changed.
+        reference operator[](size_type i) noexcept
+        {
+            FRYSTL_ASSERT2(i <= size(), "static_string: index out of range");
+            return data()[i];
+        }
+        const_reference operator[](size_type i) const noexcept
+        {
+            FRYSTL_ASSERT2(i <= size(), "static_string: index out of range");
+            return data()[i];
+        }
+        reference front() noexcept { return (*this)[0]; }
+        const_reference front() const noexcept { return (*this)[0]; }
+        reference back() noexcept { return (*this)[size() - 1]; }
+        const_reference back() const noexcept { return (*this)[size() - 1]; }
+        pointer data() noexcept { return _chars.data(); }
+        const_pointer data() const noexcept { return _chars.data(); }
+        const_pointer c_str() const noexcept { return _chars.data(); }
+        operator std::string_view() const noexcept
+        {
+            return std::string_view(data(), size());
+        }
+        //
+        //  Iterators
+        //
+        iterator begin() noexcept { return data(); }
+        const_iterator begin() const noexcept { return data(); }
+        const_iterator cbegin() const noexcept { return data(); }
+        iterator end() noexcept { return data() + size(); }
+        const_iterator end() const noexcept { return data() + size(); }
+        const_iterator cend() const noexcept { return data() + size(); }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+        //
+        //  Capacity
+        //
+        size_type size() const noexcept { return _chars.size() - 1; }
+        size_type length() const noexcept { return size(); }
+        bool empty() const noexcept { return size() == 0; }
+        constexpr size_type capacity() const noexcept { return N; }
+        constexpr size_type max_size() const noexcept { return N; }
+        // The room left for more chars
+        size_type available() const noexcept { return N - size(); }
+        //
+        //  Modifiers
+        //
+        void clear() noexcept
+        {
+            _chars.resize(1);
+            _chars[0] = '\0';
+        }
+        void push_back(char c) noexcept
+        {
+            *Grow(1) = c;
+        }
+        void pop_back() noexcept
+        {
+            FRYSTL_ASSERT2(!empty(), "static_string::pop_back() on empty string");
+            _chars.pop_back();
+            _chars.back() = '\0';
+        }
+        this_type &append(std::string_view sv) noexcept
+        {
+            size_type n = size_type(sv.size());
+            // sv may be part of this string; Grow() does not move it.
+            std::memcpy(Grow(n), sv.data(), n);
+            return *this;
+        }
+        this_type &append(const char *s, size_type n) noexcept
+        {
+            return append(std::string_view(s, n));
+        }
+        this_type &append(size_type n, char c) noexcept
+        {
+            std::memset(Grow(n), c, n);
+            return *this;
+        }
+        template <class InputIterator,
+                  typename = RequireInputIter<InputIterator>>
+        this_type &append(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first)
+                push_back(*first);
+            return *this;
+        }
+        this_type &operator+=(std::string_view sv) noexcept { return append(sv); }
+        this_type &operator+=(const char *s) noexcept { return append(s); }
+        this_type &operator+=(char c) noexcept
+        {
+            push_back(c);
+            return *this;
+        }
+        // Append value formatted by std::to_chars: an integer in the
+        // given base, or a floating-point number in its shortest exact
+        // form.  If the result would not fit, the string is unchanged;
+        // return false in that case.
+        template <class Number>
+        bool append_number(Number value, int base = 10) noexcept
+        {
+            static_assert(std::is_arithmetic<Number>::value && !std::is_same<Number, bool>::value,
+                "static_string::append_number(): value must be a number");
+            char *first = end();
+            std::to_chars_result r;
+            if constexpr (std::is_integral<Number>::value)
+                r = std::to_chars(first, data() + N, value, base);
+            else {
+                FRYSTL_ASSERT2(base == 10, "static_string::append_number(): floating base");
+                (void)base;
+                r = std::to_chars(first, data() + N, value);
+            }
+            if (r.ec != std::errc())
+                return false;
+            _chars.resize_default_init(size_type(r.ptr - data()) + 1);
+            *r.ptr = '\0';
+            return true;
+        }
+        this_type &insert(size_type pos, std::string_view sv)
+        {
+            Verify(pos <= size());
+            size_type n = size_type(sv.size());
+            FRYSTL_ASSERT2(n <= available(), "static_string::insert(): overflow");
+            FRYSTL_ASSERT2(!Overlaps(sv), "static_string::insert(): overlapping source");
+            size_type tail = size() - pos;
+            Grow(n);
+            std::memmove(data() + pos + n, data() + pos, tail);
+            std::memcpy(data() + pos, sv.data(), n);
+            return *this;
+        }
+        this_type &insert(size_type pos, size_type n, char c)
+        {
+            Verify(pos <= size());
+            size_type tail = size() - pos;
+            Grow(n);
+            std::memmove(data() + pos + n, data() + pos, tail);
+            std::memset(data() + pos, c, n);
+            return *this;
+        }
+        iterator insert(const_iterator position, char c) noexcept
+        {
+            size_type pos = size_type(position - cbegin());
+            insert(pos, 1, c);
+            return begin() + pos;
+        }
+        // Erase up to n chars starting at pos.
+        this_type &erase(size_type pos = 0, size_type n = npos)
+        {
+            Verify(pos <= size());
+            n = std::min(n, size() - pos);
+            // Move the tail and its NUL.
+            std::memmove(data() + pos, data() + pos + n, size() - pos - n + 1);
+            _chars.resize(_chars.size() - n);
+            return *this;
+        }
+        // A template, so that erase(0) calls erase(size_type, size_type).
+        template <class Iter, typename = std::enable_if_t<
+            std::is_same<Iter, iterator>::value || std::is_same<Iter, const_iterator>::value>>
+        iterator erase(Iter position) noexcept
+        {
+            return erase(position, position + 1);
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            FRYSTL_ASSERT2(cbegin() <= first && first <= last && last <= cend(),
+                "static_string::erase(first,last): bad range");
+            size_type pos = size_type(first - cbegin());
+            erase(pos, size_type(last - first));
+            return begin() + pos;
+        }
+        void resize(size_type n, char c = '\0') noexcept
+        {
+            FRYSTL_ASSERT2(n <= N, "static_string::resize: overflow");
+            if (n <= size()) {
+                _chars.resize(n + 1);
+                _chars.back() = '\0';
+            }
+            else
+                append(n - size(), c);
+        }
+        void swap(this_type &other) noexcept
+        {
+            _chars.swap(other._chars);
+        }
+        //
+        //  Operations
+        //
+        int compare(std::string_view sv) const noexcept
+        {
+            return std::string_view(*this).compare(sv);
+        }
+        size_type find(std::string_view sv, size_type pos = 0) const noexcept
+        {
+            return Position(std::string_view(*this).find(sv, pos));
+        }
+        size_type find(char c, size_type pos = 0) const noexcept
+        {
+            return Position(std::string_view(*this).find(c, pos));
+        }
+        size_type rfind(std::string_view sv, size_type pos = npos) const noexcept
+        {
+            return Position(std::string_view(*this).rfind(sv, pos));
+        }
+        size_type rfind(char c, size_type pos = npos) const noexcept
+        {
+            return Position(std::string_view(*this).rfind(c, pos));
+        }
+        bool starts_with(std::string_view sv) const noexcept
+        {
+            return sv.size() <= size() && traits_type::compare(data(), sv.data(), sv.size()) == 0;
+        }
+        bool ends_with(std::string_view sv) const noexcept
+        {
+            return sv.size() <= size() &&
+                traits_type::compare(end() - sv.size(), sv.data(), sv.size()) == 0;
+        }
+        bool contains(std::string_view sv) const noexcept
+        {
+            return find(sv) != npos;
+        }
+        this_type substr(size_type pos = 0, size_type n = npos) const
+        {
+            Verify(pos <= size());
+            return this_type(std::string_view(*this).substr(pos, n));
+        }
+
+    private:
+        vector_type _chars;
+
+        static void Verify(bool cond)
+        {
+            if (!cond)
+                throw std::out_of_range("static_string range error");
+        }
+        // Lengthen the string by n chars, which are left uninitialized,
+        // and return a pointer to the first.  The chars already present
+        // do not move.
+        char *Grow(size_type n) noexcept
+        {
+            FRYSTL_ASSERT2(n <= available(), "static_string: overflow");
+            char *p = end();
+            _chars.resize_default_init(_chars.size() + n);
+            p[n] = '\0';
+            return p;
+        }
+        bool Overlaps(std::string_view sv) const noexcept
+        {
+            return !sv.empty() && data() <= sv.data() && sv.data() < data() + N + 1;
+        }
+        static size_type Position(std::string_view::size_type i) noexcept
+        {
+            return i == std::string_view::npos ? npos : size_type(i);
+        }
+    };
+    //
+    //*******  Non-member overloads
+    //
+    template <unsigned N, unsigned M>
+    bool operator==(const static_string<N> &lhs, const static_string<M> &rhs) noexcept
+    {
+        return std::string_view(lhs) == std::string_view(rhs);
+    }
+    template <unsigned N>
+    bool operator==(const static_string<N> &lhs, std::string_view rhs) noexcept
+    {
+        return std::string_view(lhs) == rhs;
+    }
+    template <unsigned N>
+    bool operator==(std::string_view lhs, const static_string<N> &rhs) noexcept
+    {
+        return lhs == std::string_view(rhs);
+    }
+    template <unsigned N, unsigned M>
+    bool operator!=(const static_string<N> &lhs, const static_string<M> &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+    template <unsigned N>
+    bool operator!=(const static_string<N> &lhs, std::string_view rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+    template <unsigned N>
+    bool operator!=(std::string_view lhs, const static_string<N> &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+    template <unsigned N, unsigned M>
+    bool operator<(const static_string<N> &lhs, const static_string<M> &rhs) noexcept
+    {
+        return lhs.compare(rhs) < 0;
+    }
+    template <unsigned N>
+    bool operator<(const static_string<N> &lhs, std::string_view rhs) noexcept
+    {
+        return lhs.compare(rhs) < 0;
+    }
+    template <unsigned N>
+    bool operator<(std::string_view lhs, const static_string<N> &rhs) noexcept
+    {
+        return rhs.compare(lhs) > 0;
+    }
+    template <unsigned N, unsigned M>
+    bool operator<=(const static_string<N> &lhs, const static_string<M> &rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+    template <unsigned N>
+    bool operator<=(const static_string<N> &lhs, std::string_view rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+    template <unsigned N>
+    bool operator<=(std::string_view lhs, const static_string<N> &rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+    template <unsigned N, unsigned M>
+    bool operator>(const static_string<N> &lhs, const static_string<M> &rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+    template <unsigned N>
+    bool operator>(const static_string<N> &lhs, std::string_view rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+    template <unsigned N>
+    bool operator>(std::string_view lhs, const static_string<N> &rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+    template <unsigned N, unsigned M>
+    bool operator>=(const static_string<N> &lhs, const static_string<M> &rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+    template <unsigned N>
+    bool operator>=(const static_string<N> &lhs, std::string_view rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+    template <unsigned N>
+    bool operator>=(std::string_view lhs, const static_string<N> &rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+#ifdef FRYSTL_HAS_THREE_WAY
+    template <unsigned N, unsigned M>
+    std::strong_ordering operator<=>(const static_string<N> &lhs, const static_string<M> &rhs) noexcept
+    {
+        return lhs.compare(rhs) <=> 0;
+    }
+    template <unsigned N>
+    std::strong_ordering operator<=>(const static_string<N> &lhs, std::string_view rhs) noexcept
+    {
+        return lhs.compare(rhs) <=> 0;
+    }
+#endif
+    template <unsigned N>
+    void swap(static_string<N> &a, static_string<N> &b) noexcept
+    {
+        a.swap(b);
+    }
+    template <class Traits, unsigned N>
+    std::basic_ostream<char, Traits> &operator<<(std::basic_ostream<char, Traits> &os,
+        const static_string<N> &s)
+    {
+        return os << std::string_view(s);
+    }
+    // Return value formatted as by static_string<N>::append_number().
+    // The default N holds any integer or floating-point number in base 10.
+    template <unsigned N = 32, class Number>
+    static_string<N> to_static_string(Number value, int base = 10) noexcept
+    {
+        static_string<N> result;
+        bool fits = result.append_number(value, base);
+        FRYSTL_ASSERT2(fits, "to_static_string(): result too long");
+        (void)fits;
+        return result;
+    }
+}       // namespace frystl
+
+namespace std
+{
+    // Hash the chars of a static_string.  See frystl-hash.hpp.
+    template <unsigned N>
+    struct hash<frystl::static_string<N>>
+    {
+        size_t operator()(const frystl::static_string<N> &s) const noexcept
+        {
+            return size_t(frystl::HashRange(s.data(), s.size()));
+        }
+    };
+}       // namespace std
+#endif  // ndef FRYSTL_STATIC_STRING
@@ -0,0 +1,239 @@
+// Template class static_unordered_map
+//
+// static_unordered_map<Key,T,Capacity,Hash,KeyEqual> is a map of up to
+// Capacity keys to values of type T in a hash table of fixed size, so
+// it uses no dynamic storage.  It has most of the API of a
+// std::unordered_map.  See frystl-hashtable.hpp for the table.
+//
+// Lookups, insertions and erasures take constant expected time, and
+// clear() takes time proportional to the size.  Iterators are forward
+// iterators; they visit the elements in the order inserted, except
+// that erasing an element moves the last element into its place.  So
+// erasing invalidates iterators and references to the element erased
+// and to the last element, and inserting invalidates none but end().
+// There are no buckets, and no rehashing.
+//
+// As with static_vector, inserting into a full map fails an assertion
+// if FRYSTL_DEBUG is defined and is undefined behavior otherwise.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_STATIC_UNORDERED_MAP
+#define FRYSTL_STATIC_UNORDERED_MAP
+#include <functional>   // hash, equal_to
+#include <initializer_list>
+#include <stdexcept>    // out_of_range
+#include <tuple>        // forward_as_tuple
+#include <utility>      // pair, piecewise_construct, move, forward
+#include "frystl-hashtable.hpp"
+
+namespace frystl
+{
+    template <class Key, class T>
+    struct HashMapKeyOf
+    {
+        static const Key &Get(const std::pair<const Key, T> &value) noexcept
+        {
+            return value.first;
+        }
+    };
+
+    template <class Key, class T, unsigned Capacity,
+              class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class static_unordered_map
+        : private StaticHashTable<std::pair<const Key, T>, HashMapKeyOf<Key, T>,
+                                  Capacity, Hash, KeyEqual>
+    {
+        using Base = StaticHashTable<std::pair<const Key, T>, HashMapKeyOf<Key, T>,
+                                     Capacity, Hash, KeyEqual>;
+    public:
+        using this_type = static_unordered_map<Key, T, Capacity, Hash, KeyEqual>;
+        using typename Base::key_type;
+        using mapped_type = T;
+        using typename Base::value_type;
+        using typename Base::hasher;
+        using typename Base::key_equal;
+        using typename Base::size_type;
+        using typename Base::difference_type;
+        using typename Base::reference;
+        using typename Base::const_reference;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+        using typename Base::iterator;
+        using typename Base::const_iterator;
+
+        //
+        //******* Public member functions:
+        //
+        static_unordered_map() noexcept = default;
+        template <class InputIt, typename = RequireInputIter<InputIt>>
+        static_unordered_map(InputIt first, InputIt last)
+        {
+            insert(first, last);
+        }
+        static_unordered_map(std::initializer_list<value_type> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        this_type &operator=(std::initializer_list<value_type> il)
+        {
+            clear();
+            insert(il.begin(), il.end());
+            return *this;
+        }
+        //
+        //  Element access
+        //
+        T &at(const Key &key)
+        {
+            iterator it = find(key);
+            Verify(it != end());
+            return it->second;
+        }
+        const T &at(const Key &key) const
+        {
+            const_iterator it = find(key);
+            Verify(it != end());
+            return it->second;
+        }
+        T &operator[](const Key &key) { return try_emplace(key).first->second; }
+        T &operator[](Key &&key) { return try_emplace(std::move(key)).first->second; }
+        //
+        //  Iterators
+        //
+        using Base::begin;
+        using Base::end;
+        using Base::cbegin;
+        using Base::cend;
+        //
+        //  Capacity
+        //
+        using Base::size;
+        using Base::empty;
+        using Base::capacity;
+        using Base::max_size;
+        using Base::bucket_count;
+        using Base::load_factor;
+        //
+        //  Modifiers
+        //
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return try_emplace(value.first, value.second);
+        }
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return try_emplace(value.first, std::move(value.second));
+        }
+        template <class InputIt, typename = RequireInputIter<InputIt>>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+        void insert(std::initializer_list<value_type> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&... args)
+        {
+            value_type value(std::forward<Args>(args)...);
+            return try_emplace(value.first, std::move(value.second));
+        }
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const Key &key, Args &&... args)
+        {
+            return Base::EmplaceKey(key, std::piecewise_construct,
+                std::forward_as_tuple(key),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(Key &&key, Args &&... args)
+        {
+            return Base::EmplaceKey(key, std::piecewise_construct,
+                std::forward_as_tuple(std::move(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj)
+        {
+            auto result = try_emplace(key, std::forward<M>(obj));
+            if (!result.second)
+                result.first->second = std::forward<M>(obj);
+            return result;
+        }
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(Key &&key, M &&obj)
+        {
+            auto result = try_emplace(std::move(key), std::forward<M>(obj));
+            if (!result.second)
+                result.first->second = std::forward<M>(obj);
+            return result;
+        }
+        using Base::erase;
+        using Base::clear;
+        void swap(this_type &other) noexcept { Base::swap(other); }
+        // Erase the elements for which pred is true.  Return the number
+        // erased.
+        template <class Pred>
+        friend size_t erase_if(this_type &m, Pred pred)
+        {
+            return HashEraseIf(m, pred);
+        }
+        //
+        //  Lookup
+        //
+        using Base::find;
+        using Base::count;
+        using Base::contains;
+        //
+        //  Observers
+        //
+        using Base::hash_function;
+        using Base::key_eq;
+
+        friend bool operator==(const this_type &lhs, const this_type &rhs)
+        {
+            return lhs.Equal(rhs);
+        }
+        friend bool operator!=(const this_type &lhs, const this_type &rhs)
+        {
+            return !lhs.Equal(rhs);
+        }
+
+    private:
+        static void Verify(bool cond)
+        {
+            if (!cond)
+                throw std::out_of_range("static_unordered_map key not found");
+        }
+    };
+    template <class K, class T, unsigned C, class H, class E>
+    void swap(static_unordered_map<K, T, C, H, E> &a,
+              static_unordered_map<K, T, C, H, E> &b) noexcept
+    {
+        a.swap(b);
+    }
+}       // namespace frystl
+#endif  // ndef FRYSTL_STATIC_UNORDERED_MAP
@@ -0,0 +1,178 @@
+// Template class static_unordered_set
+//
+// static_unordered_set<Key,Capacity,Hash,KeyEqual> is a set of up to
+// Capacity keys in a hash table of fixed size, so it uses no dynamic
+// storage.  It has most of the API of a std::unordered_set.  See
+// frystl-hashtable.hpp for the table.
+//
+// Lookups, insertions and erasures take constant expected time, and
+// clear() takes time proportional to the size.  Iterators are forward
+// iterators and are const; they visit the keys in the order inserted,
+// except that erasing a key moves the last key into its place.  So
+// erasing invalidates iterators to the key erased and to the last key,
+// and inserting invalidates none but end().  There are no buckets, and
+// no rehashing.
+//
+// As with static_vector, inserting into a full set fails an assertion
+// if FRYSTL_DEBUG is defined and is undefined behavior otherwise.
+/*
+MIT License
+
+Copyright (c) 2020-2023 by Jonathan Fry
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef FRYSTL_STATIC_UNORDERED_SET
+#define FRYSTL_STATIC_UNORDERED_SET
+#include <functional>   // hash, equal_to
+#include <initializer_list>
+#include <utility>      // pair, move, forward
+#include "frystl-hashtable.hpp"
+
+namespace frystl
+{
+    template <class Key>
+    struct HashSetKeyOf
+    {
+        static const Key &Get(const Key &key) noexcept { return key; }
+    };
+
+    template <class Key, unsigned Capacity,
+              class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class static_unordered_set
+        : private StaticHashTable<Key, HashSetKeyOf<Key>, Capacity, Hash, KeyEqual>
+    {
+        using Base = StaticHashTable<Key, HashSetKeyOf<Key>, Capacity, Hash, KeyEqual>;
+    public:
+        using this_type = static_unordered_set<Key, Capacity, Hash, KeyEqual>;
+        using typename Base::key_type;
+        using typename Base::value_type;
+        using typename Base::hasher;
+        using typename Base::key_equal;
+        using typename Base::size_type;
+        using typename Base::difference_type;
+        using reference = const Key &;
+        using const_reference = const Key &;
+        using pointer = const Key *;
+        using const_pointer = const Key *;
+        using const_iterator = typename Base::const_iterator;
+        using iterator = const_iterator;
+
+        //
+        //******* Public member functions:
+        //
+        static_unordered_set() noexcept = default;
+        template <class InputIt, typename = RequireInputIter<InputIt>>
+        static_unordered_set(InputIt first, InputIt last)
+        {
+            insert(first, last);
+        }
+        static_unordered_set(std::initializer_list<Key> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        this_type &operator=(std::initializer_list<Key> il)
+        {
+            clear();
+            insert(il.begin(), il.end());
+            return *this;
+        }
+        //
+        //  Iterators
+        //
+        const_iterator begin() const noexcept { return Base::begin(); }
+        const_iterator end() const noexcept { return Base::end(); }
+        using Base::cbegin;
+        using Base::cend;
+        //
+        //  Capacity
+        //
+        using Base::size;
+        using Base::empty;
+        using Base::capacity;
+        using Base::max_size;
+        using Base::bucket_count;
+        using Base::load_factor;
+        //
+        //  Modifiers
+        //
+        std::pair<iterator, bool> insert(const Key &key)
+        {
+            return Base::EmplaceKey(key, key);
+        }
+        std::pair<iterator, bool> insert(Key &&key)
+        {
+            return Base::EmplaceKey(key, std::move(key));
+        }
+        template <class InputIt, typename = RequireInputIter<InputIt>>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+        void insert(std::initializer_list<Key> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&... args)
+        {
+            return insert(Key(std::forward<Args>(args)...));
+        }
+        iterator erase(const_iterator position) noexcept
+        {
+            return Base::erase(position);
+        }
+        using Base::erase;
+        using Base::clear;
+        void swap(this_type &other) noexcept { Base::swap(other); }
+        // Erase the keys for which pred is true.  Return the number erased.
+        template <class Pred>
+        friend size_t erase_if(this_type &s, Pred pred)
+        {
+            return HashEraseIf(s, pred);
+        }
+        //
+        //  Lookup
+        //
+        const_iterator find(const Key &key) const { return Base::find(key); }
+        using Base::count;
+        using Base::contains;
+        //
+        //  Observers
+        //
+        using Base::hash_function;
+        using Base::key_eq;
+
+        friend bool operator==(const this_type &lhs, const this_type &rhs)
+        {
+            return lhs.Equal(rhs);
+        }
+        friend bool operator!=(const this_type &lhs, const this_type &rhs)
+        {
+            return !lhs.Equal(rhs);
+        }
+    };
+    template <class K, unsigned C, class H, class E>
+    void swap(static_unordered_set<K, C, H, E> &a, static_unordered_set<K, C, H, E> &b) noexcept
+    {
+        a.swap(b);
+    }
+}       // namespace frystl
+#endif  // ndef FRYSTL_STATIC_UNORDERED_SET
@@ -9,6 +9,26 @@
 //
 // The functions reserve() and shrink_to_fit() do nothing; the
 // function get_allocator() is not implemented.
+//
+// The functions try_emplace_back(), try_push_back(),
+// unchecked_emplace_back(), and unchecked_push_back() of C++26's
+// std::inplace_vector are added.  Compiled as C++20 or later, a
+// static_vector of a trivial type can be used in constant expressions.
+//
+// If T is trivially copyable, so is static_vector<T,Capacity>: its
+// copy and move constructors and assignment operators and its
+// destructor are all trivial, so it can be copied with memcpy().  Such
+// a copy copies all Capacity cells, and a "move" leaves the source
+// unchanged.  Otherwise a copy copies only the size() elements, and
+// a move leaves the source empty.  The destructor is trivial if T's is.
+//
+// The size is stored in the smallest unsigned type that can hold
+// Capacity, so a static_vector<uint8_t,24> occupies 25 bytes.  The
+// size_type is uint32_t regardless.
+//
+// The non-member functions find(), count(), contains(), min_element()
+// and max_element() search a static_vector.  If its elements are 1-,
+// 2- or 4-byte integers, they use the SIMD kernels of frystl-simd.hpp.
 /*
 MIT License
 
@@ -37,14 +57,146 @@ SOFTWARE.
 #include <cstdint> // for uint32_t
 #include <iterator>  // std::reverse_iterator
 #include <algorithm> // for std::move...(), equal(), lexicographical_compare(), rotate()
+#include <functional> // less
 #include <initializer_list>
 #include <stdexcept> // for std::out_of_range
+#include <cstring>   // memcpy
+#include <memory>    // uninitialized_copy, uninitialized_move
+#include <type_traits> // aligned_storage, is_trivially_copyable
+#include <utility>   // as_const
 #include "frystl-defines.hpp"
+#include "frystl-simd.hpp"
+#include "frystl-hash.hpp"
+#include "frystl-sort.hpp"
 
 namespace frystl
 {
+    // Storage for static_vector.  Its destructor is trivial if T's is.
+    template <class T, uint32_t Capacity,
+              bool = std::is_trivially_destructible<T>::value>
+    class StaticVectorStorage
+    {
+    protected:
+        using storage_type =
+            std::aligned_storage_t<sizeof(T), alignof(T)>;
+        SmallestUnsigned<Capacity> _size;
+        storage_type _elem[Capacity];
+
+        StaticVectorStorage() noexcept : _size(0) {}
+        StaticVectorStorage(const StaticVectorStorage &) noexcept : _size(0) {}
+        StaticVectorStorage &operator=(const StaticVectorStorage &) noexcept 
+        { 
+            return *this; 
+        }
+        ~StaticVectorStorage() noexcept
+        {
+            DestroyAll();
+        }
+        T *Data() noexcept { return reinterpret_cast<T *>(_elem); }
+        const T *Data() const noexcept { return reinterpret_cast<const T *>(_elem); }
+        void DestroyAll() noexcept
+        {
+            for (T *p = Data(); p < Data() + _size; ++p)
+                Destroy(p);
+            _size = 0;
+        }
+    };
     template <class T, uint32_t Capacity>
-    class static_vector
+    class StaticVectorStorage<T, Capacity, true>
+    {
+    protected:
+        // If constexpr is supported, a trivial T is stored as an array
+        // of T, which constant expressions can use.
+#ifdef FRYSTL_HAS_CONSTEXPR20
+        static constexpr bool _typed = std::is_trivial<T>::value;
+#else
+        static constexpr bool _typed = false;
+#endif
+        using storage_type = std::conditional_t<_typed, T,
+            std::aligned_storage_t<sizeof(T), alignof(T)>>;
+        SmallestUnsigned<Capacity> _size;
+        storage_type _elem[Capacity];
+
+        FRYSTL_CONSTEXPR20 StaticVectorStorage() noexcept : _size(0)
+        {
+#ifdef FRYSTL_HAS_CONSTEXPR20
+            // A constant expression may not copy uninitialized cells.
+            if constexpr (_typed)
+                if (std::is_constant_evaluated())
+                    for (T &cell : _elem)
+                        cell = T();
+#endif
+        }
+        FRYSTL_CONSTEXPR20 T *Data() noexcept 
+        { 
+            if constexpr (_typed) return _elem;
+            else return reinterpret_cast<T *>(_elem);
+        }
+        FRYSTL_CONSTEXPR20 const T *Data() const noexcept 
+        { 
+            if constexpr (_typed) return _elem;
+            else return reinterpret_cast<const T *>(_elem);
+        }
+        FRYSTL_CONSTEXPR20 void DestroyAll() noexcept
+        {
+            _size = 0;
+        }
+    };
+    // Copy and move operations for static_vector.  They are the
+    // defaulted ones if T is trivially copyable.  Otherwise they work on
+    // only the size() elements, not all Capacity cells, and the moves
+    // leave their sources empty.
+    template <class T, uint32_t Capacity,
+              bool = std::is_trivially_copyable<T>::value>
+    class StaticVectorBase : public StaticVectorStorage<T, Capacity>
+    {
+        using Storage = StaticVectorStorage<T, Capacity>;
+    protected:
+        using Storage::_size;
+        using Storage::Data;
+        using Storage::DestroyAll;
+
+        StaticVectorBase() noexcept = default;
+        StaticVectorBase(const StaticVectorBase &donor)
+            : Storage()
+        {
+            std::uninitialized_copy(donor.Data(), donor.Data() + donor._size, Data());
+            _size = donor._size;
+        }
+        StaticVectorBase(StaticVectorBase &&donor) noexcept
+            : Storage()
+        {
+            std::uninitialized_move(donor.Data(), donor.Data() + donor._size, Data());
+            _size = donor._size;
+            donor.DestroyAll();
+        }
+        StaticVectorBase &operator=(const StaticVectorBase &other)
+        {
+            if (this != &other) {
+                DestroyAll();
+                std::uninitialized_copy(other.Data(), other.Data() + other._size, Data());
+                _size = other._size;
+            }
+            return *this;
+        }
+        StaticVectorBase &operator=(StaticVectorBase &&other) noexcept
+        {
+            if (this != &other) {
+                DestroyAll();
+                std::uninitialized_move(other.Data(), other.Data() + other._size, Data());
+                _size = other._size;
+                other.DestroyAll();
+            }
+            return *this;
+        }
+        ~StaticVectorBase() = default;
+    };
+    template <class T, uint32_t Capacity>
+    class StaticVectorBase<T, Capacity, true> : public StaticVectorStorage<T, Capacity>
+    {};
+
+    template <class T, uint32_t Capacity>
+    class static_vector : private StaticVectorBase<T, Capacity>
     {
     public:
         using this_type = static_vector<T, Capacity>;
@@ -62,16 +214,10 @@ namespace frystl
         //
         //******* Public member functions:
         //
-        static_vector() noexcept : _size(0) {} 
-        ~static_vector() noexcept { clear(); } 
+        static_vector() noexcept = default;
         // copy constructors
-        static_vector(const this_type &donor) : _size(0)
-        {
-            for (auto &m : donor)
-                push_back(m);
-        }
         template <unsigned C1>
-        static_vector(const static_vector<T, C1> &donor) : _size(0)
+        FRYSTL_CONSTEXPR20 static_vector(const static_vector<T, C1> &donor)
         {
             FRYSTL_ASSERT2(donor.size() <= Capacity,
                     "static_vector: construction from a too-large object");
@@ -81,9 +227,10 @@ namespace frystl
         // move constructors
         // Constructs the new static_vector by moving all the elements of
         // the existing static_vector.  It leaves the moved-from object
-        // empty.
+        // empty, except that a move between static_vectors of the same
+        // type leaves it unchanged if T is trivially copyable.
         template <unsigned C1>
-        static_vector(static_vector<T, C1> &&donor) noexcept : _size(0)
+        FRYSTL_CONSTEXPR20 static_vector(static_vector<T, C1> &&donor) noexcept
         {
             FRYSTL_ASSERT2(donor.size() <= Capacity,
                     "static_vector: overflow on move construction");
@@ -92,38 +239,37 @@ namespace frystl
             donor.clear();
         }
         // fill constructors
-        static_vector(size_type n, const_reference value) : _size(0)
+        FRYSTL_CONSTEXPR20 static_vector(size_type n, const_reference value)
         {
             for (size_type i = 0; i < n; ++i)
                 push_back(value);
         }
-        static_vector(size_type n) : static_vector(n, T()) {}
+        FRYSTL_CONSTEXPR20 static_vector(size_type n) : static_vector(n, T()) {}
         // range constructor
         template <class InputIterator,
                   typename = RequireInputIter<InputIterator>>
-        static_vector(InputIterator begin, InputIterator end) : _size(0)
+        FRYSTL_CONSTEXPR20 static_vector(InputIterator begin, InputIterator end)
         {
             for (InputIterator k = begin; k != end; ++k)
                 emplace_back(*k);
         }
         // initializer list constructor
-        static_vector(std::initializer_list<value_type> il) : _size(il.size())
+        FRYSTL_CONSTEXPR20 static_vector(std::initializer_list<value_type> il)
         {
             FRYSTL_ASSERT2(il.size() <= Capacity,
                     "static_vector: construction from a too-large list");
-            pointer p = data();
             for (auto &value : il)
-                Construct(p++, value);
+                Construct(data() + _size++, value);
         }
         //
         //  Assignment functions
-        void assign(size_type n, const_reference val)
+        FRYSTL_CONSTEXPR20 void assign(size_type n, const_reference val)
         {
             clear();
             while (size() < n)
                 push_back(val);
         }
-        void assign(std::initializer_list<value_type> x)
+        FRYSTL_CONSTEXPR20 void assign(std::initializer_list<value_type> x)
         {
             FRYSTL_ASSERT2(x.size() <= Capacity,
                     "static_vector: assign() from a too-large list");
@@ -133,7 +279,7 @@ namespace frystl
         }
         template <class InputIterator,
                   typename = RequireInputIter<InputIterator>> 
-        void assign(InputIterator begin, InputIterator end)
+        FRYSTL_CONSTEXPR20 void assign(InputIterator begin, InputIterator end)
         {
             clear();
             for (InputIterator k = begin; k != end; ++k)
@@ -141,7 +287,7 @@ namespace frystl
         }
         // Copy operator=.
         template <unsigned C2>
-        this_type &operator=(static_vector<T,C2> &other) 
+        FRYSTL_CONSTEXPR20 this_type &operator=(const static_vector<T,C2> &other) 
         {
             if (data() != other.data()) {
                 assign(other.begin(), other.end());
@@ -149,9 +295,10 @@ namespace frystl
             return *this;
         }
         // Move operator=.  Except for self-assignments, source
-        // will be left empty.
+        // will be left empty (unchanged for the same type if T is
+        // trivially copyable).
         template <unsigned C2>
-        this_type &operator=(static_vector<T,C2> &&other) noexcept
+        FRYSTL_CONSTEXPR20 this_type &operator=(static_vector<T,C2> &&other) noexcept
         {
             if (data() != other.data())
             {
@@ -164,7 +311,7 @@ namespace frystl
             }
             return *this;
         }
-        this_type &operator=(std::initializer_list<value_type> il)
+        FRYSTL_CONSTEXPR20 this_type &operator=(std::initializer_list<value_type> il)
         {
             assign(il);
             return *this;
@@ -172,44 +319,44 @@ namespace frystl
         //
         //  Element access functions
         //
-        pointer data() noexcept { return reinterpret_cast<pointer>(_elem); }
-        const_pointer data() const noexcept { return reinterpret_cast<const_pointer>(_elem); }
-        reference at(size_type i)
+        FRYSTL_CONSTEXPR20 pointer data() noexcept { return base_type::Data(); }
+        FRYSTL_CONSTEXPR20 const_pointer data() const noexcept { return base_type::Data(); }
+        FRYSTL_CONSTEXPR20 reference at(size_type i)
         {
             Verify(i < _size);
             return data()[i];
         }
-        reference operator[](size_type i) noexcept
+        FRYSTL_CONSTEXPR20 reference operator[](size_type i) noexcept
         {
             FRYSTL_ASSERT2(i < _size,"static_vector: index out of range");
             return data()[i];
         }
-        const_reference at(size_type i) const
+        FRYSTL_CONSTEXPR20 const_reference at(size_type i) const
         {
             Verify(i < _size);
             return data()[i];
         }
-        const_reference operator[](size_type i) const noexcept
+        FRYSTL_CONSTEXPR20 const_reference operator[](size_type i) const noexcept
         {
             FRYSTL_ASSERT2(i < _size,"static_vector: index out of range");
             return data()[i];
         }
-        reference back() noexcept 
+        FRYSTL_CONSTEXPR20 reference back() noexcept 
         { 
             FRYSTL_ASSERT2(_size,"back() called on empty static_vector");
             return data()[_size - 1]; 
         }
-        const_reference back() const noexcept 
+        FRYSTL_CONSTEXPR20 const_reference back() const noexcept 
         { 
             FRYSTL_ASSERT2(_size,"back() called on empty static_vector");
             return data()[_size - 1]; 
         }
-        reference front() noexcept
+        FRYSTL_CONSTEXPR20 reference front() noexcept
         {
             FRYSTL_ASSERT2(_size,"front() called on empty static_vector");
             return data()[0];
         }
-        const_reference front() const noexcept
+        FRYSTL_CONSTEXPR20 const_reference front() const noexcept
         {
             FRYSTL_ASSERT2(_size,"front() called on empty static_vector");
             return data()[0];
@@ -217,56 +364,75 @@ namespace frystl
         //
         // Iterators
         //
-        iterator begin() noexcept { return data(); }
-        const_iterator begin() const noexcept { return data(); }
-        const_iterator cbegin() const noexcept { return data(); }
-        iterator end() noexcept { return data() + _size; }
-        const_iterator end() const noexcept { return data() + _size; }
-        const_iterator cend() const noexcept { return data() + _size; }
-        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
-        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
-        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
-        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
-        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
-        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+        FRYSTL_CONSTEXPR20 iterator begin() noexcept { return data(); }
+        FRYSTL_CONSTEXPR20 const_iterator begin() const noexcept { return data(); }
+        FRYSTL_CONSTEXPR20 const_iterator cbegin() const noexcept { return data(); }
+        FRYSTL_CONSTEXPR20 iterator end() noexcept { return data() + _size; }
+        FRYSTL_CONSTEXPR20 const_iterator end() const noexcept { return data() + _size; }
+        FRYSTL_CONSTEXPR20 const_iterator cend() const noexcept { return data() + _size; }
+        FRYSTL_CONSTEXPR20 reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        FRYSTL_CONSTEXPR20 const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        FRYSTL_CONSTEXPR20 const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+        FRYSTL_CONSTEXPR20 reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        FRYSTL_CONSTEXPR20 const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        FRYSTL_CONSTEXPR20 const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
         //
         // Capacity and size
         //
         constexpr std::size_t capacity() const noexcept { return Capacity; }
         constexpr std::size_t max_size() const noexcept { return Capacity; }
-        size_type size() const noexcept { return _size; }
-        bool empty() const noexcept { return _size == 0; }
-        void reserve(size_type n) noexcept { 
+        FRYSTL_CONSTEXPR20 size_type size() const noexcept { return _size; }
+        FRYSTL_CONSTEXPR20 bool empty() const noexcept { return _size == 0; }
+        FRYSTL_CONSTEXPR20 void reserve(size_type n) noexcept { 
             FRYSTL_ASSERT2(n <= capacity(), "static_vector::reserve() argument too large"); 
         }
-        void shrink_to_fit() noexcept {}
+        FRYSTL_CONSTEXPR20 void shrink_to_fit() noexcept {}
         //
         //  Modifiers
         //
-        void pop_back() noexcept
+        FRYSTL_CONSTEXPR20 void pop_back() noexcept
         {
             FRYSTL_ASSERT2(_size, "static_vector::pop_back() on empty vector");
             _size -= 1;
             Destroy(end());
         }
-        void push_back(const T &cd) { emplace_back(cd); }
-        void push_back(T &&cd) noexcept { emplace_back(std::move(cd)); }
-        void clear() noexcept
+        FRYSTL_CONSTEXPR20 void push_back(const T &cd) { emplace_back(cd); }
+        FRYSTL_CONSTEXPR20 void push_back(T &&cd) noexcept { emplace_back(std::move(cd)); }
+        FRYSTL_CONSTEXPR20 void clear() noexcept
         {
             while (_size)
                 pop_back();
         }
-        iterator erase(const_iterator position) noexcept
+        FRYSTL_CONSTEXPR20 iterator erase(const_iterator position) noexcept
         {
             FRYSTL_ASSERT2(GoodIter(position + 1), 
                 "static_vector::erase(pos): pos out of range");
             iterator x = const_cast<iterator>(position);
-            Destroy(x);
-            std::move(x + 1, end(), x);
+            if (Relocating()) {
+                Destroy(x);
+                RelocateElements(x, x + 1, end() - x - 1);
+            }
+            else {
+                std::move(x + 1, end(), x);
+                Destroy(end() - 1);
+            }
             _size -= 1;
             return x;
         }
-        iterator erase(const_iterator first, const_iterator last)
+        // Erase the element at position by moving the last element into
+        // its place.  Unlike erase(), this takes constant time but does
+        // not keep the order of the elements.
+        FRYSTL_CONSTEXPR20 iterator erase_unordered(const_iterator position) noexcept
+        {
+            FRYSTL_ASSERT2(GoodIter(position + 1),
+                "static_vector::erase_unordered(pos): pos out of range");
+            iterator p = const_cast<iterator>(position);
+            if (p != end() - 1)
+                *p = std::move(back());
+            pop_back();
+            return p;
+        }
+        FRYSTL_CONSTEXPR20 iterator erase(const_iterator first, const_iterator last)
         {
             iterator f = const_cast<iterator>(first);
             iterator l = const_cast<iterator>(last);
@@ -278,56 +444,100 @@ namespace frystl
                     "static_vector::erase(first,last): bad last");
                 FRYSTL_ASSERT2(first < last,
                     "static_vector::erase(first,last): last < first");
-                for (iterator it = f; it < l; ++it)
-                    Destroy(it);
-                std::move(l, end(), f);
+                iterator oldEnd = end();
+                if (Relocating()) {
+                    for (iterator it = f; it < l; ++it)
+                        Destroy(it);
+                    RelocateElements(f, l, oldEnd - l);
+                }
+                else {
+                    // move the tail down, then destroy the cells it left
+                    for (iterator it = std::move(l, oldEnd, f); it < oldEnd; ++it)
+                        Destroy(it);
+                }
                 _size -= last - first;
             }
             return f;
         }
         template <class... Args>
-        iterator emplace(const_iterator position, Args &&...args)
+        FRYSTL_CONSTEXPR20 iterator emplace(const_iterator position, Args &&...args)
         {
             FRYSTL_ASSERT2(_size < Capacity,"static_vector::emplace() overflow");
             FRYSTL_ASSERT2(begin() <= position && position <= end(),
                 "static_vector::emplace(): bad position");
             iterator p = const_cast<iterator>(position);
             MakeRoom(p, 1);
-            if (p < end())
-                (*p) = value_type(std::forward<Args>(args)...);
-            else 
-                Construct(p, std::forward<Args>(args)...);
-            ++_size;
+            FillRoom(p, 1, [&](iterator q) { FillCell(q, std::forward<Args>(args)...); });
             return p;
         }
         template <class... Args>
-        [[maybe_unused]] reference emplace_back(Args && ... args)
+        [[maybe_unused]] FRYSTL_CONSTEXPR20 reference emplace_back(Args && ... args)
         {
             FRYSTL_ASSERT2(_size < Capacity,"static_vector::emplace_back() overflow");
             Construct(end(), std::forward<Args>(args)...);
             ++_size;
             return back();
         }
+        // The following functions are as in std::inplace_vector.
+        // If the vector is full, try_emplace_back() and try_push_back()
+        // return nullptr and leave their arguments unchanged.  Otherwise
+        // they append an element and return a pointer to it.
+        template <class... Args>
+        FRYSTL_CONSTEXPR20 pointer try_emplace_back(Args && ... args)
+        {
+            if (_size == Capacity)
+                return nullptr;
+            return &unchecked_emplace_back(std::forward<Args>(args)...);
+        }
+        FRYSTL_CONSTEXPR20 pointer try_push_back(const T &value) 
+        { 
+            return try_emplace_back(value); 
+        }
+        FRYSTL_CONSTEXPR20 pointer try_push_back(T &&value) 
+        { 
+            return try_emplace_back(std::move(value)); 
+        }
+        // The unchecked_ functions require that the vector not be full.
+        // Like emplace_back(), they check that only if FRYSTL_DEBUG is
+        // defined.
+        template <class... Args>
+        FRYSTL_CONSTEXPR20 reference unchecked_emplace_back(Args && ... args)
+        {
+            FRYSTL_ASSERT2(_size < Capacity,"static_vector::unchecked_emplace_back() overflow");
+            pointer p = end();
+            Construct(p, std::forward<Args>(args)...);
+            ++_size;
+            return *p;
+        }
+        FRYSTL_CONSTEXPR20 reference unchecked_push_back(const T &value) 
+        { 
+            return unchecked_emplace_back(value); 
+        }
+        FRYSTL_CONSTEXPR20 reference unchecked_push_back(T &&value) 
+        { 
+            return unchecked_emplace_back(std::move(value)); 
+        }
         // single element insert()
-        iterator insert(const_iterator position, const value_type &val)
+        FRYSTL_CONSTEXPR20 iterator insert(const_iterator position, const value_type &val)
         {
             FRYSTL_ASSERT2(_size < Capacity, "static_vector::insert: overflow");
-            FRYSTL_ASSERT2(GoodIter(position),"static_vector::insert(): bad position");
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "static_vector::insert(): bad position");
             iterator p = const_cast<iterator>(position);
             MakeRoom(p,1);
-            FillCell(p, val);
-            ++_size;
+            FillRoom(p, 1, [&val, this](iterator q) { FillCell(q, val); });
             return p;
         }
         // move insert()
-        iterator insert(const_iterator position, value_type &&val) noexcept
+        FRYSTL_CONSTEXPR20 iterator insert(const_iterator position, value_type &&val) noexcept
         {
             FRYSTL_ASSERT2(_size < Capacity, "static_vector::insert: overflow");
-            FRYSTL_ASSERT2(GoodIter(position),"static_vector::insert(): bad position");
+            FRYSTL_ASSERT2(begin() <= position && position <= end(),
+                "static_vector::insert(): bad position");
             return emplace(position, std::move(val));
         }
         // fill insert
-        iterator insert(const_iterator position, size_type n, const value_type &val)
+        FRYSTL_CONSTEXPR20 iterator insert(const_iterator position, size_type n, const value_type &val)
         {
             FRYSTL_ASSERT2(_size + n <= Capacity, "static_vector::insert: overflow");
             FRYSTL_ASSERT2(begin() <= position && position <= end(),
@@ -335,18 +545,14 @@ namespace frystl
             iterator p = const_cast<iterator>(position);
             MakeRoom(p, n);
             // copy val n times into newly available cells
-            for (iterator i = p; i < p + n; ++i)
-            {
-                FillCell(i, val);
-            }
-            _size += n;
+            FillRoom(p, n, [&val, this](iterator q) { FillCell(q, val); });
             return p;
         }
         // range insert()
         private:
             // implementation for iterators lacking operator-()
             template <class InpIter>
-            iterator insert(
+            FRYSTL_CONSTEXPR20 iterator insert(
                 const_iterator position, 
                 InpIter first, 
                 InpIter last,
@@ -362,7 +568,7 @@ namespace frystl
             }
             // Implementation for iterators with operator-()
             template <class DAIter>
-            iterator insert(
+            FRYSTL_CONSTEXPR20 iterator insert(
                 const_iterator position, 
                 DAIter first, 
                 DAIter last,
@@ -370,25 +576,21 @@ namespace frystl
             {
                 FRYSTL_ASSERT2(first <= last,"static_vector::insert(): last < first");
                 iterator p = const_cast<iterator>(position);
-                int n = last-first;
+                size_type n = last-first;
                 FRYSTL_ASSERT2(_size + n <= Capacity, "static_vector::insert: overflow");
                 MakeRoom(p,n);
-                iterator result = p;
-                while (first != last) {
-                    Construct(p++, *first++);
-                }
-                _size += n;
-                return result;
+                FillRoom(p, n, [&first, this](iterator q) { FillCell(q, *first++); });
+                return p;
             }
         public:
         template <class Iter>
-        iterator insert(const_iterator position, Iter first, Iter last)
+        FRYSTL_CONSTEXPR20 iterator insert(const_iterator position, Iter first, Iter last)
         {
             return insert(position,first,last,
                 typename std::iterator_traits<Iter>::iterator_category());
         }
         // initializer list insert()
-        iterator insert(const_iterator position, std::initializer_list<value_type> il)
+        FRYSTL_CONSTEXPR20 iterator insert(const_iterator position, std::initializer_list<value_type> il)
         {
             size_type n = il.size();
             FRYSTL_ASSERT2(_size + n <= Capacity, "static_vector::insert: overflow");
@@ -398,14 +600,43 @@ namespace frystl
             MakeRoom(p, n);
             // copy il into newly available cells
             auto j = il.begin();
-            for (iterator i = p; i < p + n; ++i, ++j)
-            {
-                FillCell(i, *j);
-            }
-            _size += n;
+            FillRoom(p, n, [&j, this](iterator q) { FillCell(q, *j++); });
             return p;
         }
-        void resize(size_type n, const value_type &val)
+        // Insert the elements [first, last), which must be sorted by comp,
+        // into this vector, which must also be sorted by comp, keeping it
+        // sorted.  The new elements go after existing elements equivalent
+        // to them.  The elements are merged from the back, so each one moves 
+        // at most once: O(size()+n) rather than O(size()*n) for n single
+        // insert() calls.
+        template <class BidirIter, class Compare = std::less<value_type>>
+        FRYSTL_CONSTEXPR20 void insert_sorted_batch(BidirIter first, BidirIter last, Compare comp = Compare())
+        {
+            size_type n = std::distance(first, last);
+            FRYSTL_ASSERT2(_size + n <= Capacity, 
+                "static_vector::insert_sorted_batch(): overflow");
+            MergeBackward(begin(), end(), n,
+                [&last]() -> decltype(auto) { return *--last; },
+                [&](const_reference e, size_type) { return comp(*std::prev(last), e); });
+            _size += n;
+        }
+        // Insert values[i] for each i in [0, n), where n = posLast-posFirst,
+        // before the element whose index was positions[i] before the call 
+        // (at the end if positions[i] == size()).  The positions must be in
+        // ascending order.  Values with equal positions keep their order.
+        // Each element moves at most once.
+        template <class PosIter, class ValIter>
+        FRYSTL_CONSTEXPR20 void insert_many(PosIter posFirst, PosIter posLast, ValIter values)
+        {
+            size_type n = std::distance(posFirst, posLast);
+            FRYSTL_ASSERT2(_size + n <= Capacity, "static_vector::insert_many(): overflow");
+            ValIter valLast = std::next(values, n);
+            MergeBackward(begin(), end(), n,
+                [&]() -> decltype(auto) { --posLast; return *--valLast; },
+                [&](const_reference, size_type i) { return *std::prev(posLast) <= i; });
+            _size += n;
+        }
+        FRYSTL_CONSTEXPR20 void resize(size_type n, const value_type &val)
         {
             FRYSTL_ASSERT2(n <= Capacity, "static_vector::resize: overflow");
             while (n < size())
@@ -413,15 +644,38 @@ namespace frystl
             while (size() < n)
                 push_back(val);
         }
-        void resize(size_type n)
+        FRYSTL_CONSTEXPR20 void resize(size_type n)
         {
             FRYSTL_ASSERT2(n <= Capacity, "static_vector::resize: overflow");
             while (n < size())
                 pop_back();
-            while (size() < n)
-                emplace_back();
+            FillBack(n - size(), [](pointer p) { Construct(p); });
         }
-        void swap(this_type &x) noexcept
+        // Like resize(n), but new elements are default-initialized, so
+        // if T is trivial they are left uninitialized.
+        void resize_default_init(size_type n)
+        {
+            FRYSTL_ASSERT2(n <= Capacity, "static_vector::resize_default_init: overflow");
+            while (n < size())
+                pop_back();
+            FillBack(n - size(), [](pointer p) { DefaultConstruct(p); });
+        }
+        // Append the elements of rg, which may be any range with begin()
+        // and end(), such as a container.  If its iterators are forward
+        // iterators, capacity is checked once.
+        template <class Range>
+        FRYSTL_CONSTEXPR20 void append_range(Range &&rg)
+        {
+            AppendRange(std::begin(rg), std::end(rg), typename std::iterator_traits<
+                decltype(std::begin(rg))>::iterator_category());
+        }
+        // Append n elements, each constructed from the value of f().
+        template <class Generator>
+        FRYSTL_CONSTEXPR20 void generate_back(size_type n, Generator f)
+        {
+            FillBack(n, [&f](pointer p) { Construct(p, f()); });
+        }
+        FRYSTL_CONSTEXPR20 void swap(this_type &x) noexcept
         {
             std::swap(*this, x);
         }
@@ -429,19 +683,29 @@ namespace frystl
         //******* Private member functions:
         //
     private:
-        using storage_type =
-            std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
-        size_type _size;
-        storage_type _elem[Capacity];
+        using base_type = StaticVectorBase<T, Capacity>;
+        using base_type::_size;
 
-        static void Verify(bool cond)
+        FRYSTL_CONSTEXPR20 static void Verify(bool cond)
         {
             if (!cond)
                 throw std::out_of_range("static_vector range error");
         }
+        // True if elements are shifted with memmove() instead of moved
+        // one at a time.
+        static FRYSTL_CONSTEXPR20 bool Relocating() noexcept
+        {
+            return is_trivially_relocatable<T>::value && !ConstantEvaluated();
+        }
         // Move cells at and to the right of p to the right by n spaces.
-        void MakeRoom(iterator p, size_type n) noexcept
+        // If Relocating(), the n cells at p are left raw; otherwise those
+        // before end() hold moved-from elements.
+        FRYSTL_CONSTEXPR20 void MakeRoom(iterator p, size_type n) noexcept
         {
+            if (Relocating()) {
+                RelocateElements(p + n, p, end() - p);
+                return;
+            }
             size_type nu = std::min(size_type(end() - p), n);
             // fill the uninitialized target cells by move construction
             for (iterator src = end()-nu; src < end(); src++)
@@ -449,15 +713,76 @@ namespace frystl
             // shift elements to previously occupied cells by move assignment
             std::move_backward(p, end() - nu, end());
         }
+        // Fill the n cells at p that MakeRoom(p, n) opened by calling
+        // fill(q) for each cell q in order, and count them in the size.
+        // If a call throws, shift the tail back and destroy what is left
+        // past end(): the cells filled there and, unless MakeRoom()
+        // relocated the tail, the cells it was moved into.
+        template <class Fill>
+        FRYSTL_CONSTEXPR20 void FillRoom(iterator p, size_type n, Fill fill)
+        {
+            iterator q = p;
+            try {
+                for (; q < p + n; ++q)
+                    fill(q);
+            }
+            catch (...) {
+                if (Relocating()) {
+                    for (iterator r = p; r < q; ++r)
+                        Destroy(r);
+                    RelocateElements(p, p + n, end() - p);
+                }
+                else {
+                    iterator oldEnd = end();
+                    std::move(p + n, oldEnd + n, p);
+                    for (iterator r = oldEnd; r < q; ++r)
+                        Destroy(r);
+                    for (iterator r = std::max(p + n, oldEnd); r < oldEnd + n; ++r)
+                        Destroy(r);
+                }
+                throw;
+            }
+            _size += n;
+        }
+        // Construct n elements after the last by calling construct(p) for
+        // each new cell p in order.  If a call throws, the elements already
+        // constructed are kept.
+        template <class Construct1>
+        FRYSTL_CONSTEXPR20 void FillBack(size_type n, Construct1 construct)
+        {
+            FRYSTL_ASSERT2(_size + n <= Capacity, "static_vector: overflow");
+            pointer p = end();
+            pointer last = p + n;
+            try {
+                for (; p < last; ++p)
+                    construct(p);
+            }
+            catch (...) {
+                _size = p - data();
+                throw;
+            }
+            _size += n;
+        }
+        template <class FwdIter>
+        FRYSTL_CONSTEXPR20 void AppendRange(FwdIter first, FwdIter last, std::forward_iterator_tag)
+        {
+            FillBack(std::distance(first, last), [&first](pointer p) { Construct(p, *first++); });
+        }
+        template <class InpIter>
+        FRYSTL_CONSTEXPR20 void AppendRange(InpIter first, InpIter last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
         // returns true iff it-1 can be dereferenced.
-        bool GoodIter(const const_iterator &it) noexcept
+        FRYSTL_CONSTEXPR20 bool GoodIter(const const_iterator &it) noexcept
         {
             return begin() < it && it <= end();
         }
         template <class... Args>
-        void FillCell(iterator pos, Args && ... args)
+        FRYSTL_CONSTEXPR20 void FillCell(iterator pos, Args && ... args)
         {
-            if (pos < end())
+            if (pos < end() && !Relocating())
                 // fill previously occupied cell using assignment
                 (*pos)  = value_type(std::forward<Args>(args)...);
             else 
@@ -470,42 +795,200 @@ namespace frystl
     //*******  Non-member overloads
     //
     template <class T, unsigned C0, unsigned C1>
-    bool operator==(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
+    FRYSTL_CONSTEXPR20 bool operator==(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
     {
         if (lhs.size() != rhs.size())
             return false;
-        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        return EqualElements(lhs.data(), rhs.data(), lhs.size());
     }
     template <class T, unsigned C0, unsigned C1>
-    bool operator!=(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
+    FRYSTL_CONSTEXPR20 bool operator!=(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
     {
         return !(rhs == lhs);
     }
     template <class T, unsigned C0, unsigned C1>
-    bool operator<(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
+    FRYSTL_CONSTEXPR20 bool operator<(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
     {
-        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        return LessElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
     }
     template <class T, unsigned C0, unsigned C1>
-    bool operator<=(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
+    FRYSTL_CONSTEXPR20 bool operator<=(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
     {
         return !(rhs < lhs);
     }
     template <class T, unsigned C0, unsigned C1>
-    bool operator>(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
+    FRYSTL_CONSTEXPR20 bool operator>(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
     {
         return rhs < lhs;
     }
     template <class T, unsigned C0, unsigned C1>
-    bool operator>=(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
+    FRYSTL_CONSTEXPR20 bool operator>=(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs) noexcept
     {
         return !(lhs < rhs);
     }
+#ifdef FRYSTL_HAS_THREE_WAY
+    template <class T, unsigned C0, unsigned C1>
+    constexpr auto operator<=>(const static_vector<T, C0> &lhs, const static_vector<T, C1> &rhs)
+    {
+        return ThreeWayElements(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+    }
+#endif
 
     template <class T, unsigned C>
-    void swap(static_vector<T, C> &a, static_vector<T, C> &b) noexcept
+    FRYSTL_CONSTEXPR20 void swap(static_vector<T, C> &a, static_vector<T, C> &b) noexcept
     {
         a.swap(b);
     }
+    // Erase the elements of c for which pred returns true, keeping the
+    // order of the others, in one pass.  Return the number erased.
+    template <class T, unsigned C, class Pred>
+    FRYSTL_CONSTEXPR20 size_t erase_if(static_vector<T, C> &c, Pred pred)
+    {
+        return EraseIf(c, pred);
+    }
+    // Erase the elements of c at the positions in indices, which must be
+    // sorted in ascending order, keeping the order of the others, in one
+    // pass.  Return the number erased.
+    template <class T, unsigned C, class Indices>
+    FRYSTL_CONSTEXPR20 size_t erase_indices(static_vector<T, C> &c, const Indices &indices)
+    {
+        using std::begin;
+        using std::end;
+        return EraseIndices(c, begin(indices), end(indices));
+    }
+    // Return an iterator to the first element of v equal to value, or
+    // v.end() if there is none.
+    template <class T, unsigned C>
+    const T *find(const static_vector<T, C> &v, 
+        const typename static_vector<T, C>::value_type &value)
+    {
+        if constexpr (SimdSearchable<T>)
+            return v.begin() + SimdFind(v.data(), v.size(), value);
+        else
+            return std::find(v.begin(), v.end(), value);
+    }
+    template <class T, unsigned C>
+    T *find(static_vector<T, C> &v, const typename static_vector<T, C>::value_type &value)
+    {
+        return v.begin() + (find(std::as_const(v), value) - v.cbegin());
+    }
+    // Return the number of elements of v equal to value.
+    template <class T, unsigned C>
+    size_t count(const static_vector<T, C> &v, 
+        const typename static_vector<T, C>::value_type &value)
+    {
+        if constexpr (SimdSearchable<T>)
+            return SimdCount(v.data(), v.size(), value);
+        else
+            return std::count(v.begin(), v.end(), value);
+    }
+    // Return true if an element of v equals value.
+    template <class T, unsigned C>
+    bool contains(const static_vector<T, C> &v, 
+        const typename static_vector<T, C>::value_type &value)
+    {
+        return find(v, value) != v.end();
+    }
+    // Return an iterator to the first least element of v, or v.end()
+    // if v is empty.
+    template <class T, unsigned C>
+    const T *min_element(const static_vector<T, C> &v)
+    {
+        if constexpr (SimdSearchable<T>)
+            return v.begin() + SimdExtreme<false>(v.data(), v.size());
+        else
+            return std::min_element(v.begin(), v.end());
+    }
+    template <class T, unsigned C>
+    T *min_element(static_vector<T, C> &v)
+    {
+        return v.begin() + (min_element(std::as_const(v)) - v.cbegin());
+    }
+    // Return an iterator to the first greatest element of v, or v.end()
+    // if v is empty.
+    template <class T, unsigned C>
+    const T *max_element(const static_vector<T, C> &v)
+    {
+        if constexpr (SimdSearchable<T>)
+            return v.begin() + SimdExtreme<true>(v.data(), v.size());
+        else
+            return std::max_element(v.begin(), v.end());
+    }
+    template <class T, unsigned C>
+    T *max_element(static_vector<T, C> &v)
+    {
+        return v.begin() + (max_element(std::as_const(v)) - v.cbegin());
+    }
+    // Sort v by key(element), which must return an unsigned integer, with a
+    // stable least-significant-digit radix sort using 8-bit digits.  Passes
+    // on digits shared by all the elements are skipped.  Elements are
+    // scattered back and forth between v and a scratch buffer of Capacity 
+    // elements on the stack.  Short vectors are insertion sorted instead.
+    // T must be trivially copyable.
+    template <class T, unsigned C, class KeyFn>
+    void radix_sort(static_vector<T, C> &v, KeyFn key)
+    {
+        using Key = RadixKey<T, KeyFn>;
+        static_assert(std::is_trivially_copyable<T>::value,
+            "radix_sort() requires a trivially copyable type");
+        static_assert(std::is_unsigned<Key>::value,
+            "radix_sort() requires an unsigned integer key");
+        const uint32_t n = v.size();
+        T *src = v.data();
+        if (n <= 32) {
+            for (uint32_t i = 1; i < n; ++i) {
+                T x = src[i];
+                Key k = key(x);
+                uint32_t j = i;
+                for (; j > 0 && k < key(src[j - 1]); --j)
+                    src[j] = src[j - 1];
+                src[j] = x;
+            }
+            return;
+        }
+        std::aligned_storage_t<sizeof(T), alignof(T)> scratch[C];
+        T *dst = reinterpret_cast<T *>(scratch);
+        for (unsigned shift = 0; shift < 8 * sizeof(Key); shift += 8) {
+            uint32_t next[256] = {};
+            for (uint32_t i = 0; i < n; ++i)
+                ++next[(key(src[i]) >> shift) & 0xff];
+            if (std::find(next, next + 256, n) != next + 256)
+                continue;
+            for (uint32_t d = 0, sum = 0; d < 256; ++d) {
+                uint32_t count = next[d];
+                next[d] = sum;
+                sum += count;
+            }
+            for (uint32_t i = 0; i < n; ++i)
+                std::memcpy(static_cast<void *>(dst + next[(key(src[i]) >> shift) & 0xff]++),
+                    src + i, sizeof(T));
+            std::swap(src, dst);
+        }
+        if (src != v.data())
+            std::memcpy(static_cast<void *>(v.data()), src, n * sizeof(T));
+    }
+    // Sort v by comp with the sorting network for its size, chosen from
+    // those for sizes up to C, or by insertion if it has more than 16
+    // elements, which takes quadratic time.  For small vectors of small
+    // trivially copyable types this is several times faster than
+    // std::sort().  It is not stable.  See frystl-sort.hpp.
+    template <class T, unsigned C, class Compare = std::less<T>>
+    void small_sort(static_vector<T, C> &v, Compare comp = Compare())
+    {
+        SmallSort<C>(v.data(), v.size(), comp);
+    }
 };     // namespace frystl
+
+namespace std
+{
+    // Hash the elements of a static_vector.  See frystl-hash.hpp.
+    template <class T, unsigned C>
+    struct hash<frystl::static_vector<T, C>>
+    {
+        size_t operator()(const frystl::static_vector<T, C> &c) const
+        {
+            return size_t(frystl::HashRange(c.data(), c.size()));
+        }
+    };
+}       // namespace std
 #endif // ndef FRYSTL_STATIC_VECTOR
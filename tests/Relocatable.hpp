@@ -0,0 +1,63 @@
+#ifndef RELOCATABLE_HPP
+#define RELOCATABLE_HPP
+
+#include <memory>       // unique_ptr
+#include <stdexcept>    // runtime_error
+#include <type_traits>  // true_type
+#include "frystl-defines.hpp"
+
+// An element that owns a heap int, counts the live instances, and
+// throws from its copy constructor if its value is negative.
+// frystl::is_trivially_relocatable is specialized for it, so the
+// containers shift it with memmove().  Unrelocatable is the same
+// type without the specialization.
+
+struct Relocatable {
+    Relocatable(int val)
+        : _p(new int(val))
+        {
+            ++count;
+        }
+    Relocatable(const Relocatable& other)
+        : _p(new int(Checked(*other._p)))
+        {
+            ++count;
+        }
+    Relocatable(Relocatable&& other) noexcept
+        : _p(std::move(other._p))
+        {
+            ++count;
+        }
+    Relocatable& operator=(Relocatable&& other) noexcept = default;
+    Relocatable& operator=(const Relocatable& other)
+    {
+        *_p = Checked(*other._p);
+        return *this;
+    }
+    ~Relocatable()
+    {
+        --count;
+    }
+    int operator()() const noexcept {return _p ? *_p : 0;}
+    static int Count() {return count;}
+private:
+    std::unique_ptr<int> _p;
+    static int count;
+    static int Checked(int val)
+    {
+        if (val < 0)
+            throw std::runtime_error("Relocatable copy of a negative value");
+        return val;
+    }
+};
+int Relocatable::count = 0;
+
+struct Unrelocatable : Relocatable {
+    using Relocatable::Relocatable;
+};
+
+namespace frystl {
+    template <>
+    struct is_trivially_relocatable<Relocatable> : std::true_type {};
+}
+#endif // ndef RELOCATABLE_HPP
@@ -0,0 +1,93 @@
+// Test driver for external_sorter and external_sort()
+
+#define FRYSTL_DEBUG
+#include "external_sort.hpp"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <list>
+#include <algorithm>    // sort, unique
+#include <functional>   // greater
+#include <iostream>
+
+using namespace frystl;
+
+// Return n pseudorandom values less than limit.
+static std::vector<uint32_t> Random(unsigned n, uint32_t limit)
+{
+    std::vector<uint32_t> result;
+    uint32_t r = 17 + n;
+    for (unsigned i = 0; i < n; ++i) {
+        r = r * 1103515245 + 12345;
+        result.push_back((r >> 8) % limit);
+    }
+    return result;
+}
+
+int main() {
+    {
+        // everything fits in memory
+        std::vector<uint32_t> in = Random(1000, 1000000);
+        external_sorter<uint32_t> sorter(1 << 20);
+        for (auto v : in) sorter.push_back(v);
+        assert(sorter.size() == 1000);
+        std::vector<uint32_t> out;
+        sorter.merge([&out](uint32_t v) {out.push_back(v);});
+        assert(sorter.size() == 0);
+        std::sort(in.begin(), in.end());
+        assert(out == in);
+    }
+    {
+        // several runs merged at once
+        std::vector<uint32_t> in = Random(10000, 1000000);
+        external_sorter<uint32_t, std::greater<uint32_t>> sorter(4096, std::greater<uint32_t>(), 256);
+        for (auto v : in) sorter.push_back(v);
+        mf_vector<uint32_t> out;
+        sorter.merge(out);
+        std::sort(in.begin(), in.end(), std::greater<uint32_t>());
+        assert(out.size() == in.size());
+        assert(std::equal(in.begin(), in.end(), out.begin()));
+
+        // the sorter can be reused
+        for (auto v : in) sorter.push_back(v);
+        out.clear();
+        sorter.merge(out);
+        assert(std::equal(in.begin(), in.end(), out.begin()));
+    }
+    {
+        // too many runs to merge at once, with duplicates removed
+        std::vector<uint32_t> in = Random(50000, 5000);
+        external_sorter<uint32_t> sorter(1024, std::less<uint32_t>(), 128);
+        for (auto v : in) sorter.push_back(v);
+        std::vector<uint32_t> out;
+        sorter.merge([&out](uint32_t v) {out.push_back(v);}, true);
+        std::sort(in.begin(), in.end());
+        in.erase(std::unique(in.begin(), in.end()), in.end());
+        assert(out == in);
+    }
+    {
+        // external_sort() on a range
+        std::vector<uint32_t> in = Random(20000, 100);
+        std::list<uint32_t> li(in.begin(), in.end());
+        std::vector<uint32_t> out;
+        external_sort(li.begin(), li.end(), [&out](uint32_t v) {out.push_back(v);},
+            2000, std::less<uint32_t>(), true);
+        assert(out.size() == 100);
+        for (uint32_t i = 0; i < 100; ++i)
+            assert(out[i] == i);
+    }
+    {
+        // external_sort() on an mf_vector
+        std::vector<uint32_t> in = Random(30000, 1u << 30);
+        mf_vector<uint32_t, 64> v(in.begin(), in.end());
+        external_sort(v, 10000);
+        std::sort(in.begin(), in.end());
+        assert(v.size() == in.size());
+        assert(std::equal(in.begin(), in.end(), v.begin()));
+
+        mf_vector<uint32_t, 64> empty;
+        external_sort(empty, 10000);
+        assert(empty.size() == 0);
+    }
+    std::cout << "test-es finished normally." << std::endl;
+}
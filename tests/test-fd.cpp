@@ -0,0 +1,222 @@
+// Test driver for fixed_deque
+
+#define FRYSTL_DEBUG
+#include "fixed_deque.hpp"
+#include "SelfCount.hpp"
+#include "Relocatable.hpp"
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <list>
+#include <string>
+
+using namespace frystl;
+
+// Make random inserts and erases in c, and the same changes to a
+// vector of ints, checking that they agree.  make(v) returns an
+// element holding v; value(e) returns the int held by e.
+template <class C, class Make, class Value>
+static void TestShifting(C &c, unsigned maxSize, Make make, Value value)
+{
+    std::vector<int> model;
+    uint32_t r = 1;
+    for (int i = 0; i < 3000; ++i) {
+        r = r * 1103515245 + 12345;
+        unsigned pos = (r >> 4) % (model.size() + 1);
+        int v = int(r >> 20);
+        switch ((r >> 16) % 6) {
+        case 0:
+            if (model.size() < maxSize) {
+                c.insert(c.begin() + pos, make(v));
+                model.insert(model.begin() + pos, v);
+            }
+            break;
+        case 1:
+            if (model.size() < maxSize) {
+                c.emplace(c.begin() + pos, make(v));
+                model.insert(model.begin() + pos, v);
+            }
+            break;
+        case 2:
+            if (pos < model.size()) {
+                c.erase(c.begin() + pos);
+                model.erase(model.begin() + pos);
+            }
+            break;
+        case 3: {
+            unsigned n = std::min<unsigned>((r >> 24) % 4, model.size() - pos);
+            c.erase(c.begin() + pos, c.begin() + pos + n);
+            model.erase(model.begin() + pos, model.begin() + pos + n);
+            break;
+        }
+        case 4:
+            if (model.size() < maxSize) {
+                c.emplace_front(make(v));
+                model.insert(model.begin(), v);
+            }
+            break;
+        case 5:
+            if (!model.empty()) {
+                c.pop_front();
+                model.erase(model.begin());
+            }
+            break;
+        }
+        assert(c.size() == model.size());
+        for (unsigned j = 0; j < model.size(); ++j)
+            assert(value(c[j]) == model[j]);
+    }
+}
+// Check that inserts into d whose copies throw leave it unchanged.
+// d must hold the values 0 to 7.
+template <class C>
+static void TestThrowingInsert(C &d)
+{
+    using T = std::decay_t<decltype(d.front())>;
+    const T src[] = {7, -1, 8};
+    const int count = Relocatable::Count();
+    auto same = [&d, count]() {
+        for (int i = 0; i < 8; ++i)
+            if (d[i]() != i)
+                return false;
+        return d.size() == 8 && Relocatable::Count() == count;
+    };
+    for (unsigned at : {1u, 3u, 6u}) {
+        try {
+            d.insert(d.begin() + at, src, src + 3);
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+        try {
+            d.insert(d.begin() + at, {T(7), T(-1)});
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+        try {
+            d.emplace(d.begin() + at, src[1]);
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+    }
+    d.insert(d.begin() + 2, src, src + 1);
+    assert(d.size() == 9 && d[2]() == 7 && d[3]() == 2);
+}
+int main() {
+    {
+        // Constructors
+        fixed_deque<int> none;
+        assert(none.capacity() == 0 && none.empty());
+        fixed_deque<int> fill(20, 17, -6);
+        assert(fill.size() == 17 && fill.capacity() == 20);
+        for (int k : fill) assert(k == -6);
+        std::list<int> li {1, 2, 3, 4, 5};
+        fixed_deque<int> range(10, li.begin(), li.end());
+        assert(range.size() == 5 && range[4] == 5);
+        fixed_deque<int> il(4, {9, 8, 7});
+        assert(il.size() == 3 && il.front() == 9 && il.back() == 7);
+        fixed_deque<int> copy(range);
+        assert(copy == range && copy.capacity() == 10);
+    }
+    assert(SelfCount::Count() == 0);
+    {
+        // Growth at both ends, sliding, and moving
+        fixed_deque<SelfCount> d(1000);
+        for (int i = 0; i < 400; ++i) {
+            d.emplace_back(i);
+            d.emplace_front(-1 - i);
+        }
+        assert(d.size() == 800 && int(d.front()()) == -400 && d.back()() == 399);
+        assert(SelfCount::Count() == 800 && SelfCount::OwnerCount() == 800);
+        // use it as a queue to force slides
+        for (int i = 400; i < 2000; ++i) {
+            d.pop_front();
+            d.emplace_back(i);
+        }
+        assert(d.size() == 800 && d.front()() == 1200 && d.back()() == 1999);
+        assert(SelfCount::Count() == 800 && SelfCount::OwnerCount() == 800);
+        d.erase(d.begin() + 10, d.begin() + 20);
+        assert(d.size() == 790 && d[10]() == 1220);
+        d.insert(d.begin() + 5, 10u, SelfCount(7));
+        assert(d.size() == 800 && d[5]() == 7 && d[15]() == 1205);
+        assert(SelfCount::OwnerCount() == 800);
+
+        const SelfCount* front = &d.front();
+        fixed_deque<SelfCount> e(std::move(d));
+        assert(&e.front() == front && e.size() == 800 && e.capacity() == 1000);
+        assert(d.empty() && d.capacity() == 0);
+        fixed_deque<SelfCount> f(3);
+        f.emplace_back(1);
+        f = std::move(e);
+        assert(&f.front() == front && e.empty() && e.capacity() == 3);
+        e.emplace_front(2);
+        assert(e.size() == 1 && SelfCount::Count() == 801);
+    }
+    assert(SelfCount::Count() == 0);
+    assert(SelfCount::OwnerCount() == 0);
+    {
+        // Assignment and comparison
+        fixed_deque<std::string> a(5, {"one", "two", "three"});
+        fixed_deque<std::string> b(3);
+        b = a;
+        assert(a == b && b.capacity() == 3);
+        b.pop_back();
+        assert(b < a && b != a);
+        swap(a, b);
+        assert(a.size() == 2 && a.capacity() == 3 && b.capacity() == 5);
+    }
+    {
+        // append_range(), resize_default_init(), generate_back()
+        fixed_deque<int> d(10);
+        d.append_range(std::list<int> {1, 2, 3});
+        int k = 4;
+        d.generate_back(7, [&k] { return k++; });
+        assert(d.size() == 10 && d.front() == 1 && d.back() == 10);
+        d.resize_default_init(4);
+        assert(d.size() == 4 && d.back() == 4);
+    }
+    {
+        // std::hash
+        std::hash<fixed_deque<int>> hasher;
+        fixed_deque<int> a(20, {1, 2, 3}), b(10, {1, 2, 3}), c(20, {1, 2, 4});
+        assert(hasher(a) == hasher(b) && hasher(a) != hasher(c));
+    }
+    {
+        // Shifting trivially relocatable elements with memmove() and
+        // others one at a time
+        static_assert(is_trivially_relocatable<std::unique_ptr<int>>::value, "unique_ptr");
+        static_assert(!is_trivially_relocatable<SelfCount>::value, "SelfCount");
+        fixed_deque<std::unique_ptr<int>> u(50);
+        TestShifting(u, 50,
+            [](int v) { return std::make_unique<int>(v); },
+            [](const std::unique_ptr<int> &p) { return *p; });
+        {
+            fixed_deque<SelfCount> s(50);
+            TestShifting(s, 50,
+                [](int v) { return SelfCount(v); },
+                [](const SelfCount &e) { return int(e()); });
+            assert(SelfCount::Count() == int(s.size()));
+            assert(SelfCount::OwnerCount() == int(s.size()));
+        }
+        assert(SelfCount::Count() == 0);
+    }
+    {
+        // An insert whose copy throws leaves the deque as it was.
+        {
+            fixed_deque<Relocatable> d(20);
+            for (int i = 0; i < 8; ++i)
+                d.emplace_back(i);
+            TestThrowingInsert(d);
+        }
+        {
+            fixed_deque<Unrelocatable> d(20);
+            for (int i = 0; i < 8; ++i)
+                d.emplace_back(i);
+            TestThrowingInsert(d);
+        }
+        assert(Relocatable::Count() == 0);
+    }
+    std::cout << "test-fd finished normally." << std::endl;
+}
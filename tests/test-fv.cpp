@@ -0,0 +1,105 @@
+// Test driver for fixed_vector
+
+#define FRYSTL_DEBUG
+#include "fixed_vector.hpp"
+#include "SelfCount.hpp"
+#include <iostream>
+#include <list>
+#include <string>
+
+using namespace frystl;
+
+int main() {
+    {
+        // Constructors
+        fixed_vector<int> none;
+        assert(none.capacity() == 0 && none.empty() && none.data() == nullptr);
+        fixed_vector<int> empty(1000000);
+        assert(empty.capacity() == 1000000 && empty.empty());
+        fixed_vector<int> fill(20, 17, -6);
+        assert(fill.size() == 17 && fill.capacity() == 20);
+        for (int k : fill) assert(k == -6);
+        std::list<int> li {1, 2, 3, 4, 5};
+        fixed_vector<int> range(10, li.begin(), li.end());
+        assert(range.size() == 5 && range[4] == 5);
+        fixed_vector<int> il(4, {9, 8, 7});
+        assert(il.size() == 3 && il.back() == 7);
+        fixed_vector<int> copy(range);
+        assert(copy == range && copy.capacity() == 10 && copy.data() != range.data());
+    }
+    assert(SelfCount::Count() == 0);
+    {
+        // Pointers stay valid until the capacity is reached
+        fixed_vector<SelfCount> v(100);
+        v.emplace_back(0);
+        const SelfCount* first = &v.front();
+        for (int i = 1; i < 100; ++i)
+            v.emplace_back(i);
+        assert(&v.front() == first && v.data() == first);
+        assert(v.try_emplace_back(100) == nullptr);
+        assert(SelfCount::Count() == 100 && SelfCount::OwnerCount() == 100);
+
+        // inserts and erases
+        v.erase(v.begin() + 10, v.begin() + 20);
+        assert(v.size() == 90 && v[10]() == 20);
+        SelfCount* p = v.try_push_back(SelfCount(-1));
+        assert(p == &v.back() && (*p)() == uint32_t(-1));
+        auto it = v.insert(v.begin(), SelfCount(-2));
+        assert(it == v.begin() && int(v[0]()) == -2 && v[1]() == 0);
+        it = v.insert(v.begin() + 5, 3, v[0]);
+        assert(v.size() == 95 && int(v[5]()) == -2 && int(v[7]()) == -2 && v[8]() == 4);
+        std::list<int> li {40, 41};
+        it = v.insert(v.begin() + 1, li.begin(), li.end());
+        assert(v.size() == 97 && (*it)() == 40 && v[3]() == 0);
+        assert(SelfCount::OwnerCount() == 97);
+        v.resize(10);
+        assert(v.size() == 10 && SelfCount::Count() == 10);
+
+        // move leaves the source empty with no buffer
+        fixed_vector<SelfCount> w(std::move(v));
+        assert(w.size() == 10 && w.data() == first && w.capacity() == 100);
+        assert(v.empty() && v.capacity() == 0);
+        fixed_vector<SelfCount> x(5);
+        x.emplace_back(1);
+        x = std::move(w);
+        assert(x.data() == first && w.empty() && w.capacity() == 5);
+        assert(SelfCount::Count() == 10);
+        swap(x, w);
+        assert(w.data() == first && x.capacity() == 5);
+    }
+    assert(SelfCount::Count() == 0);
+    assert(SelfCount::OwnerCount() == 0);
+    {
+        // Assignment and comparison
+        fixed_vector<std::string> a(5, {"one", "two", "three"});
+        fixed_vector<std::string> b(3);
+        b = a;
+        assert(a == b && b.capacity() == 3);
+        b.pop_back();
+        assert(b < a && b != a);
+        b.assign(3, "x");
+        assert(b.size() == 3 && b[2] == "x");
+        try {
+            b.at(3);
+            assert(false);
+        }
+        catch (std::out_of_range&) {}
+    }
+    {
+        // append_range(), resize_default_init(), generate_back()
+        fixed_vector<int> v(100);
+        v.append_range(std::list<int> {1, 2, 3});
+        int k = 4;
+        v.generate_back(7, [&k] { return k++; });
+        assert(v.size() == 10 && v[9] == 10);
+        v.resize_default_init(100);
+        assert(v.size() == 100 && v[9] == 10);
+    }
+    {
+        // std::hash
+        std::hash<fixed_vector<int>> hasher;
+        fixed_vector<int> a(20, {1, 2, 3}), b(10, {1, 2, 3}), c(20, {1, 2, 4});
+        assert(hasher(a) == hasher(b) && hasher(a) != hasher(c));
+    }
+    std::cout << "test-fv finished normally." << std::endl;
+}
@@ -0,0 +1,164 @@
+// Test driver for hashed_static_vector
+
+#define FRYSTL_DEBUG
+#include "hashed_static_vector.hpp"
+#include "Relocatable.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <list>
+
+using namespace frystl;
+
+// Return the hash that a hashed_static_vector built from scratch
+// with v's elements would have.
+template <class T, unsigned C, class Hash>
+uint64_t FreshHash(const hashed_static_vector<T, C, Hash> &v)
+{
+    return hashed_static_vector<T, C, Hash>(v.begin(), v.end()).hash();
+}
+
+struct UnrelocatableHash {
+    size_t operator()(const Unrelocatable &u) const { return std::hash<int>()(u()); }
+};
+using HashedUnrelocatables = hashed_static_vector<Unrelocatable, 20, UnrelocatableHash>;
+
+// FreshHash() for elements that may be moved from, and so not copyable
+uint64_t FreshHash(const HashedUnrelocatables &v)
+{
+    HashedUnrelocatables fresh;
+    for (const Unrelocatable &u : v)
+        fresh.push_back(Unrelocatable(u()));
+    return fresh.hash();
+}
+
+int main() {
+    {
+        // Constructors
+        hashed_static_vector<uint8_t, 52> empty;
+        assert(empty.empty() && empty.hash() == 0 && empty.capacity() == 52);
+        hashed_static_vector<uint8_t, 52> a {1, 2, 3}, b(3, 7);
+        std::vector<uint8_t> v {1, 2, 3};
+        hashed_static_vector<uint8_t, 52> c(v.begin(), v.end());
+        assert(a.size() == 3 && a[2] == 3 && a.hash() == c.hash() && a == c);
+        assert(b.size() == 3 && b.back() == 7 && a.hash() != b.hash() && a != b);
+        hashed_static_vector<uint8_t, 52> d(static_vector<uint8_t, 52> {3, 2, 1});
+        assert(d.hash() != a.hash() && d.vector().front() == 3);
+        d = static_vector<uint8_t, 52> {1, 2, 3};
+        assert(d == a);
+        d = {4, 5};
+        assert(d.size() == 2 && d.hash() == FreshHash(d));
+    }
+    {
+        // push_back() and pop_back() update the hash to match.
+        hashed_static_vector<uint8_t, 52> pile;
+        std::vector<uint64_t> hashes;
+        for (uint8_t card = 0; card < 52; ++card) {
+            hashes.push_back(pile.hash());
+            pile.push_back(card);
+            assert(pile.hash() == FreshHash(pile));
+        }
+        for (unsigned i = 52; i-- > 0; ) {
+            pile.pop_back();
+            assert(pile.hash() == hashes[i]);
+        }
+        assert(pile.hash() == 0);
+        assert(pile.emplace_back(9) == 9 && pile.hash() == FreshHash(pile));
+    }
+    {
+        // Middle insertions and erasures, and replace()
+        hashed_static_vector<int, 40> v;
+        for (int i = 0; i < 20; ++i)
+            v.push_back(i);
+        auto it = v.insert(v.begin() + 5, -1);
+        assert(*it == -1 && v.size() == 21 && v.hash() == FreshHash(v));
+        it = v.insert(v.begin(), 3u, -2);
+        assert(it == v.begin() && v[2] == -2 && v.hash() == FreshHash(v));
+        std::vector<int> more {100, 101, 102};
+        v.insert(v.end() - 1, more.begin(), more.end());
+        assert(v[v.size() - 2] == 102 && v.hash() == FreshHash(v));
+        v.insert(v.begin() + 1, {7, 8});
+        assert(v[2] == 8 && v.hash() == FreshHash(v));
+        it = v.emplace(v.begin() + 4, 55);
+        assert(*it == 55 && v.hash() == FreshHash(v));
+        it = v.erase(v.begin() + 3);
+        assert(v.hash() == FreshHash(v));
+        it = v.erase(v.begin() + 2, v.begin() + 10);
+        assert(it == v.begin() + 2 && v.hash() == FreshHash(v));
+        v.erase(v.begin() + 10, v.end());
+        assert(v.size() == 10 && v.hash() == FreshHash(v));
+        uint64_t h = v.hash();
+        int old = v[4];
+        v.replace(v.begin() + 4, 1000);
+        assert(v[4] == 1000 && v.hash() != h && v.hash() == FreshHash(v));
+        v.replace(v.begin() + 4, old);
+        assert(v.hash() == h);
+        v.clear();
+        assert(v.empty() && v.hash() == 0);
+    }
+    {
+        // The same elements in a different order hash differently.
+        hashed_static_vector<uint8_t, 10> a {1, 2}, b {2, 1};
+        assert(a.hash() != b.hash() && a != b && a < b);
+        swap(a, b);
+        assert(a[0] == 2 && a[1] == 1 && a.hash() == FreshHash(a));
+        std::unordered_set<hashed_static_vector<uint8_t, 10>> set {a, b};
+        assert(set.size() == 2 && set.count(hashed_static_vector<uint8_t, 10> {1, 2}));
+
+        // Elements with non-trivial hashes
+        hashed_static_vector<std::string, 4> s {"ab", "c"};
+        s.push_back("d");
+        s.erase(s.begin());
+        assert(s.hash() == FreshHash(s) && s.front() == "c");
+        try {
+            s.at(4);
+            assert(false);
+        }
+        catch (std::out_of_range&) {}
+    }
+    {
+        // After a throwing copy, the hash still matches the elements.
+        HashedUnrelocatables v;
+        for (int i = 0; i < 8; ++i)
+            v.push_back(Unrelocatable(i));
+        std::vector<Unrelocatable> vec;
+        std::list<Unrelocatable> list;
+        for (int i : {10, 11, -1, 12}) {
+            vec.push_back(Unrelocatable(i));
+            list.push_back(Unrelocatable(i));
+        }
+        try {
+            v.insert(v.begin() + 3, vec.begin(), vec.end());
+            assert(false);
+        }
+        catch (std::runtime_error &) {}
+        assert(v.hash() == FreshHash(v));
+        try {
+            v.insert(v.begin() + 2, list.begin(), list.end());
+            assert(false);
+        }
+        catch (std::runtime_error &) {}
+        assert(v.hash() == FreshHash(v));
+        try {
+            v.insert(v.begin() + 1, 2u, vec[2]);
+            assert(false);
+        }
+        catch (std::runtime_error &) {}
+        assert(v.hash() == FreshHash(v));
+        try {
+            v.emplace(v.begin() + 4, vec[2]);
+            assert(false);
+        }
+        catch (std::runtime_error &) {}
+        assert(v.hash() == FreshHash(v));
+        try {
+            v.replace(v.begin() + 1, vec[2]);
+            assert(false);
+        }
+        catch (std::runtime_error &) {}
+        assert(v.hash() == FreshHash(v));
+    }
+    std::cout << "test-hsv finished normally." << std::endl;
+}
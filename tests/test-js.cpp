@@ -0,0 +1,171 @@
+// Test driver for journaled_sequence
+
+#define FRYSTL_DEBUG
+#include "journaled_sequence.hpp"
+#include <cassert>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+
+using namespace frystl;
+
+template <class J, class Model>
+bool Same(const J &j, const Model &model)
+{
+    return j.size() == model.size() && std::equal(j.begin(), j.end(), model.begin());
+}
+
+// Make a random change to j and the same change to model.
+template <class J, class Model>
+void RandomChange(J &j, Model &model, std::mt19937 &gen, bool front)
+{
+    int value = int(gen() % 1000);
+    unsigned n = j.size();
+    unsigned i = n ? gen() % n : 0;
+    switch (gen() % (front ? 8 : 6)) {
+    case 0:
+        if (n < j.capacity()) {
+            j.push_back(value);
+            model.push_back(value);
+        }
+        break;
+    case 1:
+        if (n) {
+            j.pop_back();
+            model.pop_back();
+        }
+        break;
+    case 2:
+        if (n) {
+            j.replace(j.begin() + i, value);
+            model[i] = value;
+        }
+        break;
+    case 3:
+        if (n + 3 <= j.capacity()) {
+            j.insert(j.begin() + i, 3, value);
+            model.insert(model.begin() + i, 3, value);
+        }
+        break;
+    case 4:
+        if (n) {
+            unsigned k = std::min(n - i, unsigned(gen() % 4));
+            j.erase(j.begin() + i, j.begin() + i + k);
+            model.erase(model.begin() + i, model.begin() + i + k);
+        }
+        break;
+    case 5:
+        if (n < j.capacity()) {
+            j.emplace(j.begin() + i, value);
+            model.insert(model.begin() + i, value);
+        }
+        break;
+    case 6:
+        if constexpr (!std::is_same<Model, std::vector<int>>::value) {
+            if (n < j.capacity()) {
+                j.push_front(value);
+                model.push_front(value);
+            }
+        }
+        break;
+    default:
+        if constexpr (!std::is_same<Model, std::vector<int>>::value) {
+            if (n) {
+                j.pop_front();
+                model.pop_front();
+            }
+        }
+        break;
+    }
+}
+
+// Search a random tree of changes to depth, rolling back each one.
+template <class J, class Model>
+void Search(J &j, Model &model, std::mt19937 &gen, bool front, int depth)
+{
+    if (depth == 0)
+        return;
+    for (int child = 0; child < 3; ++child) {
+        auto token = j.checkpoint();
+        Model saved = model;
+        for (int k = gen() % 4; k; --k)
+            RandomChange(j, model, gen, front);
+        assert(Same(j, model));
+        Search(j, model, gen, front, depth - 1);
+        j.rollback(token);
+        model = saved;
+        assert(Same(j, model) && j.journal_size() == token);
+    }
+}
+
+int main() {
+    {
+        // Basic operations
+        journaled_static_vector<int, 10> v {1, 2, 3};
+        assert(!v.journaling() && v.size() == 3 && v.journal_capacity() == 10);
+        v.push_back(4);
+        assert(v.journal_size() == 0 && v.back() == 4);
+        auto t0 = v.checkpoint();
+        assert(t0 == 0 && v.journaling());
+        v.pop_back();
+        v.replace(v.begin(), 10);
+        auto t1 = v.checkpoint();
+        v.erase(v.begin() + 1);
+        v.insert(v.begin(), {7, 8});
+        assert(v.size() == 4 && v[0] == 7 && v[2] == 10 && v[3] == 3);
+        v.rollback(t1);
+        assert(v.size() == 3 && v[0] == 10 && v[1] == 2 && v[2] == 3);
+        v.clear();
+        assert(v.empty());
+        v.rollback(t1);
+        assert(v.size() == 3 && v[0] == 10);
+        v.rollback(t0);
+        assert(v.size() == 4 && v[0] == 1 && v[3] == 4 && v.journal_size() == 0);
+        v.push_back(5);
+        v.commit();
+        assert(!v.journaling() && v.journal_size() == 0 && v.size() == 5);
+        static_vector<int, 10> sv {4, 5, 6};
+        v = sv;
+        assert(v.sequence() == sv);
+        journaled_static_vector<int, 10> w(sv);
+        assert(v == w && !(v < w));
+        w.push_back(7);
+        assert(v != w && v < w);
+        swap(v, w);
+        assert(v.size() == 4 && w.size() == 3);
+    }
+    {
+        // Deques, strings and the front operations
+        journaled_static_deque<std::string, 8, 20> d {"b", "c"};
+        auto t = d.checkpoint();
+        d.push_front("a");
+        d.emplace_back(2, 'd');
+        d.pop_front();
+        d.pop_front();
+        d.replace(d.begin(), "C");
+        assert(d.size() == 2 && d.front() == "C" && d.back() == "dd");
+        d.rollback(t);
+        assert(d.size() == 2 && d.front() == "b" && d.back() == "c");
+        d = {"x", "y", "z"};
+        assert(d.size() == 3 && d[1] == "y");
+        d.rollback(t);
+        assert(d.size() == 2 && d.front() == "b" && d.back() == "c");
+    }
+    {
+        // Random searches
+        std::mt19937 gen(1);
+        journaled_static_vector<int, 40, 200> v;
+        std::vector<int> vm;
+        for (int i = 0; i < 10; ++i) {
+            v.push_back(i);
+            vm.push_back(i);
+        }
+        Search(v, vm, gen, false, 5);
+        journaled_static_deque<int, 40, 200> d;
+        std::deque<int> dm;
+        Search(d, dm, gen, true, 5);
+    }
+    std::cout << "test-js finished normally." << std::endl;
+}
@@ -2,13 +2,41 @@
 
 #define FRYSTL_DEBUG
 #include <vector>
+#include <cstdlib>   // malloc, free
+#include <new>       // bad_alloc
+#include <memory>
 #include <iostream>  // cerr
 #include <list>
+#include <string>
+#include <algorithm> // sort, copy_if
+#include <functional> // less, greater
 #include "mf_vector.hpp"
 #include "SelfCount.hpp"
+#include "Relocatable.hpp"
 
 using namespace frystl;
 
+// If newArrayCountdown is set to n > 0, the nth call to operator
+// new[] after that throws bad_alloc.  mf_vector allocates its blocks
+// with new[].
+static int newArrayCountdown = 0;
+void* operator new[](size_t size)
+{
+    if (newArrayCountdown > 0 && --newArrayCountdown == 0)
+        throw std::bad_alloc();
+    if (void* p = std::malloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete[](void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
 // Test fill insert.
 // Assumes vec is a vector of type SelfCount
 // such that vec[i]() == i for all vec[i].
@@ -46,6 +74,49 @@ static bool AscendingInts(mf_vector<SelfCount,B,N> vec)
     return true;
 }
 
+// Make random inserts and erases in c, and the same changes to a
+// vector of ints, checking that they agree.  make(v) returns an
+// element holding v; value(e) returns the int held by e.
+template <class C, class Make, class Value>
+static void TestShifting(C &c, unsigned maxSize, Make make, Value value)
+{
+    std::vector<int> model;
+    uint32_t r = 1;
+    for (int i = 0; i < 3000; ++i) {
+        r = r * 1103515245 + 12345;
+        unsigned pos = (r >> 4) % (model.size() + 1);
+        int v = int(r >> 20);
+        switch ((r >> 16) % 4) {
+        case 0:
+            if (model.size() < maxSize) {
+                c.insert(c.begin() + pos, make(v));
+                model.insert(model.begin() + pos, v);
+            }
+            break;
+        case 1:
+            if (model.size() < maxSize) {
+                c.emplace(c.begin() + pos, make(v));
+                model.insert(model.begin() + pos, v);
+            }
+            break;
+        case 2:
+            if (pos < model.size()) {
+                c.erase(c.begin() + pos);
+                model.erase(model.begin() + pos);
+            }
+            break;
+        default: {
+            unsigned n = std::min<unsigned>((r >> 24) % 4, model.size() - pos);
+            c.erase(c.begin() + pos, c.begin() + pos + n);
+            model.erase(model.begin() + pos, model.begin() + pos + n);
+            break;
+        }
+        }
+        assert(c.size() == model.size());
+        for (unsigned j = 0; j < model.size(); ++j)
+            assert(value(c[j]) == model[j]);
+    }
+}
 int main() {
 
     // Constructors.
@@ -542,6 +613,273 @@ int main() {
         assert(v0 < v1);
         assert(v0 != v1);
     }
+    {
+        // sort(), stable_sort()
+        for (unsigned n : {0u, 1u, 5u, 16u, 17u, 1000u, 20011u}) {
+            for (unsigned nThreads : {1u, 3u, 8u}) {
+                mf_vector<unsigned, 16> mfv;
+                std::vector<unsigned> sv;
+                uint32_t r = 12345 + n;
+                for (unsigned i = 0; i < n; ++i) {
+                    r = r * 1103515245 + 12345;
+                    mfv.push_back(r >> 16);
+                    sv.push_back(r >> 16);
+                }
+                std::sort(sv.begin(), sv.end());
+                sort(mfv, std::less<unsigned>(), nThreads);
+                assert(mfv.size() == n);
+                assert(std::equal(sv.begin(), sv.end(), mfv.begin()));
+
+                std::sort(sv.begin(), sv.end(), std::greater<unsigned>());
+                mfv.sort(std::greater<unsigned>(), nThreads);
+                assert(std::equal(sv.begin(), sv.end(), mfv.begin()));
+            }
+        }
+        // stability
+        {
+            using Pair = std::pair<unsigned, unsigned>;    // key, original index
+            mf_vector<Pair, 8> mfv;
+            for (unsigned i = 0; i < 3000; ++i)
+                mfv.emplace_back((i * 7919) % 3000 / 10, i);
+            auto byKey = [](const Pair& a, const Pair& b) {return a.first < b.first;};
+            stable_sort(mfv, byKey, 4);
+            assert(mfv.size() == 3000);
+            for (unsigned i = 1; i < mfv.size(); ++i) {
+                assert(mfv[i-1].first <= mfv[i].first);
+                if (mfv[i-1].first == mfv[i].first)
+                    assert(mfv[i-1].second < mfv[i].second);
+            }
+        }
+        // no elements created or lost.  SelfCount's counters are not
+        // thread-safe, so use one thread.
+        {
+            assert(SelfCount::OwnerCount() == 0);
+            int count0 = SelfCount::Count();
+            mf_vector<SelfCount, 8> mfv;
+            for (int i = 0; i < 3000; ++i)
+                mfv.emplace_back((i * 7919) % 3000);
+            mfv.sort([](const SelfCount& a, const SelfCount& b) {return a() < b();}, 1);
+            assert(SelfCount::Count() == count0 + 3000);
+            assert(SelfCount::OwnerCount() == 3000);
+            assert(AscendingInts(mfv));
+        }
+        assert(SelfCount::OwnerCount() == 0);
+    }
+    {
+        // append_if(), copy_if()
+        for (unsigned n : {0u, 1u, 16u, 100u, 1000u, 5003u}) {
+            for (unsigned nThreads : {1u, 4u}) {
+                mf_vector<int, 16> src;
+                for (unsigned i = 0; i < n; ++i)
+                    src.push_back(i);
+                auto keep = [](int i) {return i % 3 == 0 || i % 7 == 0;};
+                mf_vector<int, 8> dst {-1, -2};
+                copy_if(src, dst, keep, nThreads);
+                std::vector<int> expected {-1, -2};
+                std::copy_if(src.begin(), src.end(), std::back_inserter(expected), keep);
+                assert(dst.size() == expected.size());
+                assert(std::equal(expected.begin(), expected.end(), dst.begin()));
+
+                mf_vector<int, 16> all;
+                all.append_if(src, [](int) {return true;}, nThreads);
+                assert(all == src);
+                all.append_if(src, [](int) {return false;}, nThreads);
+                assert(all == src);
+            }
+        }
+        // exclusive_scan()
+        for (unsigned n : {0u, 1u, 16u, 17u, 1000u}) {
+            for (unsigned nThreads : {1u, 3u}) {
+                mf_vector<unsigned, 16> v;
+                for (unsigned i = 0; i < n; ++i)
+                    v.push_back(i);
+                unsigned total = exclusive_scan(v, 5u, std::plus<unsigned>(), nThreads);
+                assert(total == 5 + n*(n-1)/2);
+                for (unsigned i = 0; i < n; ++i)
+                    assert(v[i] == 5 + i*(i-1)/2);
+            }
+        }
+        {
+            // non-commutative op
+            mf_vector<std::string, 4> v;
+            for (char c = 'a'; c <= 'z'; ++c)
+                v.push_back(std::string(1, c));
+            std::string all = v.exclusive_scan(std::string(">"), std::plus<std::string>(), 3);
+            assert(all == ">abcdefghijklmnopqrstuvwxyz");
+            assert(v[0] == ">");
+            assert(v[1] == ">a");
+            assert(v[25] == ">abcdefghijklmnopqrstuvwxy");
+        }
+    }
+    {
+        // radix_sort()
+        struct Rec {
+            uint64_t key;
+            unsigned index;
+        };
+        for (unsigned n : {0u, 1u, 2u, 16u, 17u, 1000u, 20000u}) {
+            for (unsigned nThreads : {1u, 3u}) {
+                mf_vector<Rec, 16> mfv;
+                std::vector<Rec> sv;
+                uint64_t r = n;
+                for (unsigned i = 0; i < n; ++i) {
+                    r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+                    // a narrow middle digit range makes equal keys common
+                    // and exercises skipped passes
+                    Rec rec {(r >> 40) & 0xff00ffull, i};
+                    mfv.push_back(rec);
+                    sv.push_back(rec);
+                }
+                auto key = [](const Rec& rec) {return rec.key;};
+                std::stable_sort(sv.begin(), sv.end(),
+                    [](const Rec& a, const Rec& b) {return a.key < b.key;});
+                radix_sort(mfv, key, nThreads);
+                assert(mfv.size() == n);
+                for (unsigned i = 0; i < n; ++i) {
+                    assert(mfv[i].key == sv[i].key);
+                    assert(mfv[i].index == sv[i].index);
+                }
+                // 32-bit key, reversed order
+                mfv.radix_sort([](const Rec& rec) {return ~uint32_t(rec.index);}, nThreads);
+                for (unsigned i = 0; i < n; ++i)
+                    assert(mfv[i].index == n - 1 - i);
+            }
+        }
+        {
+            // An allocation fails in the second pass.  The vector keeps
+            // the result of the first pass and its own blocks.
+            mf_vector<Rec, 4> mfv;
+            for (unsigned i = 0; i < 40; ++i)
+                mfv.push_back(Rec {(i * 37 % 40) * 0x101ull, i});
+            newArrayCountdown = 10 + 3;     // 10 new blocks per pass
+            try {
+                mfv.radix_sort([](const Rec& rec) {return rec.key;}, 1);
+                assert(false);
+            }
+            catch (std::bad_alloc&) {}
+            assert(newArrayCountdown == 0 && mfv.size() == 40);
+            std::vector<unsigned> seen(40, 0);
+            for (unsigned i = 0; i < 40; ++i) {
+                assert(i == 0 || (mfv[i-1].key & 0xff) <= (mfv[i].key & 0xff));
+                ++seen[mfv[i].index];
+            }
+            assert(std::count(seen.begin(), seen.end(), 1u) == 40);
+        }
+    }
+    {
+        // insert_sorted_batch()
+        assert(SelfCount::OwnerCount() == 0);
+        mf_vector<SelfCount, 8> v;
+        for (int i = 0; i < 20; ++i)
+            v.emplace_back(2*i);
+        std::vector<SelfCount> batch;
+        for (int i : {-3, 0, 7, 9, 9, 38, 39, 41, 50})
+            batch.emplace_back(i);
+        auto less = [](const SelfCount& a, const SelfCount& b) {return int(a()) < int(b());};
+        v.insert_sorted_batch(batch.begin(), batch.end(), less);
+        assert(v.size() == 29);
+        assert(SelfCount::OwnerCount() == 29 + 9);
+        assert(std::is_sorted(v.begin(), v.end(), less));
+        assert(int(v[0]()) == -3);
+        assert(v[1]() == 0 && v[2]() == 0);
+        assert(v[28]() == 50);
+        assert(v[27]() == 41);
+        v.insert_sorted_batch(batch.end(), batch.end(), less);
+        assert(v.size() == 29);
+        mf_vector<SelfCount, 8> e;
+        e.insert_sorted_batch(batch.begin(), batch.end(), less);
+        assert(e.size() == 9);
+        assert(e[4]() == 9);
+        assert(SelfCount::OwnerCount() == 29 + 18);
+    }{
+        // insert_many()
+        assert(SelfCount::OwnerCount() == 0);
+        mf_vector<SelfCount, 8> v;
+        for (int i = 0; i < 10; ++i)
+            v.emplace_back(i);
+        std::list<unsigned> positions {0, 3, 3, 9, 10, 10};
+        std::list<SelfCount> values;
+        for (int i : {100, 103, 104, 109, 110, 111})
+            values.emplace_back(i);
+        v.insert_many(positions.begin(), positions.end(), values.begin());
+        assert(v.size() == 16);
+        assert(SelfCount::OwnerCount() == 16 + 6);
+        std::vector<int> expected {100, 0, 1, 2, 103, 104, 3, 4, 5, 6, 7, 8, 109, 9, 110, 111};
+        for (unsigned i = 0; i < 16; ++i)
+            assert(v[i]() == expected[i]);
+    }
+    {
+        // erase_unordered(), erase_if() and erase_indices()
+        unsigned count0 = SelfCount::Count();
+        mf_vector<SelfCount, 4> v;
+        for (int i = 0; i < 20; ++i)
+            v.emplace_back(i);
+        auto it = v.erase_unordered(v.begin() + 3);
+        assert(v.size() == 19 && (*it)() == 19 && v[3]() == 19);
+        it = v.erase_unordered(v.end() - 1);
+        assert(it == v.end() && v.size() == 18 && v.back()() == 17);
+        assert(SelfCount::OwnerCount() == 18);
+        auto nErased = erase_if(v, [](const SelfCount& s) { return s() % 3 == 0; });
+        assert(nErased == 5 && v.size() == 13);
+        const int remaining[] = {1, 2, 19, 4, 5, 7, 8, 10, 11, 13, 14, 16, 17};
+        for (unsigned i = 0; i < 13; ++i)
+            assert(v[i]() == remaining[i]);
+        assert(SelfCount::OwnerCount() == 13);
+        std::vector<unsigned> indices {0, 2, 2, 5, 12};
+        nErased = erase_indices(v, indices);
+        assert(nErased == 4 && v.size() == 9);
+        const int kept[] = {2, 4, 5, 8, 10, 11, 13, 14, 16};
+        for (unsigned i = 0; i < 9; ++i)
+            assert(v[i]() == kept[i]);
+        assert(erase_indices(v, std::vector<unsigned>()) == 0 && v.size() == 9);
+        assert(SelfCount::OwnerCount() == 9);
+        v.clear();
+        assert(SelfCount::Count() == count0);
+    }
+    {
+        // std::hash hashes block by block.
+        using Vec = mf_vector<int, 4>;
+        std::hash<Vec> hasher;
+        Vec a, b;
+        for (int i = 0; i < 10; ++i) {
+            a.push_back(i);
+            b.push_back(i);
+        }
+        assert(hasher(a) == hasher(b));
+        b[5] = 50;
+        assert(hasher(a) != hasher(b));
+        b[5] = 5;
+        b.push_back(10);
+        assert(hasher(a) != hasher(b));
+        using Strings = mf_vector<std::string, 2>;
+        Strings s1, s2;
+        for (const char* s : {"ab", "c", "d"}) {
+            s1.push_back(s);
+            s2.push_back(s);
+        }
+        assert(std::hash<Strings>()(s1) == std::hash<Strings>()(s2));
+    }
+    {
+        // Comparisons across block sizes
+        mf_vector<uint16_t, 16> a;
+        mf_vector<uint16_t, 64> b;
+        for (uint16_t i = 0; i < 300; ++i) {
+            a.push_back(i);
+            b.push_back(i);
+        }
+        assert(a == b && !(a < b) && !(b < a) && a <= b && a >= b);
+        b[200] = 0;
+        assert(a != b && b < a && !(a < b));
+        b[200] = 200;
+        b.push_back(0);
+        assert(a != b && a < b);
+        mf_vector<uint8_t, 8> c(5, 1), d(5, 1);
+        d[4] = 200;
+        assert(c < d && c != d);
+#ifdef FRYSTL_HAS_THREE_WAY
+        assert((a <=> b) < 0 && (d <=> c) > 0 && (c <=> c) == 0);
+#endif
+    }
     {
         /*
         // Grow it big (needs 1.5GB)
@@ -555,5 +893,93 @@ int main() {
             assert(big[j] == j);
         */
     }
+    {
+        // Shifting trivially relocatable elements with memmove() and
+        // others one at a time
+        static_assert(is_trivially_relocatable<std::unique_ptr<int>>::value, "unique_ptr");
+        static_assert(!is_trivially_relocatable<SelfCount>::value, "SelfCount");
+        mf_vector<std::unique_ptr<int>, 8> u;
+        TestShifting(u, 100,
+            [](int v) { return std::make_unique<int>(v); },
+            [](const std::unique_ptr<int> &p) { return *p; });
+        {
+            mf_vector<SelfCount, 8> s;
+            TestShifting(s, 100,
+                [](int v) { return SelfCount(v); },
+                [](const SelfCount &e) { return int(e()); });
+            assert(SelfCount::Count() == int(s.size()));
+            assert(SelfCount::OwnerCount() == int(s.size()));
+        }
+        assert(SelfCount::Count() == 0);
+    }
+    {
+        // An insert whose copy throws leaves the vector as it was.
+        {
+            mf_vector<Relocatable, 4> v;
+            for (int i = 0; i < 8; ++i)
+                v.emplace_back(i);
+            const Relocatable src[] = {10, 11, -1, 12};
+            auto same = [&v]() {
+                for (int i = 0; i < 8; ++i)
+                    if (v[i]() != i)
+                        return false;
+                return v.size() == 8 && Relocatable::Count() == 12;
+            };
+            try {
+                v.insert(v.begin() + 3, src, src + 4);
+                assert(false);
+            }
+            catch (std::runtime_error&) {}
+            assert(same());
+            try {
+                v.insert(v.begin() + 5, 3, src[2]);
+                assert(false);
+            }
+            catch (std::runtime_error&) {}
+            assert(same());
+            try {
+                v.emplace(v.begin() + 1, src[2]);
+                assert(false);
+            }
+            catch (std::runtime_error&) {}
+            assert(same());
+            v.insert(v.begin() + 2, src, src + 2);
+            assert(v.size() == 10 && v[2]() == 10 && v[4]() == 2);
+        }
+        assert(Relocatable::Count() == 0);
+        {
+            mf_vector<Unrelocatable, 4> v;
+            for (int i = 0; i < 8; ++i)
+                v.emplace_back(i);
+            const Unrelocatable src[] = {10, 11, -1, 12};
+            auto same = [&v]() {
+                for (int i = 0; i < 8; ++i)
+                    if (v[i]() != i)
+                        return false;
+                return v.size() == 8 && Relocatable::Count() == 12;
+            };
+            try {
+                v.insert(v.begin() + 3, src, src + 4);
+                assert(false);
+            }
+            catch (std::runtime_error&) {}
+            assert(same());
+            try {
+                v.insert(v.begin() + 5, 3, src[2]);
+                assert(false);
+            }
+            catch (std::runtime_error&) {}
+            assert(same());
+            try {
+                v.emplace(v.begin() + 1, src[2]);
+                assert(false);
+            }
+            catch (std::runtime_error&) {}
+            assert(same());
+            v.insert(v.begin() + 2, src, src + 2);
+            assert(v.size() == 10 && v[2]() == 10 && v[4]() == 2);
+        }
+        assert(Relocatable::Count() == 0);
+    }
     std::cerr << "test-mfv completed normally." << std::endl;
 }
\ No newline at end of file
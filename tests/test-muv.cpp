@@ -0,0 +1,140 @@
+// Test driver for static_multi_vector
+
+#define FRYSTL_DEBUG
+#include "static_multi_vector.hpp"
+#include <cassert>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+#include <random>
+#include <unordered_set>
+
+using namespace frystl;
+
+template <class M, class Model>
+bool Same(const M &m, const Model &model)
+{
+    size_t total = 0;
+    for (unsigned k = 0; k < m.sequence_count(); ++k) {
+        auto s = m[k];
+        if (s.size() != model[k].size() || !std::equal(s.begin(), s.end(), model[k].begin()))
+            return false;
+        total += s.size();
+    }
+    return m.size() == total;
+}
+
+int main() {
+    {
+        // A tableau of 7 piles of cards
+        using Tableau = static_multi_vector<uint8_t, 7, 52>;
+        static_assert(sizeof(Tableau) == 52 + 7, "52 cards and 7 ends");
+        static_assert(std::is_trivially_copyable<Tableau>::value, "trivially copyable");
+        Tableau t;
+        assert(t.empty() && t.size() == 0 && t.available() == 52 && t.sequence_count() == 7);
+        uint8_t card = 0;
+        for (unsigned k = 0; k < 7; ++k)
+            for (unsigned i = 0; i <= k; ++i)
+                t[k].push_back(card++);
+        assert(t.size() == 28 && t[6].size() == 7 && t[0].front() == 0 && t[6].back() == 27);
+        assert(t[3][0] == 6 && t[3].at(3) == 9 && t[3].capacity() == 4 + 24);
+        try {
+            t[3].at(4);
+            assert(false);
+        }
+        catch (std::out_of_range &) {}
+        // Move a run of 3 cards from pile 5 to pile 2 and back.
+        Tableau saved = t;
+        t.move_back(5, 3, 2);
+        assert(t[5].size() == 3 && t[2].size() == 6);
+        assert(t[2][3] == 18 && t[2][5] == 20 && t[5].back() == 17 && t[6].front() == 21);
+        assert(t != saved);
+        t.move_back(2, 3, 5);
+        assert(t == saved);
+        t.move_back(0, 1, 6);
+        assert(t[0].empty() && t[6].back() == 0 && t[1].front() == 1);
+        const Tableau &ct = t;
+        assert(ct[6].size() == 8 && *ct[6].rbegin() == 0);
+        std::unordered_set<Tableau> set {t, saved};
+        assert(set.size() == 2 && set.count(saved));
+        t[1].clear();
+        assert(t[1].empty() && t.size() == 26 && t[2].front() == 3);
+        t[6][0] = 99;
+        assert(t.data()[t.size() - 8] == 99);
+        // Insert from a single-pass range.
+        std::istringstream in("40 41 42");
+        t[4].insert(t[4].begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+        assert(t[4].size() == 8 && t[4][0] == 10 && t[4][1] == 40 && t[4][3] == 42 && t[4][4] == 11);
+        t.clear();
+        assert(t.empty() && t[6].empty());
+    }
+    {
+        // Random operations against a model
+        static_multi_vector<int, 5, 40> m;
+        std::vector<std::vector<int>> model(5);
+        std::mt19937 gen(7);
+        for (int i = 0; i < 20000; ++i) {
+            unsigned k = gen() % 5;
+            auto s = m[k];
+            auto &v = model[k];
+            int value = int(gen() % 100);
+            unsigned pos = v.empty() ? 0 : gen() % (v.size() + 1);
+            switch (gen() % 8) {
+            case 0:
+            case 1:
+                if (m.available()) {
+                    s.push_back(value);
+                    v.push_back(value);
+                }
+                break;
+            case 2:
+                if (!v.empty()) {
+                    s.pop_back();
+                    v.pop_back();
+                }
+                break;
+            case 3:
+                if (m.available() >= 2) {
+                    s.insert(s.begin() + pos, 2, value);
+                    v.insert(v.begin() + pos, 2, value);
+                }
+                break;
+            case 4:
+                if (pos < v.size()) {
+                    unsigned n = std::min<unsigned>(gen() % 3, v.size() - pos);
+                    auto it = s.erase(s.begin() + pos, s.begin() + pos + n);
+                    assert(it == s.begin() + pos);
+                    v.erase(v.begin() + pos, v.begin() + pos + n);
+                }
+                break;
+            case 5: {
+                unsigned to = gen() % 5;
+                unsigned n = v.empty() ? 0 : gen() % (v.size() + 1);
+                m.move_back(k, n, to);
+                std::vector<int> run(v.end() - n, v.end());
+                v.erase(v.end() - n, v.end());
+                model[to].insert(model[to].end(), run.begin(), run.end());
+                break;
+            }
+            case 6:
+                if (m.available() >= v.size()) {
+                    // Insert a copy of the sequence into itself.
+                    std::vector<int> copy(v);
+                    s.insert(s.begin() + pos, s.begin(), s.end());
+                    v.insert(v.begin() + pos, copy.begin(), copy.end());
+                }
+                break;
+            default: {
+                unsigned n = gen() % 6;
+                if (n <= v.size() || n - v.size() <= m.available()) {
+                    s.resize(n, value);
+                    v.resize(n, value);
+                }
+            }
+            }
+            assert(Same(m, model));
+        }
+    }
+    std::cout << "test-muv finished normally." << std::endl;
+}
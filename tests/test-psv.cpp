@@ -0,0 +1,177 @@
+// Test driver for packed_static_vector
+
+#define FRYSTL_DEBUG
+#include "packed_static_vector.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+
+using namespace frystl;
+
+// Check that v holds the same elements as model.
+template <unsigned B, unsigned C>
+bool Same(const packed_static_vector<B, C> &v, const std::vector<unsigned> &model)
+{
+    if (v.size() != model.size())
+        return false;
+    for (unsigned i = 0; i < model.size(); ++i)
+        if (v[i] != model[i])
+            return false;
+    return std::equal(v.begin(), v.end(), model.begin());
+}
+
+int main() {
+    {
+        // Size and layout
+        using Cards = packed_static_vector<6, 52>;
+        static_assert(sizeof(Cards) == 40, "52 six-bit values and a size fit in 40 bytes");
+        static_assert(sizeof(packed_static_vector<1, 58>) == 8, "");
+        static_assert(sizeof(packed_static_vector<1, 59>) == 16, "");
+        static_assert(std::is_same<Cards::value_type, uint8_t>::value, "");
+        static_assert(std::is_same<packed_static_vector<17, 3>::value_type, uint32_t>::value, "");
+        Cards deck;
+        assert(deck.empty() && deck.capacity() == 52 && Cards::max_value == 63);
+        for (unsigned c = 0; c < 52; ++c)
+            deck.push_back(c);
+        assert(deck.size() == 52 && deck.front() == 0 && deck.back() == 51);
+        for (unsigned c = 0; c < 52; ++c)
+            assert(deck[c] == c);
+        deck[10] = 63;
+        assert(deck[9] == 9 && deck[10] == 63 && deck[11] == 11);
+        deck.pop_back();
+        assert(deck.size() == 51 && deck.back() == 50);
+    }
+    {
+        // Constructors and assignment
+        packed_static_vector<5, 20> a {1, 2, 31}, b(4, 9), c;
+        std::vector<unsigned> v {3, 4, 5, 6};
+        packed_static_vector<5, 20> d(v.begin(), v.end());
+        assert(Same(a, {1, 2, 31}) && Same(b, {9, 9, 9, 9}) && c.empty() && Same(d, v));
+        c = a;
+        assert(c == a);
+        c = {7};
+        assert(Same(c, {7}));
+        c.assign(3, 1);
+        assert(Same(c, {1, 1, 1}));
+        c.assign(v.begin(), v.end());
+        assert(c == d);
+        try {
+            c.at(4);
+            assert(false);
+        }
+        catch (std::out_of_range &) {}
+        c.at(3) = 12;
+        assert(c.at(3) == 12);
+    }
+    {
+        // Modifiers, checked against a model, with straddling elements
+        packed_static_vector<13, 40> v;
+        std::vector<unsigned> m;
+        for (unsigned i = 0; i < 20; ++i) {
+            v.push_back(i * 397 % 8192);
+            m.push_back(i * 397 % 8192);
+        }
+        assert(Same(v, m));
+        auto it = v.insert(v.begin() + 3, 8191);
+        m.insert(m.begin() + 3, 8191);
+        assert(*it == 8191 && Same(v, m));
+        v.insert(v.begin(), 2, 5);
+        m.insert(m.begin(), 2, 5);
+        assert(Same(v, m));
+        std::vector<unsigned> more {100, 200, 300};
+        it = v.insert(v.end() - 1, more.begin(), more.end());
+        m.insert(m.end() - 1, more.begin(), more.end());
+        assert(*it == 100 && Same(v, m));
+        v.insert(v.begin() + 7, {1, 2});
+        m.insert(m.begin() + 7, {1, 2});
+        assert(Same(v, m));
+        it = v.erase(v.begin() + 4);
+        m.erase(m.begin() + 4);
+        assert(it == v.begin() + 4 && Same(v, m));
+        v.erase(v.begin() + 2, v.begin() + 12);
+        m.erase(m.begin() + 2, m.begin() + 12);
+        assert(Same(v, m));
+        v.resize(30, 77);
+        m.resize(30, 77);
+        assert(Same(v, m));
+        v.resize(5);
+        m.resize(5);
+        assert(Same(v, m));
+        assert(v.emplace_back(4000) == 4000);
+        // Erasing and popping leave no stray bits, so the vector equals
+        // one built afresh.
+        m.push_back(4000);
+        packed_static_vector<13, 40> fresh(m.begin(), m.end());
+        std::hash<packed_static_vector<13, 40>> hash;
+        assert(v == fresh && hash(v) == hash(fresh));
+        v.clear();
+        assert(v.empty() && v == (packed_static_vector<13, 40>()));
+    }
+    {
+        // Iterators and proxies
+        packed_static_vector<3, 30> v {5, 1, 4, 1, 7};
+        unsigned sum = 0;
+        for (unsigned x : v)
+            sum += x;
+        assert(sum == 18);
+        for (auto r : v)
+            r = 7 - r;
+        assert(Same(v, {2, 6, 3, 6, 0}));
+        swap(v[0], v[4]);
+        assert(v[0] == 0 && v[4] == 2);
+        v[1] = v[2];
+        assert(v[1] == 3);
+        const auto &cv = v;
+        packed_static_vector<3, 30>::const_iterator ci = v.begin();
+        assert(ci == cv.begin() && cv.end() - ci == 5 && ci[4] == 2);
+        assert(*std::max_element(cv.begin(), cv.end()) == 6);
+        assert(std::count(cv.begin(), cv.end(), 6) == 1);
+        assert(*cv.rbegin() == 2 && *(cv.rend() - 1) == 0);
+        auto it = v.end();
+        it -= 2;
+        assert(*it == 6 && it - v.begin() == 3 && v.begin() < it);
+    }
+    {
+        // Comparison and hashing
+        using V = packed_static_vector<4, 40>;
+        V a {1, 2, 3}, b {1, 2, 4}, c {1, 2}, d {1, 2, 3, 0};
+        assert(a == a && a != b && a < b && b > a && c < a && a < d && a <= d);
+        assert(!(d < a) && d >= a && !(a < a) && a <= a);
+        // Elements after the first word
+        V e(30, 15), f(30, 15);
+        assert(e == f && !(e < f));
+        f[25] = 14;
+        assert(f < e && e > f && e != f);
+        f[25] = 15;
+        f.push_back(0);
+        assert(e < f);
+        // Different capacities compare by content.
+        packed_static_vector<4, 8> g {1, 2, 3};
+        assert(!(g < a) && !(a < g) && g < b);
+#ifdef FRYSTL_HAS_THREE_WAY
+        assert((a <=> b) < 0 && (a <=> a) == 0);
+#endif
+        std::unordered_set<V> set {a, b, c, d};
+        assert(set.size() == 4 && set.count(V {1, 2}) && !set.count(V {2}));
+        std::hash<V> h;
+        assert(h(a) != h(d));
+        swap(a, b);
+        assert(a[2] == 4 && b[2] == 3);
+    }
+    {
+        // The widest elements
+        packed_static_vector<32, 5> v {0xffffffffu, 0, 0x12345678u};
+        assert(v[0] == 0xffffffffu && v[2] == 0x12345678u);
+        packed_static_vector<31, 5> w;
+        for (unsigned i = 0; i < 5; ++i)
+            w.push_back(0x7fffffffu - i);
+        for (unsigned i = 0; i < 5; ++i)
+            assert(w[i] == 0x7fffffffu - i);
+        w.pop_back();
+        w.pop_back();
+        assert(w.size() == 3 && w.back() == 0x7fffffffu - 2);
+    }
+    std::cout << "test-psv finished normally." << std::endl;
+}
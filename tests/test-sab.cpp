@@ -0,0 +1,92 @@
+// Test driver for static_append_buffer
+
+#define FRYSTL_DEBUG
+#include "static_append_buffer.hpp"
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace frystl;
+
+struct Move
+{
+    uint32_t thread;
+    uint32_t index;
+    uint32_t check;     // thread ^ index, to detect torn elements
+};
+
+// An element with a noexcept constructor
+struct Card
+{
+    Card(int r = 0, char s = '?') noexcept : rank(r), suit(s) {}
+    bool operator==(const Card &c) const noexcept { return rank == c.rank && suit == c.suit; }
+    int rank;
+    char suit;
+};
+
+int main() {
+    {
+        // One thread
+        static_append_buffer<Card, 3> b;
+        assert(b.empty() && b.capacity() == 3 && b.claimed() == 0);
+        assert(b.try_push_back(Card(1, 'a')));
+        Card two(2, 'b');
+        assert(b.try_push_back(two));
+        Card *p = b.try_emplace_back(5, 'x');
+        assert(p && *p == Card(5, 'x') && p == &b[2]);
+        assert(!b.try_push_back(Card(4, 'd')) && b.try_emplace_back() == nullptr);
+        assert(b.size() == 3 && b.claimed() == 5 && b.overflowed());
+        assert(b.at(0).rank == 1 && b[1] == two && b.end() - b.begin() == 3);
+        try {
+            b.at(3);
+            assert(false);
+        }
+        catch (std::out_of_range &) {}
+        b[0].suit = 'A';
+        const auto &cb = b;
+        assert(cb.begin()->suit == 'A' && *cb.rbegin() == Card(5, 'x'));
+        b.clear();
+        assert(b.empty() && b.claimed() == 0 && !b.overflowed());
+        assert(b.try_push_back(Card(6, 'f')) && b.size() == 1);
+    }
+    {
+        // Several writers and a reader
+        const unsigned nThreads = 6, perThread = 1000, capacity = 4000;
+        static static_append_buffer<Move, capacity> b;
+        std::atomic<unsigned> accepted(0), running(nThreads);
+        std::vector<std::thread> writers;
+        for (unsigned t = 0; t < nThreads; ++t) {
+            writers.emplace_back([&, t] {
+                for (uint32_t i = 0; i < perThread; ++i) {
+                    if (b.try_push_back(Move {t, i, t ^ i}))
+                        ++accepted;
+                }
+                --running;
+            });
+        }
+        // Read the committed prefix while the writers append.
+        unsigned lastSize = 0;
+        while (running) {
+            unsigned n = b.size();
+            assert(lastSize <= n && n <= capacity);
+            for (unsigned i = lastSize; i < n; ++i)
+                assert(b[i].check == (b[i].thread ^ b[i].index));
+            lastSize = n;
+        }
+        for (auto &w : writers)
+            w.join();
+        assert(accepted == capacity && b.size() == capacity);
+        assert(b.claimed() == nThreads * perThread && b.overflowed());
+        // Each thread's accepted moves are distinct and in order.
+        std::vector<uint32_t> next(nThreads, 0);
+        for (const Move &m : b) {
+            assert(m.check == (m.thread ^ m.index));
+            assert(next[m.thread] <= m.index);
+            next[m.thread] = m.index + 1;
+        }
+    }
+    std::cout << "test-sab finished normally." << std::endl;
+}
@@ -3,7 +3,9 @@
 #define FRYSTL_DEBUG
 #include "static_deque.hpp"
 #include "SelfCount.hpp"
+#include "Relocatable.hpp"
 #include <vector>
+#include <memory>
 #include <list>
 #include <iostream>
 
@@ -29,6 +31,98 @@ static void TestFillInsert(C deq, unsigned iat, unsigned n)
         assert(deq[size+n-1]()== size-1);
     }
 }
+// Make random inserts and erases in c, and the same changes to a
+// vector of ints, checking that they agree.  make(v) returns an
+// element holding v; value(e) returns the int held by e.
+template <class C, class Make, class Value>
+static void TestShifting(C &c, unsigned maxSize, Make make, Value value)
+{
+    std::vector<int> model;
+    uint32_t r = 1;
+    for (int i = 0; i < 3000; ++i) {
+        r = r * 1103515245 + 12345;
+        unsigned pos = (r >> 4) % (model.size() + 1);
+        int v = int(r >> 20);
+        switch ((r >> 16) % 6) {
+        case 0:
+            if (model.size() < maxSize) {
+                c.insert(c.begin() + pos, make(v));
+                model.insert(model.begin() + pos, v);
+            }
+            break;
+        case 1:
+            if (model.size() < maxSize) {
+                c.emplace(c.begin() + pos, make(v));
+                model.insert(model.begin() + pos, v);
+            }
+            break;
+        case 2:
+            if (pos < model.size()) {
+                c.erase(c.begin() + pos);
+                model.erase(model.begin() + pos);
+            }
+            break;
+        case 3: {
+            unsigned n = std::min<unsigned>((r >> 24) % 4, model.size() - pos);
+            c.erase(c.begin() + pos, c.begin() + pos + n);
+            model.erase(model.begin() + pos, model.begin() + pos + n);
+            break;
+        }
+        case 4:
+            if (model.size() < maxSize) {
+                c.emplace_front(make(v));
+                model.insert(model.begin(), v);
+            }
+            break;
+        case 5:
+            if (!model.empty()) {
+                c.pop_front();
+                model.erase(model.begin());
+            }
+            break;
+        }
+        assert(c.size() == model.size());
+        for (unsigned j = 0; j < model.size(); ++j)
+            assert(value(c[j]) == model[j]);
+    }
+}
+// Check that inserts into d whose copies throw leave it unchanged.
+// d must hold the values 0 to 7.
+template <class C>
+static void TestThrowingInsert(C &d)
+{
+    using T = std::decay_t<decltype(d.front())>;
+    const T src[] = {7, -1, 8};
+    const int count = Relocatable::Count();
+    auto same = [&d, count]() {
+        for (int i = 0; i < 8; ++i)
+            if (d[i]() != i)
+                return false;
+        return d.size() == 8 && Relocatable::Count() == count;
+    };
+    for (unsigned at : {1u, 3u, 6u}) {
+        try {
+            d.insert(d.begin() + at, src, src + 3);
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+        try {
+            d.insert(d.begin() + at, {T(7), T(-1)});
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+        try {
+            d.emplace(d.begin() + at, src[1]);
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+    }
+    d.insert(d.begin() + 2, src, src + 1);
+    assert(d.size() == 9 && d[2]() == 7 && d[3]() == 2);
+}
 int main() {
 
     // Constructors.
@@ -606,6 +700,185 @@ int main() {
         v1[16] = 235;
         assert(v0 < v1);
         assert(v0 != v1);
+    }{
+        // Compact offsets
+        static_assert(sizeof(static_deque<char, 10>) == 12,
+            "a small static_deque should use one-byte offsets");
+        static_assert(sizeof(static_deque<char, 1000>) == 1004,
+            "a static_deque of 1000 chars should use two-byte offsets");
+        // Fill to capacity when the capacity is the largest an offset
+        // type can hold, then slide from one end to the other.
+        static_deque<int, 255> d;
+        for (int i = 0; i < 200; ++i)
+            d.push_back(i);
+        for (int i = 1; i <= 55; ++i)
+            d.push_front(-i);
+        assert(d.size() == 255);
+        assert(d.front() == -55 && d.back() == 199 && d[55] == 0);
+        for (int i = 0; i < 100; ++i)
+            d.pop_front();
+        for (int i = 0; i < 100; ++i)
+            d.push_back(200 + i);
+        assert(d.size() == 255 && d.front() == 45 && d.back() == 299);
+        d.erase(d.begin() + 10, d.begin() + 20);
+        assert(d.size() == 245 && d[10] == 65);
+        d.insert(d.begin() + 5, 10u, 7);
+        assert(d.size() == 255 && d[5] == 7 && d[15] == 50);
+    }
+    {
+        // Sliding leaves no moved-from elements behind.
+        unsigned count0 = SelfCount::Count();
+        {
+            static_deque<SelfCount, 50> d;
+            for (int i = 0; i < 30; ++i)
+                d.emplace_back(i);
+            for (int i = 30; i < 200; ++i) {
+                d.pop_front();
+                d.emplace_back(i);
+            }
+            assert(d.size() == 30 && d.front()() == 170);
+            for (int i = 0; i < 100; ++i) {
+                d.pop_back();
+                d.emplace_front(i);
+            }
+            assert(d.size() == 30 && d.front()() == 99);
+            assert(SelfCount::Count() == count0 + 30);
+            d.insert(d.begin() + 10, 20u, SelfCount(5));
+            assert(d.size() == 50 && d[29]() == 5 && d[30]() == 89);
+            assert(SelfCount::Count() == count0 + 50);
+            assert(SelfCount::OwnerCount() == 50);
+        }
+        assert(SelfCount::Count() == count0);
+    }
+    {
+        // append_range(), resize_default_init(), generate_back()
+        unsigned count0 = SelfCount::Count();
+        {
+            static_deque<SelfCount, 20> d;
+            std::vector<int> iv {1, 2, 3};
+            d.append_range(iv);
+            std::list<int> li {4, 5};
+            d.append_range(li);
+            assert(d.size() == 5 && d[4]() == 5);
+            int next = 10;
+            d.generate_back(8, [&next] { return SelfCount(next++); });
+            assert(d.size() == 13 && d[5]() == 10 && d.back()() == 17);
+            for (int i = 0; i < 5; ++i)
+                d.pop_front();
+            // must slide to make room
+            d.generate_back(12, [&next] { return SelfCount(next++); });
+            assert(d.size() == 20 && d.front()() == 10 && d.back()() == 29);
+            assert(SelfCount::Count() == count0 + 20);
+            d.resize(5);
+            d.resize(8);
+            assert(d.size() == 8 && d[7]() == 0);
+            d.resize_default_init(2);
+            assert(d.size() == 2 && SelfCount::Count() == count0 + 2);
+        }
+        assert(SelfCount::Count() == count0);
+        static_deque<int, 10> id;
+        id.resize_default_init(10);
+        assert(id.size() == 10);
+        id.pop_front();
+        id.append_range(std::vector<int> {7});
+        assert(id.size() == 10 && id.back() == 7);
+    }
+    {
+        // erase_unordered(), erase_if() and erase_indices()
+        unsigned count0 = SelfCount::Count();
+        static_deque<SelfCount, 30> v;
+        for (int i = 0; i < 20; ++i)
+            v.emplace_back(i);
+        auto it = v.erase_unordered(v.begin() + 3);
+        assert(v.size() == 19 && (*it)() == 19 && v[3]() == 19);
+        it = v.erase_unordered(v.end() - 1);
+        assert(it == v.end() && v.size() == 18 && v.back()() == 17);
+        assert(SelfCount::OwnerCount() == 18);
+        auto nErased = erase_if(v, [](const SelfCount& s) { return s() % 3 == 0; });
+        assert(nErased == 5 && v.size() == 13);
+        const int remaining[] = {1, 2, 19, 4, 5, 7, 8, 10, 11, 13, 14, 16, 17};
+        for (unsigned i = 0; i < 13; ++i)
+            assert(v[i]() == remaining[i]);
+        assert(SelfCount::OwnerCount() == 13);
+        std::vector<unsigned> indices {0, 2, 2, 5, 12};
+        nErased = erase_indices(v, indices);
+        assert(nErased == 4 && v.size() == 9);
+        const int kept[] = {2, 4, 5, 8, 10, 11, 13, 14, 16};
+        for (unsigned i = 0; i < 9; ++i)
+            assert(v[i]() == kept[i]);
+        assert(erase_indices(v, std::vector<unsigned>()) == 0 && v.size() == 9);
+        assert(SelfCount::OwnerCount() == 9);
+        v.clear();
+        assert(SelfCount::Count() == count0);
+    }
+    {
+        // std::hash hashes the elements, wherever they are in the cells.
+        using Deque = static_deque<uint16_t, 40>;
+        std::hash<Deque> hasher;
+        Deque front, back;
+        for (uint16_t i = 0; i < 30; ++i) {
+            front.push_front(29 - i);
+            back.push_back(i);
+        }
+        assert(front == back && front.begin() != back.begin());
+        assert(hasher(front) == hasher(back));
+        back.back() = 0;
+        assert(hasher(front) != hasher(back));
+        std::hash<static_deque<std::string, 4>> shasher;
+        static_deque<std::string, 4> s1 {"ab", "c"};
+        assert(shasher(s1) == shasher({"ab", "c"}) && shasher(s1) != shasher({"a", "bc"}));
+    }
+    {
+        // Comparisons of deques whose elements start at different cells
+        static_deque<int16_t, 80> a, b;
+        for (int16_t i = 0; i < 70; ++i) {
+            a.push_back(i);
+            b.push_front(69 - i);
+        }
+        assert(a == b && !(a < b) && a <= b);
+        b[40] = -1;
+        assert(a != b && b < a && a > b && !(a < b));
+        b[40] = 40;
+        b.pop_back();
+        assert(b < a && b != a);
+#ifdef FRYSTL_HAS_THREE_WAY
+        assert((b <=> a) < 0 && (a <=> a) == 0);
+#endif
+    }
+    {
+        // Shifting trivially relocatable elements with memmove() and
+        // others one at a time
+        static_assert(is_trivially_relocatable<std::unique_ptr<int>>::value, "unique_ptr");
+        static_assert(!is_trivially_relocatable<SelfCount>::value, "SelfCount");
+        static_deque<std::unique_ptr<int>, 50> u;
+        TestShifting(u, 50,
+            [](int v) { return std::make_unique<int>(v); },
+            [](const std::unique_ptr<int> &p) { return *p; });
+        {
+            static_deque<SelfCount, 50> s;
+            TestShifting(s, 50,
+                [](int v) { return SelfCount(v); },
+                [](const SelfCount &e) { return int(e()); });
+            assert(SelfCount::Count() == int(s.size()));
+            assert(SelfCount::OwnerCount() == int(s.size()));
+        }
+        assert(SelfCount::Count() == 0);
+    }
+    {
+        // An insert whose copy throws leaves the deque as it was.
+        {
+            static_deque<Unrelocatable, 20> d;
+            for (int i = 0; i < 8; ++i)
+                d.emplace_back(i);
+            TestThrowingInsert(d);
+        }
+        {
+            static_deque<Relocatable, 20> d;
+            for (int i = 0; i < 8; ++i)
+                d.emplace_back(i);
+            TestThrowingInsert(d);
+        }
+        assert(Relocatable::Count() == 0);
     }
     std::cout << "test-sd ran normally." << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+// Test driver for static_flat_map
+
+#define FRYSTL_DEBUG
+#include "static_flat_map.hpp"
+#include <cassert>
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <random>
+
+using namespace frystl;
+
+// Check that m holds the same pairs as model, in the same order.
+template <class M, class Model>
+bool Same(const M &m, const Model &model)
+{
+    if (m.size() != model.size())
+        return false;
+    auto it = m.begin();
+    for (auto &kv : model) {
+        if (it->first != kv.first || it->second != kv.second)
+            return false;
+        ++it;
+    }
+    if (it != m.end())
+        return false;
+    auto rit = m.rbegin();
+    for (auto mit = model.rbegin(); mit != model.rend(); ++mit, ++rit)
+        if ((*rit).first != mit->first)
+            return false;
+    return true;
+}
+
+template <class Layout>
+void RandomTest(unsigned seed)
+{
+    static_flat_map<uint32_t, int, 64, std::less<uint32_t>, Layout> m;
+    std::map<uint32_t, int> model;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<uint32_t> dist(0, 100);
+    for (int i = 0; i < 2000; ++i) {
+        uint32_t k = dist(gen);
+        int v = int(gen() % 1000);
+        switch (gen() % 5) {
+        case 0:
+            if (model.size() < 64 || model.count(k)) {
+                auto r = m.insert({k, v});
+                auto mr = model.insert({k, v});
+                assert(r.second == mr.second && r.first->second == mr.first->second);
+            }
+            break;
+        case 1:
+            if (model.size() < 64 || model.count(k)) {
+                m[k] += v;
+                model[k] += v;
+            }
+            break;
+        case 2:
+            if (model.size() < 64 || model.count(k)) {
+                m.insert_or_assign(k, v);
+                model.insert_or_assign(k, v);
+            }
+            break;
+        case 3:
+            assert(m.erase(k) == model.erase(k));
+            break;
+        default: {
+            auto lb = m.lower_bound(k);
+            auto mlb = model.lower_bound(k);
+            assert((lb == m.end()) == (mlb == model.end()));
+            if (lb != m.end())
+                assert(lb->first == mlb->first && lb->second == mlb->second);
+            auto ub = m.upper_bound(k);
+            assert(ub == m.end() ? model.upper_bound(k) == model.end()
+                                 : ub->first == model.upper_bound(k)->first);
+            assert(m.contains(k) == (model.count(k) == 1));
+        }
+        }
+        assert(Same(m, model));
+    }
+}
+
+// Insert batches of pairs with repeated keys, some already present.
+template <class Layout>
+void RangeInsertTest(unsigned seed)
+{
+    static_flat_map<uint32_t, int, 64, std::less<uint32_t>, Layout> m;
+    std::map<uint32_t, int> model;
+    std::mt19937 gen(seed);
+    for (int i = 0; i < 300; ++i) {
+        std::vector<std::pair<uint32_t, int>> batch(gen() % 20);
+        for (auto &kv : batch)
+            kv = {gen() % 64, int(gen() % 1000)};
+        m.insert(batch.begin(), batch.end());
+        model.insert(batch.begin(), batch.end());
+        assert(Same(m, model));
+        if (model.size() == 64) {
+            m.clear();
+            model.clear();
+        }
+    }
+}
+
+int main() {
+    RandomTest<sorted_layout>(1);
+    RandomTest<eytzinger_layout>(2);
+    RangeInsertTest<sorted_layout>(3);
+    RangeInsertTest<eytzinger_layout>(4);
+    {
+        // Construction and access
+        static_flat_map<std::string, int, 10> m {{"b", 2}, {"a", 1}, {"c", 3}, {"a", 9}};
+        assert(m.size() == 3 && m.at("a") == 1 && m["c"] == 3);
+        assert(m.keys().front() == "a" && m.values().back() == 3);
+        try {
+            m.at("z");
+            assert(false);
+        }
+        catch (std::out_of_range &) {}
+        m["d"] = 4;
+        assert(m.size() == 4 && m.at("d") == 4);
+        auto r = m.try_emplace("b", 20);
+        assert(!r.second && r.first->second == 2);
+        r = m.emplace("e", 5);
+        assert(r.second && (*r.first).first == "e");
+        for (auto kv : m)
+            kv.second *= 10;
+        assert(m["a"] == 10 && m["e"] == 50);
+        const auto &cm = m;
+        static_flat_map<std::string, int, 10>::const_iterator ci = m.begin();
+        assert(ci == cm.begin() && ci->first == "a" && cm.find("q") == cm.end());
+        assert(std::distance(cm.equal_range("b").first, cm.equal_range("b").second) == 1);
+        auto it = m.erase(m.find("b"));
+        assert(it->first == "c" && m.size() == 4);
+        it = m.erase(m.begin(), m.find("e"));
+        assert(it->first == "e" && m.size() == 1);
+        assert(erase_if(m, [](auto kv) { return kv.second == 50; }) == 1 && m.empty());
+    }
+    {
+        // Comparison, swap, and the Eytzinger layout with strings
+        using M = static_flat_map<int, std::string, 40, std::less<int>, eytzinger_layout>;
+        M a, b;
+        std::map<int, std::string> model;
+        for (int i = 0; i < 40; ++i) {
+            a[i * 13 % 40] = std::to_string(i);
+            model[i * 13 % 40] = std::to_string(i);
+        }
+        b.insert(model.begin(), model.end());
+        assert(Same(a, model) && a == b && !(a < b));
+        b[3] = "x";
+        assert(a != b && (a < b) == (model[3] < "x"));
+        swap(a, b);
+        assert(a[3] == "x");
+        a.erase(a.find(10), a.find(30));
+        model.erase(model.find(10), model.find(30));
+        model[3] = "x";
+        assert(Same(a, model));
+        assert(erase_if(a, [](auto kv) { return kv.first % 2; }) == 10);
+    }
+    std::cout << "test-sfm finished normally." << std::endl;
+}
@@ -0,0 +1,141 @@
+// Test driver for static_flat_set
+
+#define FRYSTL_DEBUG
+#include "static_flat_set.hpp"
+#include <cassert>
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include <random>
+
+using namespace frystl;
+
+// Check that s holds the same keys as model, in the same order, and
+// that its iterators work both ways.
+template <class S, class Model>
+bool Same(const S &s, const Model &model)
+{
+    if (s.size() != model.size())
+        return false;
+    if (!std::equal(s.begin(), s.end(), model.begin(), model.end()))
+        return false;
+    return std::equal(s.rbegin(), s.rend(), model.rbegin(), model.rend());
+}
+
+// Insert, erase and look up random keys in a static_flat_set and a
+// std::set, checking that they agree.
+template <class Layout, class Key>
+void RandomTest(unsigned seed)
+{
+    static_flat_set<Key, 100, std::less<Key>, Layout> s;
+    std::set<Key> model;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(0, 150);
+    for (int i = 0; i < 2000; ++i) {
+        Key k = Key(dist(gen));
+        switch (gen() % 4) {
+        case 0:
+        case 1:
+            if (model.size() < 100 || model.count(k)) {
+                auto r = s.insert(k);
+                auto m = model.insert(k);
+                assert(r.second == m.second && *r.first == k);
+            }
+            break;
+        case 2:
+            assert(s.erase(k) == model.erase(k));
+            break;
+        default: {
+            auto lb = s.lower_bound(k);
+            auto mlb = model.lower_bound(k);
+            assert((lb == s.end()) == (mlb == model.end()));
+            if (lb != s.end())
+                assert(*lb == *mlb);
+            auto ub = s.upper_bound(k);
+            auto mub = model.upper_bound(k);
+            assert((ub == s.end()) == (mub == model.end()));
+            if (ub != s.end())
+                assert(*ub == *mub);
+            assert(s.contains(k) == (model.count(k) == 1) && s.count(k) == model.count(k));
+            auto er = s.equal_range(k);
+            assert(size_t(std::distance(er.first, er.second)) == model.count(k));
+        }
+        }
+        assert(Same(s, model));
+    }
+}
+
+int main() {
+    RandomTest<sorted_layout, uint16_t>(1);     // SIMD linear search while small
+    RandomTest<sorted_layout, int8_t>(5);       // keys above 127 wrap to negative
+    RandomTest<sorted_layout, uint32_t>(6);
+    RandomTest<sorted_layout, int64_t>(2);      // branchless binary search
+    RandomTest<eytzinger_layout, uint16_t>(3);
+    RandomTest<eytzinger_layout, int64_t>(4);
+    {
+        // Construction, iteration, and erasure by iterator
+        static_flat_set<int, 20> s {5, 3, 9, 3, 1};
+        assert(s.size() == 4 && Same(s, std::set<int> {1, 3, 5, 9}));
+        std::vector<int> v {7, 2, 7, 8};
+        s.insert(v.begin(), v.end());
+        assert(Same(s, std::set<int> {1, 2, 3, 5, 7, 8, 9}));
+        auto it = s.erase(s.find(5));
+        assert(*it == 7 && Same(s, std::set<int> {1, 2, 3, 7, 8, 9}));
+        it = s.erase(std::next(s.begin()), s.find(8));
+        assert(*it == 8 && Same(s, std::set<int> {1, 8, 9}));
+        assert(*s.emplace(4).first == 4 && !s.emplace(4).second);
+        assert(s.keys().front() == 1 && s.keys().back() == 9);
+        s = {6, 5};
+        assert(Same(s, std::set<int> {5, 6}));
+        static_flat_set<int, 30> t {5, 6};
+        assert(s == t && !(s < t));
+        t.insert(0);
+        assert(s != t && t < s);
+        s.clear();
+        assert(s.empty() && s.begin() == s.end());
+    }
+    {
+        // Inserting a range with more duplicates than free room
+        static_flat_set<int, 4> s {1};
+        std::vector<int> v {2, 2, 2, 3, 3, 1, 4, 4, 4, 4, 1};
+        s.insert(v.begin(), v.end());
+        assert(Same(s, std::set<int> {1, 2, 3, 4}));
+    }
+    {
+        // Other comparisons and key types, in both layouts
+        static_flat_set<std::string, 10, std::greater<std::string>> s {"b", "a", "c"};
+        assert(*s.begin() == "c" && *s.rbegin() == "a" && s.find("b") != s.end());
+        static_flat_set<std::string, 40, std::less<std::string>, eytzinger_layout> e;
+        std::set<std::string> model;
+        for (int i = 0; i < 40; ++i) {
+            std::string k = std::to_string(i * 7 % 40);
+            e.insert(k);
+            model.insert(k);
+        }
+        assert(Same(e, model));
+        assert(erase_if(e, [](const std::string &k) { return k.size() == 1; }) == 10);
+        for (auto it = model.begin(); it != model.end(); )
+            it = it->size() == 1 ? model.erase(it) : std::next(it);
+        assert(Same(e, model) && e.find("5") == e.end() && *e.find("15") == "15");
+        // Erasing from the middle
+        e.erase(e.find("21"), e.find("30"));
+        model.erase(model.find("21"), model.find("30"));
+        assert(Same(e, model));
+    }
+    {
+        // Ranks and slots of the Eytzinger layout agree with its order.
+        for (uint32_t n = 0; n < 70; ++n) {
+            uint32_t rank = 0;
+            for (uint32_t slot = eytzinger_layout::First(n); slot != n;
+                 slot = eytzinger_layout::Next(slot, n), ++rank) {
+                assert(eytzinger_layout::RankOfSlot(slot, n) == rank);
+                assert(eytzinger_layout::SlotOfRank(rank, n) == slot);
+            }
+            assert(rank == n && eytzinger_layout::SlotOfRank(n, n) == n);
+            assert(eytzinger_layout::RankOfSlot(n, n) == n);
+        }
+    }
+    std::cout << "test-sfs finished normally." << std::endl;
+}
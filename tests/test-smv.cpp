@@ -0,0 +1,201 @@
+// Test driver for small_vector
+
+#define FRYSTL_DEBUG
+#include "small_vector.hpp"
+#include "SelfCount.hpp"
+#include "Relocatable.hpp"
+#include <iostream>
+#include <vector>
+#include <list>
+#include <string>
+
+using namespace frystl;
+
+// A Relocatable whose move constructor may throw, so small_vector
+// copies it when it reallocates
+struct Unsure : Relocatable {
+    using Relocatable::Relocatable;
+    Unsure(const Unsure &) = default;
+    Unsure(Unsure &&other) noexcept(false)
+        : Relocatable(std::move(other))
+        {}
+    Unsure &operator=(const Unsure &) = default;
+    Unsure &operator=(Unsure &&) = default;
+};
+
+int main() {
+    {
+        // Constructors
+        small_vector<int, 8> empty;
+        assert(empty.empty() && empty.is_inline() && empty.capacity() == 8);
+
+        small_vector<int, 8> fill(5, -3);
+        assert(fill.size() == 5 && fill.is_inline());
+        for (int k : fill) assert(k == -3);
+
+        small_vector<int, 8> big(20, 7);
+        assert(big.size() == 20 && !big.is_inline() && big.capacity() >= 20);
+        assert(big[19] == 7);
+
+        small_vector<int, 4> def(6);
+        assert(def.size() == 6 && def[5] == 0);
+
+        std::list<int> li {1, 2, 3, 4, 5, 6};
+        small_vector<int, 4> range(li.begin(), li.end());
+        assert(range.size() == 6 && range[5] == 6 && !range.is_inline());
+
+        small_vector<int, 4> il {9, 8, 7};
+        assert(il.size() == 3 && il.back() == 7 && il.is_inline());
+
+        small_vector<int, 4> copy(range);
+        assert(copy == range);
+        small_vector<int, 10> wider(range);
+        assert(wider.size() == 6 && wider.is_inline() && wider == range);
+    }
+    assert(SelfCount::Count() == 0);
+    {
+        // Spilling and moving
+        small_vector<SelfCount, 4> v;
+        for (int i = 0; i < 4; ++i)
+            v.emplace_back(i);
+        assert(v.is_inline());
+        const SelfCount* inlineData = v.data();
+        v.emplace_back(4);
+        assert(!v.is_inline() && v.data() != inlineData);
+        assert(v.size() == 5 && v[4]() == 4 && v[0]() == 0);
+        assert(SelfCount::Count() == 5 && SelfCount::OwnerCount() == 5);
+        // emplace_back of an element of the vector itself while full
+        while (v.size() < v.capacity())
+            v.emplace_back(int(v.size()));
+        unsigned n = v.size();
+        v.push_back(v[0]);
+        assert(v.size() == n + 1 && v.back()() == 0);
+        assert(SelfCount::OwnerCount() == n + 1);
+
+        // move constructor steals the heap buffer
+        const SelfCount* heapData = v.data();
+        small_vector<SelfCount, 4> w(std::move(v));
+        assert(w.data() == heapData && v.empty() && v.is_inline());
+        assert(SelfCount::OwnerCount() == n + 1);
+
+        // move of an inline vector moves the elements
+        small_vector<SelfCount, 4> x;
+        x.emplace_back(11);
+        x.emplace_back(12);
+        small_vector<SelfCount, 4> y(std::move(x));
+        assert(x.empty() && y.size() == 2 && y[1]() == 12 && y.is_inline());
+        assert(SelfCount::OwnerCount() == n + 3);
+
+        // move assignment
+        y = std::move(w);
+        assert(y.data() == heapData && w.empty());
+        assert(SelfCount::OwnerCount() == n + 1);
+
+        // shrink_to_fit back to inline
+        y.erase(y.begin() + 3, y.end());
+        assert(y.size() == 3 && SelfCount::OwnerCount() == 3);
+        y.shrink_to_fit();
+        assert(y.is_inline() && y.size() == 3 && y[2]() == 2);
+        assert(SelfCount::Count() == 3);
+    }
+    assert(SelfCount::Count() == 0);
+    assert(SelfCount::OwnerCount() == 0);
+    {
+        // A throwing copy while reallocating leaves the vector unchanged.
+        small_vector<Unsure, 2> v;
+        v.emplace_back(1);
+        v.emplace_back(-1);
+        try {
+            v.emplace_back(3);
+            assert(false);
+        }
+        catch (std::runtime_error &) {}
+        assert(v.size() == 2 && v.is_inline() && v[0]() == 1 && v[1]() == -1);
+        assert(Relocatable::Count() == 2);
+        v[1] = Unsure(2);
+        v.reserve(8);
+        v[1] = Unsure(-1);
+        try {
+            v.shrink_to_fit();
+            assert(false);
+        }
+        catch (std::runtime_error &) {}
+        assert(!v.is_inline() && v.size() == 2 && v[1]() == -1);
+        assert(Relocatable::Count() == 2);
+
+        // Moving from an inline vector with a larger inline capacity
+        // grows the new vector.
+        small_vector<Unsure, 8> donor;
+        for (int i = 0; i < 6; ++i)
+            donor.emplace_back(i);
+        small_vector<Unsure, 2> w(std::move(donor));
+        assert(donor.empty() && !w.is_inline() && w.size() == 6 && w[5]() == 5);
+        for (int i = 0; i < 5; ++i)
+            donor.emplace_back(i);
+        v = std::move(donor);
+        assert(donor.empty() && v.size() == 5 && v[4]() == 4);
+        assert(Relocatable::Count() == 11);
+    }
+    assert(Relocatable::Count() == 0);
+    {
+        // Inserts and erases
+        small_vector<SelfCount, 6> v;
+        for (int i = 0; i < 5; ++i)
+            v.emplace_back(i);
+        auto it = v.emplace(v.begin() + 2, 20);
+        assert(it == v.begin() + 2 && (*it)() == 20 && v.size() == 6);
+        assert(v.is_inline());
+        it = v.insert(v.begin(), SelfCount(30));
+        assert(!v.is_inline() && v[0]() == 30 && v[3]() == 20 && v[6]() == 4);
+        it = v.insert(v.begin() + 1, 3, v[0]);
+        assert(v.size() == 10 && v[1]() == 30 && v[3]() == 30 && v[4]() == 0);
+        std::vector<int> more {100, 101};
+        it = v.insert(v.end() - 1, more.begin(), more.end());
+        assert(v.size() == 12 && (*it)() == 100 && v[11]() == 4);
+        std::list<int> evenMore {200, 201};
+        it = v.insert(v.begin(), evenMore.begin(), evenMore.end());
+        assert(v.size() == 14 && v[1]() == 201 && v[2]() == 30);
+        assert(SelfCount::OwnerCount() == 14);
+        it = v.erase(v.begin() + 1, v.begin() + 6);
+        assert(v.size() == 9 && (*it)() == 0);
+        it = v.erase(v.begin());
+        assert(v.size() == 8 && (*it)() == 0);
+        assert(SelfCount::OwnerCount() == 8 && SelfCount::Count() == 8);
+        v.resize(3);
+        assert(v.size() == 3 && SelfCount::Count() == 3);
+        v.resize(5, SelfCount(7));
+        assert(v.size() == 5 && v[4]() == 7);
+    }
+    assert(SelfCount::Count() == 0);
+    assert(SelfCount::OwnerCount() == 0);
+    {
+        // Assignment and comparison
+        small_vector<std::string, 2> a {"one", "two", "three"};
+        small_vector<std::string, 2> b;
+        b = a;
+        assert(a == b && b.size() == 3);
+        b.pop_back();
+        assert(b < a && b != a);
+        small_vector<std::string, 3> c;
+        c = a;
+        assert(c == a && c.is_inline());
+        c.assign(2, "x");
+        assert(c.size() == 2 && c[1] == "x");
+        c = {"p", "q", "r", "s"};
+        assert(c.size() == 4 && !c.is_inline());
+        swap(a, b);
+        assert(a.size() == 2 && b.size() == 3);
+        try {
+            c.at(4);
+            assert(false);
+        }
+        catch (std::out_of_range&) {}
+    }
+    {
+        // std::hash
+        std::hash<small_vector<int, 4>> hasher;
+        small_vector<int, 4> a {1, 2, 3, 4, 5}, b {1, 2, 3, 4, 5}, c {1, 2, 3, 4, 6};
+        assert(hasher(a) == hasher(b) && hasher(a) != hasher(c));
+    }
+    std::cout << "test-smv finished normally." << std::endl;
+}
@@ -0,0 +1,161 @@
+// Test driver for static_string
+
+#define FRYSTL_DEBUG
+#include "static_string.hpp"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+using namespace frystl;
+
+int main() {
+    {
+        // Constructors, size and termination
+        static_string<20> empty;
+        assert(empty.empty() && empty.size() == 0 && *empty.c_str() == '\0');
+        assert(empty.capacity() == 20 && empty.available() == 20);
+        static_assert(sizeof(static_string<30>) == 32, "30 chars, a NUL, and a 1-byte size");
+        static_string<20> a = "hello", b("hello world", 5), c(3, 'x');
+        std::string_view sv = "view";
+        static_string<20> d(sv);
+        std::vector<char> v {'a', 'b'};
+        static_string<20> e(v.begin(), v.end()), f {'q', 'r'};
+        assert(a == "hello" && b == a && c == "xxx" && d == sv && e == "ab" && f == "qr");
+        assert(std::strlen(a.c_str()) == 5 && a[5] == '\0' && a.length() == 5);
+        static_string<40> g(a);
+        assert(g == a && g.capacity() == 40);
+        a = "bye";
+        assert(a == "bye" && a.size() == 3);
+        a = std::string_view("x");
+        assert(a == "x");
+        a = 'z';
+        assert(a == "z");
+        a = {'o', 'k'};
+        assert(a == "ok");
+        a.assign(4, '-');
+        assert(a == "----");
+        std::string s("from string");
+        a.assign(s.begin(), s.end());
+        assert(a == "from string" && s == a.c_str());
+    }
+    {
+        // Element access and iterators
+        static_string<10> s = "abcdef";
+        assert(s.front() == 'a' && s.back() == 'f' && s.at(2) == 'c');
+        s[0] = 'A';
+        s.at(1) = 'B';
+        s.back() = 'F';
+        assert(s == "ABcdeF");
+        try {
+            s.at(6);
+            assert(false);
+        }
+        catch (std::out_of_range &) {}
+        std::string r(s.rbegin(), s.rend());
+        assert(r == "FedcBA" && s.end() - s.begin() == 6);
+        std::string_view view = s;
+        assert(view == "ABcdeF" && view.data() == s.data());
+    }
+    {
+        // Modifiers
+        static_string<32> s;
+        s.append("key").push_back(':');
+        s += "value";
+        s += '!';
+        s += std::string_view("..");
+        assert(s == "key:value!..");
+        s.append(3, '#').append("abcdef", 2);
+        assert(s == "key:value!..###ab");
+        s.pop_back();
+        assert(s == "key:value!..###a" && s.c_str()[s.size()] == '\0');
+        s.erase(3, 6);
+        assert(s == "key!..###a");
+        s.erase(4);
+        assert(s == "key!");
+        s.insert(0, "[");
+        s.insert(s.size(), "]");
+        s.insert(1, 2, '*');
+        assert(s == "[**key!]");
+        auto it = s.insert(s.begin() + 3, '+');
+        assert(*it == '+' && s == "[**+key!]");
+        it = s.erase(s.begin());
+        assert(it == s.begin() && s == "**+key!]");
+        it = s.erase(s.begin(), s.begin() + 3);
+        assert(*it == 'k' && s == "key!]");
+        s.erase(0);
+        assert(s.empty() && *s.c_str() == '\0');
+        s.resize(3, 'y');
+        assert(s == "yyy");
+        s.resize(1);
+        assert(s == "y" && s.c_str()[1] == '\0');
+        // Appending part of itself
+        s = "abc";
+        s.append(std::string_view(s));
+        assert(s == "abcabc");
+        try {
+            s.insert(7, "x");
+            assert(false);
+        }
+        catch (std::out_of_range &) {}
+        static_string<32> t = "other";
+        swap(s, t);
+        assert(s == "other" && t == "abcabc");
+        s.clear();
+        assert(s.empty() && s == "");
+    }
+    {
+        // Searching and comparison
+        static_string<40> s = "the cat sat on the mat";
+        assert(s.find("the") == 0 && s.find("the", 1) == 15 && s.find("dog") == s.npos);
+        assert(s.find('c') == 4 && s.rfind("at") == 20 && s.rfind('t', 19) == 15);
+        assert(s.starts_with("the c") && !s.starts_with("cat") && s.ends_with("mat"));
+        assert(s.contains("sat") && !s.contains("sit") && !s.ends_with(std::string(50, 'a')));
+        assert(s.substr(4, 3) == "cat" && s.substr(19) == "mat");
+        static_string<8> a = "abc", b = "abd";
+        static_string<20> c = "abc";
+        assert(a.compare(b) < 0 && a.compare("abc") == 0 && b.compare(std::string_view("ab")) > 0);
+        assert(a == c && a != b && a < b && b > c && a <= c && c >= a);
+        assert(a == "abc" && "abc" == a && a != "ab" && "ab" != a);
+        assert(a < "abd" && "abb" < a && a <= "abc" && a > "ab" && "abd" > a && a >= "abc");
+        assert(a < std::string("b") && std::string_view("b") > a);
+#ifdef FRYSTL_HAS_THREE_WAY
+        assert((a <=> b) < 0 && (a <=> "abc") == 0);
+#endif
+    }
+    {
+        // Numbers
+        static_string<40> s = "n=";
+        assert(s.append_number(-42));
+        s += ' ';
+        assert(s.append_number(255u, 16));
+        s += ' ';
+        assert(s.append_number(0.5));
+        s += ' ';
+        assert(s.append_number(uint64_t(18446744073709551615ull)));
+        assert(s == "n=-42 ff 0.5 18446744073709551615" && s.c_str()[s.size()] == '\0');
+        static_string<4> small = "ab";
+        assert(small.append_number(12));
+        assert(!small.append_number(1));
+        assert(small == "ab12");
+        small = "ab";
+        assert(!small.append_number(123) && small == "ab");
+        assert(to_static_string(12345) == "12345" && to_static_string(-2.25) == "-2.25");
+        assert(to_static_string<8>(7, 2) == "111");
+        assert(to_static_string(1e300).size() == 6);
+    }
+    {
+        // Hashing and streams
+        std::unordered_set<static_string<16>> set {"one", "two"};
+        assert(set.size() == 2 && set.count("one") && !set.count("three"));
+        std::hash<static_string<16>> h;
+        assert(h("one") == h(static_string<16>("one")) && h("one") != h("two"));
+        std::ostringstream os;
+        os << static_string<10>("out") << '.';
+        assert(os.str() == "out.");
+    }
+    std::cout << "test-ss finished normally." << std::endl;
+}
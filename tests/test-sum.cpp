@@ -0,0 +1,147 @@
+// Test driver for static_unordered_map
+
+#define FRYSTL_DEBUG
+#include "static_unordered_map.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <random>
+
+using namespace frystl;
+
+// Check that m holds the same pairs as model.
+template <class M, class Model>
+bool Same(const M &m, const Model &model)
+{
+    if (m.size() != model.size())
+        return false;
+    size_t n = 0;
+    for (auto &kv : m) {
+        auto it = model.find(kv.first);
+        if (it == model.end() || it->second != kv.second)
+            return false;
+        ++n;
+    }
+    return n == model.size();
+}
+
+void RandomTest(unsigned seed)
+{
+    static_unordered_map<uint32_t, std::string, 64> m;
+    std::unordered_map<uint32_t, std::string> model;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<uint32_t> dist(0, 100);
+    for (int i = 0; i < 4000; ++i) {
+        uint32_t k = dist(gen);
+        std::string v(gen() % 20, char('a' + gen() % 26));
+        bool room = model.size() < 64 || model.count(k);
+        switch (gen() % 6) {
+        case 0:
+            if (room) {
+                auto r = m.insert({k, v});
+                auto mr = model.insert({k, v});
+                assert(r.second == mr.second && r.first->second == mr.first->second);
+            }
+            break;
+        case 1:
+            if (room) {
+                m[k] += v;
+                model[k] += v;
+            }
+            break;
+        case 2:
+            if (room) {
+                m.insert_or_assign(k, v);
+                model.insert_or_assign(k, v);
+            }
+            break;
+        case 3:
+        case 4:
+            assert(m.erase(k) == model.erase(k));
+            break;
+        default: {
+            auto it = m.find(k);
+            auto mit = model.find(k);
+            assert((it == m.end()) == (mit == model.end()));
+            if (it != m.end())
+                assert(it->first == k && it->second == mit->second && m.at(k) == mit->second);
+        }
+        }
+        assert(m.size() == model.size());
+    }
+    assert(Same(m, model));
+    erase_if(m, [](const auto &kv) { return kv.second.size() > 10; });
+    for (auto it = model.begin(); it != model.end(); )
+        it = it->second.size() > 10 ? model.erase(it) : std::next(it);
+    assert(Same(m, model));
+}
+
+int main() {
+    {
+        // Element access
+        static_unordered_map<std::string, int, 10> m;
+        assert(m.empty() && m.capacity() == 10 && m.bucket_count() == 16);
+        m["one"] = 1;
+        m["two"] = 2;
+        ++m["one"];
+        assert(m.size() == 2 && m.at("one") == 2 && m["two"] == 2);
+        try {
+            m.at("three");
+            assert(false);
+        }
+        catch (std::out_of_range &) {}
+        const auto &cm = m;
+        assert(cm.at("two") == 2 && cm.find("three") == cm.end());
+        auto r = m.try_emplace("three", 3);
+        assert(r.second && r.first->second == 3);
+        r = m.try_emplace("three", 4);
+        assert(!r.second && r.first->second == 3);
+        r = m.insert_or_assign("three", 5);
+        assert(!r.second && m["three"] == 5);
+        r = m.emplace("four", 4);
+        assert(r.second && m.count("four") == 1);
+        r = m.insert({"four", 0});
+        assert(!r.second && r.first->second == 4);
+        // Iterators visit elements in the order inserted.
+        auto it = m.begin();
+        assert(it->first == "one" && (++it)->first == "two");
+        it->second = 22;
+        assert(m["two"] == 22);
+        static_unordered_map<std::string, int, 10>::const_iterator cit = m.begin();
+        assert(cit == m.cbegin() && cit->first == "one");
+        // Erasing moves the last element into the hole.
+        it = m.erase(m.begin());
+        assert(it->first == "four" && m.size() == 3 && !m.contains("one"));
+    }
+    {
+        // Copy, move, swap and comparison
+        using Map = static_unordered_map<int, std::string, 20>;
+        Map a {{1, "one"}, {2, "two"}, {3, "three"}};
+        Map b(a);
+        assert(a == b);
+        b[2] = "deux";
+        assert(a != b);
+        Map c(std::move(b));
+        assert(c.at(2) == "deux" && b.empty());
+        Map d {{3, "three"}, {2, "two"}, {1, "one"}};
+        assert(a == d);
+        swap(c, d);
+        assert(c == a && d.at(2) == "deux");
+        d = a;
+        assert(d == a);
+        d.clear();
+        assert(d.empty() && !d.contains(1));
+        d = std::move(a);
+        assert(d == c && a.empty());
+        std::vector<std::pair<int, std::string>> v {{7, "seven"}, {8, "eight"}};
+        Map e(v.begin(), v.end());
+        assert(e.size() == 2 && e.at(8) == "eight");
+        e = {{9, "nine"}};
+        assert(e.size() == 1 && e.contains(9));
+    }
+    for (unsigned seed = 1; seed <= 10; ++seed)
+        RandomTest(seed);
+    std::cout << "test-sum finished normally." << std::endl;
+}
@@ -0,0 +1,156 @@
+// Test driver for static_unordered_set
+
+#define FRYSTL_DEBUG
+#include "static_unordered_set.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <random>
+
+using namespace frystl;
+
+// Check that s holds the same keys as model.
+template <class S, class Model>
+bool Same(const S &s, const Model &model)
+{
+    if (s.size() != model.size())
+        return false;
+    size_t n = 0;
+    for (auto &k : s) {
+        if (!model.count(k))
+            return false;
+        ++n;
+    }
+    return n == model.size();
+}
+
+// A hash that puts every key in one of 4 home slots, to make long
+// clusters.
+struct BadHash
+{
+    size_t operator()(uint32_t k) const noexcept { return k & 3; }
+};
+
+template <class Hash>
+void RandomTest(unsigned seed)
+{
+    static_unordered_set<uint32_t, 100, Hash> s;
+    std::unordered_set<uint32_t> model;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<uint32_t> dist(0, 150);
+    for (int i = 0; i < 5000; ++i) {
+        uint32_t k = dist(gen);
+        switch (gen() % 4) {
+        case 0:
+        case 1:
+            if (model.size() < 100 || model.count(k)) {
+                auto r = s.insert(k);
+                assert(r.second == model.insert(k).second && *r.first == k);
+            }
+            break;
+        case 2:
+            assert(s.erase(k) == model.erase(k));
+            break;
+        default:
+            assert(s.contains(k) == (model.count(k) == 1));
+            assert(s.find(k) == s.end() || *s.find(k) == k);
+        }
+        assert(s.size() == model.size());
+    }
+    assert(Same(s, model));
+    size_t n = erase_if(s, [](uint32_t k) { return k % 3 == 0; });
+    size_t mn = 0;
+    for (auto it = model.begin(); it != model.end(); )
+        if (*it % 3 == 0) {
+            it = model.erase(it);
+            ++mn;
+        }
+        else
+            ++it;
+    assert(n == mn && Same(s, model));
+    s.clear();
+    assert(s.empty() && s.begin() == s.end());
+    for (uint32_t k : model)
+        assert(!s.contains(k));
+}
+
+int main() {
+    {
+        // Constructors, insert and lookup
+        static_unordered_set<int, 10> s;
+        assert(s.empty() && s.size() == 0 && s.capacity() == 10);
+        assert(s.bucket_count() == 16 && s.load_factor() == 0);
+        auto r = s.insert(3);
+        assert(r.second && *r.first == 3 && s.size() == 1);
+        r = s.insert(3);
+        assert(!r.second && *r.first == 3 && s.size() == 1);
+        assert(s.emplace(4).second && s.count(4) == 1 && s.count(5) == 0);
+        static_unordered_set<int, 10> t {1, 2, 3, 2, 1};
+        assert(t.size() == 3 && t.contains(2) && !t.contains(4));
+        std::vector<int> v {5, 6, 7, 5};
+        static_unordered_set<int, 10> u(v.begin(), v.end());
+        assert(u.size() == 3 && u.contains(7));
+        u = {8, 9};
+        assert(u.size() == 2 && u.contains(8) && !u.contains(5));
+        // Iterators visit keys in the order inserted.
+        static_unordered_set<int, 10> w {10, 20, 30};
+        auto it = w.begin();
+        assert(*it++ == 10 && *it++ == 20 && *it++ == 30 && it == w.end());
+        // Erasing moves the last key into the hole.
+        it = w.erase(w.begin());
+        assert(*it == 30 && w.size() == 2 && !w.contains(10));
+        assert(w.erase(20) == 1 && w.erase(20) == 0 && w.size() == 1);
+        static_assert(sizeof(static_unordered_set<int, 10>) <= 10 * 12 + 16 + 8,
+            "entries, a byte per slot, and a size");
+    }
+    {
+        // Copy, move, swap and comparison
+        static_unordered_set<std::string, 20> a {"one", "two", "three"};
+        static_unordered_set<std::string, 20> b(a);
+        assert(a == b && b.contains("two"));
+        static_unordered_set<std::string, 20> c(std::move(b));
+        assert(c == a && b.empty());
+        b = c;
+        assert(b == c);
+        c.erase("one");
+        assert(c != a);
+        c = std::move(a);
+        assert(c.size() == 3 && c.contains("one") && a.empty());
+        static_unordered_set<std::string, 20> d {"three", "one", "two"};
+        assert(c == d);
+        a = {"x"};
+        swap(a, d);
+        assert(a.size() == 3 && d.size() == 1 && d.contains("x"));
+        a.emplace(5, 'z');
+        assert(a.contains("zzzzz"));
+        std::string key = "moved";
+        a.insert(std::move(key));
+        assert(a.contains("moved"));
+        erase_if(a, [](const std::string &k) { return k.size() > 3; });
+        assert(a.size() == 2 && a.contains("one") && a.contains("two"));
+        a.clear();
+        assert(a.empty() && !a.contains("one"));
+        a.insert("one");
+        assert(a.size() == 1 && a.contains("one"));
+    }
+    {
+        // Filling to capacity
+        static_unordered_set<uint32_t, 200> s;
+        for (uint32_t k = 0; k < 200; ++k)
+            assert(s.insert(k * 7919).second);
+        assert(s.size() == 200 && s.bucket_count() == 256);
+        for (uint32_t k = 0; k < 200; ++k)
+            assert(s.contains(k * 7919) && !s.contains(k * 7919 + 1));
+        for (uint32_t k = 0; k < 200; k += 2)
+            assert(s.erase(k * 7919) == 1);
+        for (uint32_t k = 0; k < 200; ++k)
+            assert(s.contains(k * 7919) == (k % 2 == 1));
+    }
+    for (unsigned seed = 1; seed <= 10; ++seed) {
+        RandomTest<std::hash<uint32_t>>(seed);
+        RandomTest<BadHash>(seed);
+    }
+    std::cout << "test-sus finished normally." << std::endl;
+}
@@ -2,10 +2,17 @@
 
 #define FRYSTL_DEBUG
 #include "static_vector.hpp"
+#include <cstring>
 #include "SelfCount.hpp"
+#include "Relocatable.hpp"
 #include <iostream>
 #include <vector>
+#include <memory>
 #include <list>
+#include <string>
+#include <unordered_set>
+#include <algorithm> // stable_sort
+#include <stdexcept> // runtime_error
 
 using namespace frystl;
 
@@ -32,6 +39,92 @@ static void TestFillInsert(C vec, unsigned iat, unsigned n)
     }
 }
 
+// Make random inserts and erases in c, and the same changes to a
+// vector of ints, checking that they agree.  make(v) returns an
+// element holding v; value(e) returns the int held by e.
+template <class C, class Make, class Value>
+static void TestShifting(C &c, unsigned maxSize, Make make, Value value)
+{
+    std::vector<int> model;
+    uint32_t r = 1;
+    for (int i = 0; i < 3000; ++i) {
+        r = r * 1103515245 + 12345;
+        unsigned pos = (r >> 4) % (model.size() + 1);
+        int v = int(r >> 20);
+        switch ((r >> 16) % 4) {
+        case 0:
+            if (model.size() < maxSize) {
+                c.insert(c.begin() + pos, make(v));
+                model.insert(model.begin() + pos, v);
+            }
+            break;
+        case 1:
+            if (model.size() < maxSize) {
+                c.emplace(c.begin() + pos, make(v));
+                model.insert(model.begin() + pos, v);
+            }
+            break;
+        case 2:
+            if (pos < model.size()) {
+                c.erase(c.begin() + pos);
+                model.erase(model.begin() + pos);
+            }
+            break;
+        default: {
+            unsigned n = std::min<unsigned>((r >> 24) % 4, model.size() - pos);
+            c.erase(c.begin() + pos, c.begin() + pos + n);
+            model.erase(model.begin() + pos, model.begin() + pos + n);
+            break;
+        }
+        }
+        assert(c.size() == model.size());
+        for (unsigned j = 0; j < model.size(); ++j)
+            assert(value(c[j]) == model[j]);
+    }
+}
+// v holds 0 to 7.  Check that inserts whose copies throw, near the
+// front, in the middle, and running past the end, leave it as it was.
+template <class C>
+static void TestThrowingInsert(C &v)
+{
+    using T = std::decay_t<decltype(v.front())>;
+    const T src[] = {10, 11, -1, 12};
+    const int count = Relocatable::Count();
+    auto same = [&v, count]() {
+        for (int i = 0; i < 8; ++i)
+            if (v[i]() != i)
+                return false;
+        return v.size() == 8 && Relocatable::Count() == count;
+    };
+    for (unsigned at : {1u, 3u, 6u}) {
+        try {
+            v.insert(v.begin() + at, src, src + 4);
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+        try {
+            v.insert(v.begin() + at, 3, src[2]);
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+        try {
+            v.insert(v.begin() + at, {T(10), T(-1)});
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+        try {
+            v.emplace(v.begin() + at, src[2]);
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(same());
+    }
+    v.insert(v.begin() + 2, src, src + 2);
+    assert(v.size() == 10 && v[2]() == 10 && v[4]() == 2);
+}
 int main() {
 
     // Constructors.
@@ -535,5 +628,412 @@ int main() {
         assert(v0 < v1);
         assert(v0 != v1);
     }
+    {
+        // radix_sort()
+        struct Rec {
+            uint32_t key;
+            uint16_t index;
+        };
+        for (unsigned n : {0u, 1u, 7u, 32u, 33u, 200u, 300u}) {
+            static_vector<Rec, 300> v;
+            std::vector<Rec> sv;
+            uint32_t r = n;
+            for (unsigned i = 0; i < n; ++i) {
+                r = r * 1103515245 + 12345;
+                Rec rec {(r >> 8) & 0xff00ff, uint16_t(i)};
+                v.push_back(rec);
+                sv.push_back(rec);
+            }
+            std::stable_sort(sv.begin(), sv.end(),
+                [](const Rec& a, const Rec& b) {return a.key < b.key;});
+            radix_sort(v, [](const Rec& rec) {return rec.key;});
+            assert(v.size() == n);
+            for (unsigned i = 0; i < n; ++i) {
+                assert(v[i].key == sv[i].key);
+                assert(v[i].index == sv[i].index);
+            }
+            radix_sort(v, [](const Rec& rec) {return uint8_t(rec.index);});
+            for (unsigned i = 1; i < n; ++i)
+                assert(uint8_t(v[i-1].index) <= uint8_t(v[i].index));
+        }
+    }
+    {
+        // small_sort()
+        uint32_t r = 1;
+        for (int trial = 0; trial < 20; ++trial) {
+            for (unsigned n = 0; n <= 20; ++n) {
+                static_vector<int, 20> v;
+                static_vector<std::string, 20> s;
+                for (unsigned i = 0; i < n; ++i) {
+                    r = r * 1103515245 + 12345;
+                    v.push_back(int(r >> 16) % 10 - 5);
+                    s.push_back(std::to_string(r >> 20));
+                }
+                std::vector<int> sv(v.begin(), v.end());
+                std::sort(sv.begin(), sv.end());
+                small_sort(v);
+                assert(std::equal(v.begin(), v.end(), sv.begin(), sv.end()));
+                small_sort(v, std::greater<int>());
+                assert(std::equal(v.begin(), v.end(), sv.rbegin(), sv.rend()));
+                std::vector<std::string> ss(s.begin(), s.end());
+                std::sort(ss.begin(), ss.end());
+                small_sort(s);
+                assert(std::equal(s.begin(), s.end(), ss.begin(), ss.end()));
+            }
+        }
+        static_vector<double, 3> d {2.5, -1.0, 0.5};
+        small_sort(d);
+        assert(d[0] == -1.0 && d[1] == 0.5 && d[2] == 2.5);
+    }
+    {
+        // insert_sorted_batch()
+        assert(SelfCount::OwnerCount() == 0);
+        static_vector<SelfCount, 60> v;
+        for (int i = 0; i < 20; ++i)
+            v.emplace_back(2*i);
+        std::vector<SelfCount> batch;
+        for (int i : {-3, 0, 7, 9, 9, 38, 39, 41, 50})
+            batch.emplace_back(i);
+        auto less = [](const SelfCount& a, const SelfCount& b) {return int(a()) < int(b());};
+        v.insert_sorted_batch(batch.begin(), batch.end(), less);
+        assert(v.size() == 29);
+        assert(SelfCount::OwnerCount() == 29 + 9);
+        assert(std::is_sorted(v.begin(), v.end(), less));
+        assert(int(v[0]()) == -3);
+        assert(v[1]() == 0 && v[2]() == 0);
+        assert(v[28]() == 50);
+        assert(v[27]() == 41);
+        v.insert_sorted_batch(batch.end(), batch.end(), less);
+        assert(v.size() == 29);
+        static_vector<SelfCount, 60> e;
+        e.insert_sorted_batch(batch.begin(), batch.end(), less);
+        assert(e.size() == 9);
+        assert(e[4]() == 9);
+        assert(SelfCount::OwnerCount() == 29 + 18);
+    }{
+        // insert_many()
+        assert(SelfCount::OwnerCount() == 0);
+        static_vector<SelfCount, 60> v;
+        for (int i = 0; i < 10; ++i)
+            v.emplace_back(i);
+        std::list<unsigned> positions {0, 3, 3, 9, 10, 10};
+        std::list<SelfCount> values;
+        for (int i : {100, 103, 104, 109, 110, 111})
+            values.emplace_back(i);
+        v.insert_many(positions.begin(), positions.end(), values.begin());
+        assert(v.size() == 16);
+        assert(SelfCount::OwnerCount() == 16 + 6);
+        std::vector<int> expected {100, 0, 1, 2, 103, 104, 3, 4, 5, 6, 7, 8, 109, 9, 110, 111};
+        for (unsigned i = 0; i < 16; ++i)
+            assert(v[i]() == expected[i]);
+    }{
+        // Trivial copies
+        static_assert(std::is_trivially_copyable<static_vector<uint8_t, 52>>::value,
+            "static_vector of a trivially copyable type should be trivially copyable");
+        static_assert(!std::is_trivially_copyable<static_vector<SelfCount, 52>>::value,
+            "static_vector<SelfCount> should not be trivially copyable");
+        static_assert(std::is_trivially_destructible<static_vector<int, 8>>::value,
+            "static_vector<int> should be trivially destructible");
+        static_vector<uint8_t, 52> a {3, 1, 4, 1, 5};
+        static_vector<uint8_t, 52> b;
+        std::memcpy(&b, &a, sizeof(a));
+        assert(b.size() == 5 && b[2] == 4 && b == a);
+        static_vector<uint8_t, 52> c(std::move(a));
+        assert(c == b && a == b);
+    }{
+        // Copying a non-trivially copyable type copies size() elements
+        assert(SelfCount::OwnerCount() == 0);
+        static_vector<SelfCount, 60> a;
+        for (int i = 0; i < 7; ++i)
+            a.emplace_back(i);
+        const static_vector<SelfCount, 60>& ca = a;
+        static_vector<SelfCount, 60> b(ca);
+        assert(b.size() == 7 && b[6]() == 6);
+        assert(SelfCount::OwnerCount() == 14);
+        static_vector<SelfCount, 60> c;
+        c.emplace_back(42);
+        c = ca;
+        assert(c.size() == 7 && c[0]() == 0 && c[6]() == 6);
+        assert(SelfCount::OwnerCount() == 21);
+        c.resize(3);
+        c = ca;
+        assert(c.size() == 7 && SelfCount::OwnerCount() == 21);
+        b.resize(10, SelfCount(9));
+        c = b;
+        assert(c.size() == 10 && c[9]() == 9);
+        c = ca;
+        assert(c.size() == 7 && SelfCount::OwnerCount() == 7 + 10 + 7);
+        static_vector<SelfCount, 60> d(std::move(c));
+        assert(c.empty() && d.size() == 7);
+        c = std::move(b);
+        assert(b.empty() && c.size() == 10);
+        assert(SelfCount::OwnerCount() == 7 + 10 + 7);
+    }
+    {
+        // Compact size
+        static_assert(sizeof(static_vector<uint8_t, 24>) == 25,
+            "a small static_vector should use a one-byte size");
+        static_assert(sizeof(static_vector<uint16_t, 1000>) == 2002,
+            "a static_vector of 1000 elements should use a two-byte size");
+        static_vector<int, 255> v;
+        for (int i = 0; i < 255; ++i)
+            v.push_back(i);
+        assert(v.size() == 255 && v.back() == 254);
+        v.erase(v.begin(), v.begin() + 100);
+        assert(v.size() == 155 && v.front() == 100);
+        v.insert(v.begin(), 100u, -1);
+        assert(v.size() == 255 && v[99] == -1 && v[100] == 100);
+    }
+    {
+        // try_ and unchecked_ functions
+        static_vector<SelfCount, 3> v;
+        SelfCount* p = v.try_emplace_back(1);
+        assert(p == &v[0] && (*p)() == 1);
+        SelfCount two(2);
+        p = v.try_push_back(two);
+        assert(p == &v[1] && (*p)() == 2);
+        SelfCount& r = v.unchecked_push_back(SelfCount(3));
+        assert(&r == &v.back() && r() == 3);
+        assert(v.try_emplace_back(4) == nullptr);
+        SelfCount five(5);
+        assert(v.try_push_back(std::move(five)) == nullptr);
+        assert(five() == 5);
+        assert(v.size() == 3 && SelfCount::OwnerCount() == 5);
+        v.pop_back();
+        assert(v.unchecked_emplace_back(6)() == 6 && v.size() == 3);
+    }
+    {
+        // append_range(), resize_default_init(), generate_back()
+        unsigned count0 = SelfCount::Count();
+        static_vector<SelfCount, 50> v;
+        std::vector<int> iv {1, 2, 3};
+        v.append_range(iv);
+        std::list<int> li {4, 5};
+        v.append_range(li);
+        v.append_range(std::vector<SelfCount>(2));
+        assert(v.size() == 7 && v[4]() == 5 && v[6]() == 0);
+        int next = 10;
+        v.generate_back(5, [&next] { return SelfCount(next++); });
+        assert(v.size() == 12 && v[7]() == 10 && v[11]() == 14);
+        assert(SelfCount::OwnerCount() == 12);
+        v.resize(20);
+        assert(v.size() == 20 && v[19]() == 0 && SelfCount::OwnerCount() == 20);
+        v.resize_default_init(3);
+        assert(v.size() == 3 && SelfCount::Count() == count0 + 3);
+        // generate_back keeps what was made before an exception
+        try {
+            int k = 0;
+            v.generate_back(5, [&k] {
+                if (k == 2) throw std::runtime_error("generator");
+                return SelfCount(k++);
+            });
+            assert(false);
+        }
+        catch (std::runtime_error&) {}
+        assert(v.size() == 5 && v[4]() == 1 && SelfCount::Count() == count0 + 5);
+
+        static_vector<unsigned, 100> u;
+        u.resize_default_init(100);
+        assert(u.size() == 100);
+        for (unsigned i = 0; i < 100; ++i)
+            u[i] = i;
+        u.resize_default_init(10);
+        u.generate_back(90, [&u] { return u.size(); });
+        assert(u.size() == 100 && u[10] == 10 && u[99] == 10);
+        u.clear();
+        u.append_range(std::vector<unsigned>(100, 3));
+        assert(u.size() == 100 && u[50] == 3);
+    }
+    {
+        // erase_unordered(), erase_if() and erase_indices()
+        unsigned count0 = SelfCount::Count();
+        static_vector<SelfCount, 30> v;
+        for (int i = 0; i < 20; ++i)
+            v.emplace_back(i);
+        auto it = v.erase_unordered(v.begin() + 3);
+        assert(v.size() == 19 && (*it)() == 19 && v[3]() == 19);
+        it = v.erase_unordered(v.end() - 1);
+        assert(it == v.end() && v.size() == 18 && v.back()() == 17);
+        assert(SelfCount::OwnerCount() == 18);
+        auto nErased = erase_if(v, [](const SelfCount& s) { return s() % 3 == 0; });
+        assert(nErased == 5 && v.size() == 13);
+        const int remaining[] = {1, 2, 19, 4, 5, 7, 8, 10, 11, 13, 14, 16, 17};
+        for (unsigned i = 0; i < 13; ++i)
+            assert(v[i]() == remaining[i]);
+        assert(SelfCount::OwnerCount() == 13);
+        std::vector<unsigned> indices {0, 2, 2, 5, 12};
+        nErased = erase_indices(v, indices);
+        assert(nErased == 4 && v.size() == 9);
+        const int kept[] = {2, 4, 5, 8, 10, 11, 13, 14, 16};
+        for (unsigned i = 0; i < 9; ++i)
+            assert(v[i]() == kept[i]);
+        assert(erase_indices(v, std::vector<unsigned>()) == 0 && v.size() == 9);
+        assert(SelfCount::OwnerCount() == 9);
+        v.clear();
+        assert(SelfCount::Count() == count0);
+    }
+    {
+        // find(), count(), contains(), min_element(), max_element()
+        uint32_t seed = 12345;
+        auto random = [&seed] { 
+            seed = seed * 1664525u + 1013904223u; 
+            return seed >> 8; 
+        };
+        auto check = [&random](auto zero) {
+            using T = decltype(zero);
+            static_vector<T, 150> v;
+            for (unsigned n = 0; n <= 150; ++n) {
+                v.clear();
+                for (unsigned i = 0; i < n; ++i)
+                    v.push_back(i % 5 == 4 ? T(random()) : T(random() % 7 * 40 - 100));
+                const T* b = v.begin();
+                const T* e = v.end();
+                for (T x : {T(-100), T(20), T(140), T(3)}) {
+                    assert(find(v, x) == std::find(b, e, x));
+                    assert(size_t(count(v, x)) == size_t(std::count(b, e, x)));
+                    assert(contains(v, x) == (std::find(b, e, x) != e));
+                }
+                assert(min_element(v) == std::min_element(b, e));
+                assert(max_element(v) == std::max_element(b, e));
+            }
+        };
+        check(uint8_t());
+        check(int8_t());
+        check(char());
+        check(uint16_t());
+        check(int16_t());
+        check(uint32_t());
+        check(int32_t());
+        check(uint64_t());
+
+        static_vector<int16_t, 40> scores(40, 5);
+        scores[39] = -7;
+        *max_element(scores) = 9;
+        assert(scores[0] == 9 && *min_element(scores) == -7);
+        assert(find(scores, 5) == scores.begin() + 1 && count(scores, 5) == 38);
+        static_vector<std::string, 5> names {"a", "b", "a"};
+        assert(count(names, "a") == 2 && find(names, "b") == names.begin() + 1);
+        assert(!contains(names, "c") && *max_element(names) == "b");
+    }
+    {
+        // std::hash
+        using Cards = static_vector<uint8_t, 60>;
+        std::hash<Cards> hasher;
+        Cards a {1, 2, 3}, b {1, 2, 3}, c {1, 2, 4}, d {1, 2};
+        assert(hasher(a) == hasher(b) && hasher(a) != hasher(c) && hasher(a) != hasher(d));
+        assert(hasher(Cards()) != hasher(Cards {0}));
+        std::unordered_set<Cards> cards;
+        std::unordered_set<size_t> hashes;
+        for (unsigned n = 0; n <= 60; ++n) {
+            for (unsigned k = 0; k < 20; ++k) {
+                a.clear();
+                for (unsigned j = 0; j < n; ++j)
+                    a.push_back(uint8_t(j * k));
+                cards.insert(a);
+                hashes.insert(hasher(a));
+            }
+        }
+        assert(hashes.size() == cards.size());
+        std::hash<static_vector<std::string, 4>> shasher;
+        static_vector<std::string, 4> s1 {"ab", "c"}, s2 {"a", "bc"};
+        assert(shasher(s1) != shasher(s2) && shasher(s1) == shasher({"ab", "c"}));
+    }
+    {
+        // Comparisons agree with std::vector's, with and without memcmp().
+        auto check = [](auto zero) {
+            using T = decltype(zero);
+            auto value = [](int x) {
+                if constexpr (std::is_same<T, std::string>::value)
+                    return std::to_string(x);
+                else
+                    return T(x);
+            };
+            for (unsigned n = 0; n < 100; n += 33) {
+                for (unsigned k = 0; k <= n; k += 7) {
+                    static_vector<T, 101> a(n, value(5)), b(a);
+                    // b differs from a at k, or is longer
+                    if (k < n)
+                        b[k] = value(k % 2 ? 6 : -4);
+                    else
+                        b.push_back(value(0));
+                    std::vector<T> va(a.begin(), a.end()), vb(b.begin(), b.end());
+                    assert((a == b) == (va == vb) && (a != b) == (va != vb));
+                    assert((a < b) == (va < vb) && (b < a) == (vb < va));
+                    assert((a <= b) == (va <= vb) && (a >= b) == (va >= vb));
+                    assert((a > b) == (va > vb) && a == a && !(a < a));
+#ifdef FRYSTL_HAS_THREE_WAY
+                    assert((a <=> b) == (va <=> vb) && (b <=> a) == (vb <=> va));
+                    assert((a <=> a) == 0);
+#endif
+                }
+            }
+        };
+        check(uint8_t());
+        check(char());
+        check(int16_t());
+        check(uint32_t());
+        check(int64_t());
+        check(std::string());
+        check(double());
+    }
+#ifdef FRYSTL_HAS_CONSTEXPR20
+    {
+        // Constant evaluation
+        constexpr auto squares = [] {
+            static_vector<int, 20> v;
+            for (int i = 0; i < 10; ++i)
+                v.push_back(i * i);
+            v.erase(v.begin() + 2);
+            v.insert(v.begin(), -1);
+            v.emplace(v.begin() + 1, -2);
+            while (v.try_push_back(7)) {}
+            return v;
+        }();
+        static_assert(squares.size() == 20, "constexpr try_push_back()");
+        static_assert(squares[0] == -1 && squares[1] == -2 && squares[4] == 9,
+            "constexpr insert()");
+        static_assert(squares[10] == 81 && squares[11] == 7, "constexpr push_back()");
+        constexpr static_vector<int, 4> small {1, 2, 3};
+        static_assert(small < squares == false && small.back() == 3,
+            "constexpr comparison");
+        assert(squares[3] == 1);
+    }
+#endif
+    {
+        // Shifting trivially relocatable elements with memmove() and
+        // others one at a time
+        static_assert(is_trivially_relocatable<std::unique_ptr<int>>::value, "unique_ptr");
+        static_assert(!is_trivially_relocatable<SelfCount>::value, "SelfCount");
+        static_vector<std::unique_ptr<int>, 50> u;
+        TestShifting(u, 50,
+            [](int v) { return std::make_unique<int>(v); },
+            [](const std::unique_ptr<int> &p) { return *p; });
+        {
+            static_vector<SelfCount, 50> s;
+            TestShifting(s, 50,
+                [](int v) { return SelfCount(v); },
+                [](const SelfCount &e) { return int(e()); });
+            assert(SelfCount::Count() == int(s.size()));
+            assert(SelfCount::OwnerCount() == int(s.size()));
+        }
+        assert(SelfCount::Count() == 0);
+    }
+    {
+        // An insert whose copy throws leaves the vector as it was.
+        {
+            static_vector<Unrelocatable, 20> v;
+            for (int i = 0; i < 8; ++i)
+                v.emplace_back(i);
+            TestThrowingInsert(v);
+        }
+        {
+            static_vector<Relocatable, 20> v;
+            for (int i = 0; i < 8; ++i)
+                v.emplace_back(i);
+            TestThrowingInsert(v);
+        }
+        assert(Relocatable::Count() == 0);
+    }
+    assert(SelfCount::OwnerCount() == 0);
     std::cout << "test-sv finished normally." << std::endl;
 }
\ No newline at end of file